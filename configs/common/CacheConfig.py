@@ -46,6 +46,7 @@ from __future__ import print_function
 import m5
 from m5.objects import *
 from Caches import *
+import CmgConfig
 from m5.util import *
 
 def config_cache(options, system):
@@ -154,8 +155,13 @@ def config_cache(options, system):
 
             # When connecting the caches, the clock is also inherited
             # from the CPU in question
-            system.cpu[i].addPrivateSplitL1Caches(icache, dcache,
-                                                  iwalkcache, dwalkcache)
+            if options.cmg_parallel:
+                CmgConfig.addBridgedL1Caches(options, system.cpu[i], i,
+                                             icache, dcache,
+                                             iwalkcache, dwalkcache)
+            else:
+                system.cpu[i].addPrivateSplitL1Caches(icache, dcache,
+                                                      iwalkcache, dwalkcache)
 
             if options.memchecker:
                 # The mem_side ports of the caches haven't been connected yet.
@@ -0,0 +1,185 @@
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Configuration helpers for simulating the core memory groups (CMGs) of
+# a many-core system in parallel. The cores of each CMG run on their own
+# event queue, and thus host thread, while the caches, crossbars and
+# memory stay on event queue 0. Each core reaches its L1 caches through
+# CrossQueueBridges, which deliver packets deterministically as long as
+# their latency exceeds the simulation quantum.
+
+from __future__ import print_function
+
+import os
+import pickle
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import fatal
+from m5.util.convert import toLatency
+
+# Process id of the twin simulation and the pipe to it, see
+# forkDeterminismTwin().
+_twin = None
+
+def quantumTicks(options):
+    return int(round(toLatency(options.sim_quantum) * m5.ticks.tps))
+
+def bridgeLatency(options):
+    if options.cmg_bridge_latency:
+        return options.cmg_bridge_latency
+    return "%dt" % (2 * quantumTicks(options))
+
+def checkOptions(options, cpu_class):
+    if not options.caches:
+        fatal("--cmg-parallel requires --caches")
+    if options.ruby or options.external_memory_system:
+        fatal("--cmg-parallel only supports the classic memory system")
+    if options.memchecker:
+        fatal("--cmg-parallel cannot be combined with --memchecker")
+    if options.fast_forward or options.checkpoint_restore != None or \
+       options.take_checkpoints or options.simpoint_profile:
+        fatal("--cmg-parallel does not support fast-forwarding or "
+              "checkpoints")
+    try:
+        is_o3 = issubclass(cpu_class, DerivO3CPU)
+    except NameError:
+        is_o3 = False
+    if not is_o3:
+        fatal("--cmg-parallel requires an out-of-order CPU model")
+    if options.cores_per_cmg < 1:
+        fatal("--cores-per-cmg must be at least 1")
+    if quantumTicks(options) == 0:
+        fatal("--sim-quantum must be non-zero")
+
+def addBridgedL1Caches(options, cpu, cpu_id, ic, dc, iwc = None, dwc = None):
+    """Counterpart of BaseCPU.addPrivateSplitL1Caches() that moves the
+    CPU to the event queue of its CMG and connects it to its L1 and
+    walker caches through CrossQueueBridges. The caches stay on event
+    queue 0 with the rest of the memory system."""
+
+    cpu.eventq_index = cpu_id // options.cores_per_cmg + 1
+    latency = bridgeLatency(options)
+
+    def bridge(name):
+        b = CrossQueueBridge(delay = latency, eventq_index = 0)
+        setattr(cpu, name, b)
+        return b
+
+    cpu.icache = ic
+    cpu.dcache = dc
+    ic.eventq_index = 0
+    dc.eventq_index = 0
+    cpu.icache_port = bridge('icache_bridge').slave
+    cpu.dcache_port = bridge('dcache_bridge').slave
+    cpu.icache_bridge.master = ic.cpu_side
+    cpu.dcache_bridge.master = dc.cpu_side
+    cpu._cached_ports = ['icache.mem_side', 'dcache.mem_side']
+
+    cpu.itb.walker.port = bridge('itb_walker_bridge').slave
+    cpu.dtb.walker.port = bridge('dtb_walker_bridge').slave
+    if iwc and dwc:
+        cpu.itb_walker_cache = iwc
+        cpu.dtb_walker_cache = dwc
+        iwc.eventq_index = 0
+        dwc.eventq_index = 0
+        cpu.itb_walker_bridge.master = iwc.cpu_side
+        cpu.dtb_walker_bridge.master = dwc.cpu_side
+        cpu._cached_ports += ['itb_walker_cache.mem_side',
+                              'dtb_walker_cache.mem_side']
+    else:
+        cpu._cached_ports += ['itb_walker_bridge.master',
+                              'dtb_walker_bridge.master']
+
+def configRoot(options, root):
+    root.sim_quantum = quantumTicks(options)
+    if options.cmg_determinism_check:
+        forkDeterminismTwin()
+
+def forkDeterminismTwin():
+    """Fork a twin simulator running the same configuration. Must be
+    called before m5.instantiate(). The twin writes its output to a
+    separate directory and does not dump statistics; at the end of the
+    simulation checkDeterminism() compares the bridge digests of both
+    runs."""
+
+    global _twin
+
+    sys.stdout.flush()
+    sys.stderr.flush()
+    rfd, wfd = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        os.close(rfd)
+        m5.options.outdir = m5.options.outdir + ".cmgcheck"
+        m5.core.setOutputDir(m5.options.outdir)
+        del m5.stats.outputList[:]
+        _twin = (0, wfd)
+    else:
+        os.close(wfd)
+        _twin = (pid, rfd)
+
+def _digests(root):
+    return [ (obj.path(), obj.getCCObject().digest())
+             for obj in root.descendants()
+             if isinstance(obj, CrossQueueBridge) ]
+
+def checkDeterminism(root):
+    """Compare the end of this simulation with the twin forked by
+    forkDeterminismTwin(). Does nothing if no twin was forked."""
+
+    if _twin is None:
+        return
+
+    pid, fd = _twin
+    mine = (m5.curTick(), _digests(root))
+
+    if pid == 0:
+        with os.fdopen(fd, 'wb') as f:
+            pickle.dump(mine, f)
+        sys.stdout.flush()
+        os._exit(0)
+
+    with os.fdopen(fd, 'rb') as f:
+        try:
+            twin = pickle.load(f)
+        except EOFError:
+            twin = None
+    os.waitpid(pid, 0)
+
+    if twin is None:
+        fatal("CMG determinism check failed: the twin simulation did "
+              "not finish")
+    if twin[0] != mine[0]:
+        fatal("CMG determinism check failed: simulations ended at tick "
+              "%d and %d" % (mine[0], twin[0]))
+    for (path, digest), (_, twin_digest) in zip(mine[1], twin[1]):
+        if digest != twin_digest:
+            fatal("CMG determinism check failed: traffic through %s "
+                  "diverged" % path)
+    print("CMG determinism check passed: %d bridges identical at tick %d"
+          % (len(mine[1]), mine[0]))
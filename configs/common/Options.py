@@ -137,6 +137,23 @@ def addNoISAOptions(parser):
 
     parser.add_option("--show-flops", action="store_true", help="Display Flops and Bytes at every dumpstat (o3 only)")
     parser.add_option("--show-flops-detailed", action="store_true", help="Display Flops and Bytes at every dumpstat - detailed version (o3 only)")
+    parser.add_option("--roofline-profile", action="store_true", help="Write per-function and per-PC roofline tables to m5out/roofline.<cpu>.txt at every dumpstat (o3 only)")
+    parser.add_option("--pipe-trace", action="store_true",
+                      help="Write a binary pipeline trace to "
+                      "m5out/pipetrace.<cpu>.bin (o3 only), see "
+                      "util/convert_pipe_trace.py")
+    parser.add_option("--pipe-trace-start", type="int", default=0,
+                      metavar="TICK", help="Trace instructions fetched "
+                      "from TICK on")
+    parser.add_option("--pipe-trace-end", type="int", default=None,
+                      metavar="TICK", help="Trace instructions fetched "
+                      "before TICK")
+    parser.add_option("--pipe-trace-start-inst", type="int", default=0,
+                      metavar="N", help="Trace instructions fetched once N "
+                      "instructions have committed")
+    parser.add_option("--pipe-trace-end-inst", type="int", default=0,
+                      metavar="N", help="Trace instructions fetched before "
+                      "N instructions have committed")
 
 # Add common options that assume a non-NULL ISA.
 def addCommonOptions(parser):
@@ -258,6 +275,18 @@ def addCommonOptions(parser):
         help="restore from checkpoint <N>")
     parser.add_option("--checkpoint-at-end", action="store_true",
                       help="take a checkpoint at end of run")
+    parser.add_option("--sparse-checkpoint", action="store_true",
+                      help="save only touched memory in checkpoints, as "
+                      "increments on the previous checkpoint of the run")
+    parser.add_option("--sparse-checkpoint-raw", action="store_true",
+                      help="do not compress sparse memory images, so that "
+                      "restoring them maps the pages in lazily")
+    parser.add_option("--sparse-checkpoint-max-chain", type="int",
+                      default=8, help="number of checkpoints in a chain of "
+                      "increments before a full one is taken")
+    parser.add_option("--checkpoint-threads", type="int", default=0,
+                      help="host threads used for sparse memory images "
+                      "(0: all host cores)")
     parser.add_option("--work-begin-checkpoint-count", action="store", type="int",
                       help="checkpoint at specified work begin count")
     parser.add_option("--work-end-checkpoint-count", action="store", type="int",
@@ -289,7 +318,31 @@ def addCommonOptions(parser):
         help="base names for --take-checkpoint and --checkpoint-restore")
     parser.add_option("-F", "--fast-forward", action="store", type="string",
         default=None,
-        help="Number of instructions to fast forward before switching")
+        help="Number of instructions to fast forward before switching, "
+        "or 'roi' to switch at the first region of interest marker")
+    parser.add_option("--ff-engine", action="store_true", default=False,
+        help="Fast forward with the functional engine of the atomic CPU, "
+        "which bypasses the caches (SE mode only)")
+    parser.add_option("--ff-batch", type="int", default=10000,
+        help="Instructions per tick when using --ff-engine")
+    parser.add_option("--smarts", type="int", default=None, metavar="N",
+        help="Sample one detailed unit every N instructions and warm the "
+        "caches, TLBs and predictors functionally in between")
+    parser.add_option("--smarts-unit", type="int", default=1000,
+        help="Instructions measured per --smarts sample")
+    parser.add_option("--smarts-warmup", type="int", default=2000,
+        help="Detailed instructions simulated before each --smarts sample")
+    parser.add_option("--smarts-confidence", type="choice", default="95",
+        choices=["90", "95", "99"],
+        help="Confidence level (%) of the reported --smarts CPI interval")
+    parser.add_option("--smarts-error", type="float", default=0.03,
+        help="Target relative CPI error used to suggest a sample count")
+    parser.add_option("--sweep", action="store", type="string",
+        default=None, metavar="FILE",
+        help="Fork one detailed simulation per point of the JSON sweep "
+        "FILE after fast-forwarding (see README_RIKEN_SIM.md)")
+    parser.add_option("--sweep-jobs", type="int", default=1,
+        help="Number of sweep points simulated at the same time")
     parser.add_option("-S", "--simpoint", action="store_true", default=False,
         help="""Use workload simpoints as an instruction offset for
                 --checkpoint-restore or --take-checkpoint.""")
@@ -306,8 +359,57 @@ def addCommonOptions(parser):
     parser.add_option("--arm-sve-vl", default="4", type="choice",
                       choices=["1", "2", "4", "8", "16"],
                       help="SVE vector length in quadwords (128-bit)")
+    parser.add_option("--arm-sve-gather-fusion", action="store_true",
+                      default=False,
+                      help="Issue each SVE gather/scatter as a single "
+                      "memory micro-op")
+    parser.add_option("--arm-sve-gather-fusion-max-span", type="string",
+                      default="2kB",
+                      help="Largest address range a fused gather/scatter "
+                      "may cover")
+    parser.add_option("--arm-host-fp-fast-path", action="store_true",
+                      default=False,
+                      help="Compute simple FP operations on the host FPU "
+                      "when the result is bit-exact")
+    parser.add_option("--arm-decode-front-cache", type="int", default=4096,
+                      help="Entries in the PC-indexed decode front cache "
+                      "(power of two, 0 to disable)")
+    parser.add_option("--cmg-parallel", action="store_true", default=False,
+                      help="Simulate each core memory group (CMG) on its "
+                      "own event queue and host thread")
+    parser.add_option("--cores-per-cmg", type="int", default=12,
+                      help="Number of cores in a CMG")
+    parser.add_option("--sim-quantum", type="string", default="500ps",
+                      help="Synchronisation quantum of the CMG event queues")
+    parser.add_option("--cmg-bridge-latency", type="string", default=None,
+                      help="Latency between a core and its L1 caches with "
+                      "--cmg-parallel, must exceed --sim-quantum "
+                      "(default: twice --sim-quantum)")
+    parser.add_option("--cmg-determinism-check", action="store_true",
+                      default=False,
+                      help="Run a twin of a --cmg-parallel simulation and "
+                      "check that both produce identical memory traffic")
+    parser.add_option("--eventq-wheel", type="int", default=0,
+                      help="Keep events in a timing wheel of this many "
+                      "slots (power of two >= 64, 0 for a sorted list)")
+    parser.add_option("--eventq-wheel-resolution", type="int", default=512,
+                      help="Ticks per slot of the event queue timing wheel "
+                      "(power of two)")
     parser.add_option("--stat-events", action="store",
                       type="string", help="list of stat event tick");
+    parser.add_option("--roi-policy", default="none", type="choice",
+                      choices=["none", "nth", "pairs", "per_thread"],
+                      help="Dump and reset stats at clock_gettime() region "
+                      "of interest markers: at the --roi-begin/--roi-end "
+                      "calls (nth), at every call (pairs), or at the "
+                      "--roi-begin/--roi-end calls of thread context "
+                      "--roi-context (per_thread)")
+    parser.add_option("--roi-begin", type="int", default=1,
+                      help="clock_gettime() call that opens the ROI")
+    parser.add_option("--roi-end", type="int", default=2,
+                      help="clock_gettime() call that closes the ROI")
+    parser.add_option("--roi-context", type="int", default=0,
+                      help="Thread context counted by --roi-policy=per_thread")
 
 def addSEOptions(parser):
     # Benchmark options
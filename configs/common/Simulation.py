@@ -41,12 +41,15 @@
 
 from __future__ import print_function
 
+import math
 import sys
 from os import getcwd
 from os.path import join as joinpath
 
+from common import CmgConfig
 from common import CpuConfig
 from common import MemConfig
+from common import Sweep
 
 import m5
 from m5.defines import buildEnv
@@ -80,7 +83,7 @@ def setCPUClass(options):
         if options.restore_with_cpu != options.cpu_type:
             CPUClass = TmpClass
             TmpClass, test_mem_mode = getCPUClass(options.restore_with_cpu)
-    elif options.fast_forward:
+    elif options.fast_forward or options.smarts:
         CPUClass = TmpClass
         TmpClass = AtomicSimpleCPU
         test_mem_mode = 'atomic'
@@ -92,6 +95,32 @@ def setCPUClass(options):
 
     return (TmpClass, test_mem_mode, CPUClass)
 
+def setFastForward(options, testsys, cpu):
+    """Makes a CPU stop at the point given by --fast-forward, and
+       optionally use the functional fast-forward engine."""
+
+    if options.fast_forward == "roi":
+        testsys.exit_on_roi = True
+    else:
+        cpu.max_insts_any_thread = int(options.fast_forward)
+
+    if options.ff_engine:
+        if not isinstance(cpu, AtomicSimpleCPU):
+            fatal("--ff-engine requires fast-forwarding with the atomic CPU")
+        cpu.fast_forward = True
+        cpu.fast_forward_batch = options.ff_batch
+
+def setPipeTrace(options, cpu):
+    """Enables the binary pipeline trace on a CPU, limited to the
+       window given on the command line."""
+
+    cpu.pipe_trace = True
+    cpu.pipe_trace_start = options.pipe_trace_start
+    if options.pipe_trace_end is not None:
+        cpu.pipe_trace_end = options.pipe_trace_end
+    cpu.pipe_trace_start_inst = options.pipe_trace_start_inst
+    cpu.pipe_trace_end_inst = options.pipe_trace_end_inst
+
 def setMemClass(options):
     """Returns a memory controller class."""
 
@@ -435,6 +464,102 @@ def repeatSwitch(testsys, repeat_switch_cpu_list, maxtick, switch_freq):
             exit_event = m5.simulate(maxtick - m5.curTick())
             return exit_event
 
+# Standard normal quantiles of the supported --smarts-confidence levels
+_smarts_z = { "90" : 1.645, "95" : 1.960, "99" : 2.576 }
+
+def smartsSample(options, testsys, switch_cpu_list, maxtick):
+    """SMARTS-style sampling. The atomic CPU warms the caches, TLBs,
+    branch predictor and prefetcher functionally for most of every
+    period of --smarts instructions. The detailed CPU then runs
+    --smarts-warmup instructions to fill its pipeline, and the CPI of
+    the next --smarts-unit instructions is one sample. The sampled CPI
+    and its confidence interval are written to smarts.txt."""
+
+    period = options.smarts
+    unit = options.smarts_unit
+    warmup = options.smarts_warmup
+    warming = period - warmup - unit
+    if unit <= 0 or warmup < 0 or warming <= 0:
+        fatal("--smarts period must exceed --smarts-warmup plus "
+              "--smarts-unit")
+
+    cycle = m5.ticks.fromSeconds(convert.anyToLatency(options.cpu_clock))
+    atomic_cpu, detailed_cpu = switch_cpu_list[0]
+    reverse_cpu_list = [ (new, old) for old, new in switch_cpu_list ]
+    samples = []
+
+    def simulate(cpu, insts, cause):
+        cpu.scheduleInstStop(0, insts, cause)
+        exit_event = m5.simulate(maxtick - m5.curTick())
+        return exit_event, exit_event.getCause() == cause
+
+    print("starting SMARTS sampling, %d of every %d instructions" %
+          (unit, period))
+    while True:
+        exit_event, done = simulate(atomic_cpu, warming, "smarts warming")
+        if not done:
+            break
+        m5.switchCpus(testsys, switch_cpu_list)
+
+        exit_event, done = simulate(detailed_cpu, warmup, "smarts warmup")
+        if done:
+            start = m5.curTick()
+            exit_event, done = simulate(detailed_cpu, unit, "smarts unit")
+            if done:
+                samples.append(float(m5.curTick() - start) / cycle / unit)
+        if not done:
+            break
+        m5.switchCpus(testsys, reverse_cpu_list)
+
+    writeSmartsReport(options, samples)
+    return exit_event
+
+def writeSmartsReport(options, samples):
+    n = len(samples)
+    z = _smarts_z[options.smarts_confidence]
+    mean = sum(samples) / n if n else float('nan')
+    if n > 1:
+        stdev = math.sqrt(sum((s - mean) ** 2 for s in samples) / (n - 1))
+    else:
+        stdev = float('nan')
+    cv = stdev / mean if n else float('nan')
+    error = z * cv / math.sqrt(n) if n else float('nan')
+    if n > 1 and error == error:
+        needed = int(math.ceil((z * cv / options.smarts_error) ** 2))
+    else:
+        needed = 0
+
+    report = [
+        ("samples", n, "Number of measured sampling units"),
+        ("unit_insts", options.smarts_unit, "Instructions per unit"),
+        ("period_insts", options.smarts, "Instructions per sampling period"),
+        ("cpi", mean, "Sampled CPI"),
+        ("cpi_stdev", stdev, "Standard deviation of the unit CPIs"),
+        ("cpi_cv", cv, "Coefficient of variation of the unit CPIs"),
+        ("confidence", options.smarts_confidence, "Confidence level (%)"),
+        ("cpi_error", error, "Relative half-width of the CPI confidence "
+         "interval"),
+        ("cpi_low", mean * (1 - error), "Lower CPI confidence bound"),
+        ("cpi_high", mean * (1 + error), "Upper CPI confidence bound"),
+        ("samples_needed", needed, "Samples needed for a relative error "
+         "of %g" % options.smarts_error),
+        ]
+
+    with open(joinpath(m5.options.outdir, "smarts.txt"), "w") as f:
+        for name, value, desc in report:
+            if isinstance(value, float):
+                value = "%.6f" % value
+            print("%-20s %14s # %s" % (name, value, desc), file=f)
+        print("", file=f)
+        for i, cpi in enumerate(samples):
+            print("unit.%-15d %14.6f" % (i, cpi), file=f)
+
+    print("SMARTS: CPI %.4f +- %.2f%% (%s%% confidence, %d samples)" %
+          (mean, 100 * error, options.smarts_confidence, n))
+    if needed > n:
+        warn("SMARTS: %d samples are needed for a CPI error of %g%%, "
+             "reduce --smarts" % (needed, 100 * options.smarts_error))
+
 def run(options, root, testsys, cpu_class):
     m5.disableAllListeners();
 
@@ -448,9 +573,28 @@ def run(options, root, testsys, cpu_class):
     if options.fast_forward and options.checkpoint_restore != None:
         fatal("Can't specify both --fast-forward and --checkpoint-restore")
 
+    if options.sweep and not (cpu_class and options.fast_forward):
+        fatal("--sweep requires --fast-forward and a detailed --cpu-type")
+    if options.sweep:
+        Sweep.checkForkable(options)
+
     if options.standard_switch and not options.caches:
         fatal("Must specify --caches when using --standard-switch")
 
+    if options.smarts:
+        if not cpu_class or not options.caches:
+            fatal("--smarts requires --caches and a detailed --cpu-type")
+        if options.num_cpus > 1:
+            fatal("--smarts only supports a single CPU")
+        if options.ff_engine or options.standard_switch or \
+           options.repeat_switch or options.checkpoint_restore != None:
+            fatal("--smarts can't be combined with --ff-engine, "
+                  "--standard-switch, --repeat-switch or "
+                  "--checkpoint-restore")
+        for obj in root.descendants():
+            if isinstance(obj, BaseCache):
+                obj.warm_prefetcher = True
+
     if options.standard_switch and options.repeat_switch:
         fatal("Can't specify both --standard-switch and --repeat-switch")
 
@@ -475,6 +619,14 @@ def run(options, root, testsys, cpu_class):
         for i in xrange(np):
             testsys.cpu[i].show_flops = options.show_flops
 
+    if options.roofline_profile:
+        for i in xrange(np):
+            testsys.cpu[i].roofline_profile = True
+
+    if options.pipe_trace:
+        for i in xrange(np):
+            setPipeTrace(options, testsys.cpu[i])
+
 
 
     if cpu_class:
@@ -483,13 +635,20 @@ def run(options, root, testsys, cpu_class):
 
         for i in xrange(np):
             if options.fast_forward:
-                testsys.cpu[i].max_insts_any_thread = int(options.fast_forward)
+                setFastForward(options, testsys, testsys.cpu[i])
             switch_cpus[i].system = testsys
             switch_cpus[i].workload = testsys.cpu[i].workload
             switch_cpus[i].clk_domain = testsys.cpu[i].clk_domain
             switch_cpus[i].progress_interval = \
                 testsys.cpu[i].progress_interval
             switch_cpus[i].isa = testsys.cpu[i].isa
+            if options.pipe_trace:
+                setPipeTrace(options, switch_cpus[i])
+            # functional warming trains the detailed CPU's predictor
+            if options.smarts:
+                bp = switch_cpus[i].branchPred
+                switch_cpus[i].branchPred = bp
+                testsys.cpu[i].branchPred = bp
             # simulation period
             if options.maxinsts:
                 switch_cpus[i].max_insts_any_thread = options.maxinsts
@@ -560,7 +719,7 @@ def run(options, root, testsys, cpu_class):
                 testsys.cpu[i].max_insts_any_thread = 1
             # Fast forward to specified location if we are not restoring
             elif options.fast_forward:
-                testsys.cpu[i].max_insts_any_thread = int(options.fast_forward)
+                setFastForward(options, testsys, testsys.cpu[i])
             # Fast forward to a simpoint (warning: time consuming)
             elif options.simpoint:
                 if testsys.cpu[i].workload[0].simpoint == 0:
@@ -612,6 +771,10 @@ def run(options, root, testsys, cpu_class):
     if options.take_simpoint_checkpoints != None:
         simpoints, interval_length = parseSimpointAnalysisFile(options, testsys)
 
+    if options.eventq_wheel:
+        root.event_queue_wheel_slots = options.eventq_wheel
+        root.event_queue_wheel_resolution = options.eventq_wheel_resolution
+
     checkpoint_dir = None
     if options.checkpoint_restore:
         cpt_starttick, checkpoint_dir = findCptDir(options, cptdir, testsys)
@@ -659,11 +822,22 @@ def run(options, root, testsys, cpu_class):
         fatal("Bad maxtick (%d) specified: " \
               "Checkpoint starts starts from tick: %d", maxtick, cpt_starttick)
 
-    if options.standard_switch or cpu_class:
+    if options.smarts:
+        # Sampling starts after the optional fast-forward, which warms
+        # the caches like the functional warming between samples
+        if options.fast_forward:
+            exit_event = m5.simulate()
+            print("Start sampling @ tick %s" % (m5.curTick()))
+        if options.sweep:
+            Sweep.forkSweep(options, root)
+    elif options.standard_switch or cpu_class:
         if options.standard_switch:
             print("Switch at instruction count:%s" %
                     str(testsys.cpu[0].max_insts_any_thread))
             exit_event = m5.simulate()
+        elif cpu_class and options.fast_forward == "roi":
+            print("Switch at first region of interest marker")
+            exit_event = m5.simulate()
         elif cpu_class and options.fast_forward:
             print("Switch at instruction count:%s" %
                     str(testsys.cpu[0].max_insts_any_thread))
@@ -673,6 +847,9 @@ def run(options, root, testsys, cpu_class):
             exit_event = m5.simulate(10000)
         print("Switched CPUS @ tick %s" % (m5.curTick()))
 
+        if options.sweep:
+            Sweep.forkSweep(options, root)
+
         m5.switchCpus(testsys, switch_cpu_list)
 
         if options.standard_switch:
@@ -725,7 +902,10 @@ def run(options, root, testsys, cpu_class):
 
         # If checkpoints are being taken, then the checkpoint instruction
         # will occur in the benchmark code it self.
-        if options.repeat_switch and maxtick > options.repeat_switch:
+        if options.smarts:
+            exit_event = smartsSample(options, testsys, switch_cpu_list,
+                                      maxtick)
+        elif options.repeat_switch and maxtick > options.repeat_switch:
             exit_event = repeatSwitch(testsys, repeat_switch_cpu_list,
                                       maxtick, options.repeat_switch)
         else:
@@ -736,5 +916,7 @@ def run(options, root, testsys, cpu_class):
     if options.checkpoint_at_end:
         m5.checkpoint(joinpath(cptdir, "cpt.%d"))
 
+    CmgConfig.checkDeterminism(root)
+
     if not m5.options.interactive:
         sys.exit(exit_event.getCode())
@@ -0,0 +1,194 @@
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Design-space sweeps from a warmed simulator state. The parent
+# simulator fast-forwards once and then forks one copy-on-write child
+# per sweep point. Each child changes the drain-safe parameters named by
+# its point and continues in detailed mode, writing its output to
+# <outdir>/sweep.<name>. Structural parameters (cache sizes, table
+# sizes, ...) are fixed when the simulator is instantiated and can not
+# be swept this way.
+#
+# A sweep file is a JSON list of points:
+#
+#   [ { "name": "vl4-l2lat40",
+#       "overrides": { "arm_sve_vl": 4,
+#                      "system.l2.tag_latency": 40,
+#                      "system.cpu[0].dcache.prefetcher.l1degree": 4 } },
+#     ... ]
+
+from __future__ import print_function
+
+import json
+import os
+import re
+import sys
+
+import m5
+from m5.defines import buildEnv
+from m5.objects import *
+from m5.util import fatal
+
+# Overrides accepted per object type, in the order of the C++ setter
+_cache_params = ('tag_latency', 'data_latency', 'response_latency')
+_prefetcher_params = ('l1degree', 'l1maxprfofs', 'l2degree', 'l2maxprfofs')
+
+_name_re = re.compile(r'^[\w.+-]+$')
+_part_re = re.compile(r'^(\w+)(?:\[(\d+)\])?$')
+
+def readSweep(filename):
+    """Read and check a sweep file, returning its list of points."""
+
+    with open(filename) as f:
+        points = json.load(f)
+
+    if not isinstance(points, list) or not points:
+        fatal("Sweep file %s must contain a non-empty list of points" %
+              filename)
+
+    names = set()
+    for point in points:
+        if not isinstance(point, dict) or \
+           not isinstance(point.get('overrides'), dict):
+            fatal("Sweep point %s has no overrides" % point)
+        name = str(point.get('name', ''))
+        if not _name_re.match(name) or name in names:
+            fatal("Sweep point name '%s' is missing, invalid or duplicated" %
+                  name)
+        names.add(name)
+
+    return points
+
+def _resolve(root, path):
+    obj = root
+    for part in path.split('.'):
+        m = _part_re.match(part)
+        if not m:
+            fatal("Invalid object path '%s' in sweep" % path)
+        try:
+            obj = getattr(obj, m.group(1))
+            if m.group(2) is not None:
+                obj = obj[int(m.group(2))]
+        except (AttributeError, IndexError):
+            fatal("No object '%s' to apply sweep overrides to" % path)
+    return obj
+
+def _setArmSveVectorLength(root, vl):
+    if buildEnv['TARGET_ISA'] != 'arm':
+        fatal("arm_sve_vl can only be swept on Arm")
+    for obj in root.descendants():
+        if isinstance(obj, ArmISA):
+            obj.setSveVectorLength(int(vl))
+
+def applyOverrides(root, overrides):
+    """Apply the overrides of a sweep point to a drained simulator."""
+
+    objects = {}
+    for key, value in overrides.items():
+        if key == 'arm_sve_vl':
+            _setArmSveVectorLength(root, value)
+            continue
+        path, _, param = key.rpartition('.')
+        objects.setdefault(path, {})[param] = int(value)
+
+    for path, values in sorted(objects.items()):
+        obj = _resolve(root, path)
+        if isinstance(obj, BaseCache):
+            accepted = _cache_params
+            setter = obj.setLatencies
+        elif isinstance(obj, KPrefetcher):
+            accepted = _prefetcher_params
+            setter = obj.setStreamParams
+        else:
+            fatal("%s (%s) has no parameters that can be swept" %
+                  (path, type(obj).__name__))
+
+        for param in values:
+            if param not in accepted:
+                fatal("%s.%s can not be changed after instantiation; only "
+                      "%s can be swept" % (path, param, ", ".join(accepted)))
+
+        # Parameters not named by the point keep their configured value
+        setter(*[ values.get(p, int(getattr(obj, p))) for p in accepted ])
+
+def checkForkable(options):
+    """Fail on configurations m5.fork() can not copy, so that a sweep
+    stops before the fast-forward rather than after it."""
+
+    if getattr(options, 'cmg_parallel', False):
+        fatal("--sweep can not be used with --cmg-parallel: the host "
+              "threads of parallel event queues do not survive a fork")
+    if not m5.listenersDisabled():
+        fatal("--sweep forks the simulator, which requires listeners to "
+              "be disabled; run gem5 with --listener-mode=off")
+
+def forkSweep(options, root):
+    """Fork one child per point of the sweep file in options.sweep, with
+    at most options.sweep_jobs children running at the same time.
+    Returns in each child after its overrides have been applied; the
+    parent waits for all children and exits with the number of failed
+    points."""
+
+    checkForkable(options)
+    points = readSweep(options.sweep)
+    parent = m5.options.outdir
+    running = {}
+    failed = []
+
+    def reap():
+        pid, status = os.wait()
+        name = running.pop(pid, None)
+        if name is None:
+            return
+        if status != 0:
+            failed.append(name)
+            print("Sweep point %s failed (status %d)" % (name, status))
+        else:
+            print("Sweep point %s done" % name)
+
+    for point in points:
+        while len(running) >= max(options.sweep_jobs, 1):
+            reap()
+
+        sys.stdout.flush()
+        sys.stderr.flush()
+        name = str(point['name'])
+        pid = m5.fork(simout=os.path.join("%(parent)s", "sweep." + name))
+        if pid == 0:
+            applyOverrides(root, point['overrides'])
+            with open(os.path.join(m5.options.outdir, "sweep.json"),
+                      'w') as f:
+                json.dump(point, f, indent=4, sort_keys=True)
+            print("**** SWEEP POINT %s ****" % name)
+            return
+        running[pid] = name
+
+    while running:
+        reap()
+
+    print("Sweep of %d points in %s: %d failed" %
+          (len(points), parent, len(failed)))
+    sys.exit(len(failed))
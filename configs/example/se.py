@@ -61,6 +61,7 @@ from ruby import Ruby
 from common import Options
 from common import Simulation
 from common import CacheConfig
+from common import CmgConfig
 from common import CpuConfig
 from common import MemConfig
 from common.Caches import *
@@ -180,6 +181,9 @@ CPUClass.numThreads = numThreads
 if options.smt and options.num_cpus > 1:
     fatal("You cannot use SMT with multiple CPUs!")
 
+if options.cmg_parallel:
+    CmgConfig.checkOptions(options, CPUClass)
+
 np = options.num_cpus
 system = System(cpu = [CPUClass(cpu_id=i) for i in xrange(np)],
                 mem_mode = test_mem_mode,
@@ -189,6 +193,17 @@ system = System(cpu = [CPUClass(cpu_id=i) for i in xrange(np)],
 if numThreads > 1:
     system.multi_thread = True
 
+system.roi_policy = options.roi_policy
+system.roi_begin_count = options.roi_begin
+system.roi_end_count = options.roi_end
+system.roi_context_id = options.roi_context
+
+system.sparse_checkpoint = bool(options.sparse_checkpoint or
+                                options.sparse_checkpoint_raw)
+system.sparse_checkpoint_compress = not options.sparse_checkpoint_raw
+system.sparse_checkpoint_max_chain = options.sparse_checkpoint_max_chain
+system.checkpoint_threads = options.checkpoint_threads
+
 # Create a top-level voltage domain
 system.voltage_domain = VoltageDomain(voltage = options.sys_voltage)
 
@@ -260,6 +275,14 @@ for i in xrange(np):
         # Set ARM SVE vector length
         for t in xrange(numThreads):
             system.cpu[i].isa[t].zidr_el1 = int(options.arm_sve_vl) - 1
+            system.cpu[i].isa[t].sve_gather_fusion = \
+                options.arm_sve_gather_fusion
+            system.cpu[i].isa[t].sve_gather_fusion_max_span = \
+                options.arm_sve_gather_fusion_max_span
+            system.cpu[i].isa[t].host_fp_fast_path = \
+                options.arm_host_fp_fast_path
+            system.cpu[i].isa[t].decode_front_cache_entries = \
+                options.arm_decode_front_cache
 
 if options.ruby:
     Ruby.create_system(options, False, system)
@@ -300,4 +323,6 @@ if options.stat_dump_period != 0 :
     periodicStatDump(options.stat_dump_period)
 
 root = Root(full_system = False, system = system)
+if options.cmg_parallel:
+    CmgConfig.configRoot(options, root)
 Simulation.run(options, root, system, FutureClass)
@@ -38,7 +38,7 @@
 
 from m5.params import *
 from m5.proxy import *
-from m5.SimObject import SimObject
+from m5.SimObject import SimObject, cxxMethod
 
 from ArmPMU import ArmPMU
 from ISACommon import VecRegRenameMode
@@ -51,11 +51,36 @@ class ArmISA(SimObject):
     cxx_class = 'ArmISA::ISA'
     cxx_header = "arch/arm/isa.hh"
 
+    @cxxMethod
+    def setSveVectorLength(self, vl):
+        """Change the SVE vector length (in 128-bit units) when drained"""
+        pass
+
     system = Param.System(Parent.any, "System this ISA object belongs to")
 
     pmu = Param.ArmPMU(NULL, "Performance Monitoring Unit")
     decoderFlavour = Param.DecoderFlavour('Generic', "Decoder flavour specification")
 
+    # Decode SVE gather loads and scatter stores into a single memory
+    # micro-op instead of one micro-op per element
+    sve_gather_fusion = Param.Bool(False,
+        "Fuse SVE gather/scatter accesses into a single micro-op")
+    sve_gather_fusion_max_span = Param.MemorySize('2kB',
+        "Largest address range a fused gather/scatter may cover before "
+        "being replayed as per-element micro-ops")
+
+    # Compute simple single and double precision operations on the host
+    # FPU instead of in the software floating-point library. The setting
+    # is global, so it must be the same for all the ISA objects.
+    host_fp_fast_path = Param.Bool(False,
+        "Use host floating-point for round-to-nearest SVE/NEON operations")
+
+    # Direct-mapped cache of decoded instructions indexed by PC, checked
+    # before hashing into the decode cache
+    decode_front_cache_entries = Param.Unsigned(4096,
+        "Entries in the PC-indexed decode front cache (power of two, "
+        "0 to disable)")
+
     midr = Param.UInt32(0x410fc0f0, "MIDR value")
 
     # See section B4.1.89 - B4.1.92 of the ARM ARM
@@ -43,6 +43,8 @@ from m5.proxy import *
 from MemObject import MemObject
 from BaseTLB import BaseTLB
 
+class ArmTLBReplacement(Enum): vals = ['TlbLRU', 'TlbFIFO', 'TlbRandom']
+
 # Basic stage 1 translation objects
 class ArmTableWalker(MemObject):
     type = 'ArmTableWalker'
@@ -66,6 +68,10 @@ class ArmTLB(BaseTLB):
     cxx_header = "arch/arm/tlb.hh"
     sys = Param.System(Parent.any, "system object parameter")
     size = Param.Int(64, "TLB size")
+    assoc = Param.Int(0, "Entries per set, 0 for fully associative. Each "
+                      "page size uses its own set index")
+    replacement_policy = Param.ArmTLBReplacement('TlbLRU',
+        "Replacement policy (TlbLRU, TlbFIFO or TlbRandom)")
     walker = Param.ArmTableWalker(ArmTableWalker(), "HW Table walker")
     is_stage2 = Param.Bool(False, "Is this a stage 2 TLB?")
 
@@ -51,13 +51,17 @@
 namespace ArmISA
 {
 
-GenericISA::BasicDecodeCache Decoder::defaultCache;
+thread_local GenericISA::BasicDecodeCache Decoder::defaultCache;
 
 Decoder::Decoder(ISA* isa)
     : data(0), fpscrLen(0), fpscrStride(0), sveLen(0),
-      decoderFlavour(isa->decoderFlavour())
+      sveGatherFusion(isa->sveGatherFusion()),
+      sveGatherFusionMaxSpan(isa->sveGatherFusionMaxSpan()),
+      decoderFlavour(isa->decoderFlavour()),
+      frontCache(isa->decodeFrontCacheEntries())
 {
     sveLen = (isa->getCurSveVecLenInBits() >> 7) - 1;
+    isa->addDecoder(this);
     reset();
 }
 
@@ -158,6 +162,8 @@ Decoder::moreBytes(const PCState &pc, Addr fetchPC, MachInst inst)
     emi.fpscrLen = fpscrLen;
     emi.fpscrStride = fpscrStride;
     emi.sveLen = sveLen;
+    emi.sveGatherFusion = sveGatherFusion &&
+        sveUnfusedPCs.find(pc.instAddr()) == sveUnfusedPCs.end();
 
     const Addr alignment(pc.thumb() ? 0x1 : 0x3);
     emi.decoderFault = static_cast<uint8_t>(
@@ -44,6 +44,8 @@
 #define __ARCH_ARM_DECODER_HH__
 
 #include <cassert>
+#include <unordered_set>
+#include <vector>
 
 #include "arch/arm/miscregs.hh"
 #include "arch/arm/types.hh"
@@ -74,10 +76,39 @@ class Decoder
 
     int sveLen;
 
+    /** Fuse SVE gather/scatter micro-ops. */
+    bool sveGatherFusion;
+    /** Largest range a fused gather/scatter may access, in bytes. */
+    unsigned sveGatherFusionMaxSpan;
+    /**
+     * Gathers/scatters that were replayed because their elements were
+     * too far apart; these are always decoded into per-element
+     * micro-ops.
+     */
+    std::unordered_set<Addr> sveUnfusedPCs;
+
     Enums::DecoderFlavour decoderFlavour;
 
-    /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache defaultCache;
+    /** An entry of the PC-indexed front cache. */
+    struct FrontCacheEntry
+    {
+        Addr pc = 0;
+        ExtMachInst machInst;
+        StaticInstPtr si;
+    };
+
+    /**
+     * Direct-mapped cache of recently decoded instructions indexed by
+     * PC, checked before the decode cache. Loops hit here without
+     * hashing the instruction. An entry only hits if both the PC and
+     * the pre-decoded instruction match, so it returns the same
+     * StaticInst as the decode cache. Empty if disabled.
+     */
+    std::vector<FrontCacheEntry> frontCache;
+
+    /// A cache of decoded instruction objects. There is one per host
+    /// thread as CPUs on different event queues may decode in parallel.
+    static thread_local GenericISA::BasicDecodeCache defaultCache;
 
     /**
      * Pre-decode an instruction from the current state of the
@@ -168,7 +199,18 @@ class Decoder
      */
     StaticInstPtr decode(ExtMachInst mach_inst, Addr addr)
     {
-        return defaultCache.decode(this, mach_inst, addr);
+        if (frontCache.empty())
+            return defaultCache.decode(this, mach_inst, addr);
+
+        FrontCacheEntry &entry =
+            frontCache[(addr >> 2) & (frontCache.size() - 1)];
+        if (entry.si && entry.pc == addr && entry.machInst == mach_inst)
+            return entry.si;
+
+        entry.pc = addr;
+        entry.machInst = mach_inst;
+        entry.si = defaultCache.decode(this, mach_inst, addr);
+        return entry.si;
     }
 
     /**
@@ -204,6 +246,23 @@ class Decoder
     {
         sveLen = len;
     }
+
+    unsigned
+    getSveGatherFusionMaxSpan() const
+    {
+        return sveGatherFusionMaxSpan;
+    }
+
+    /**
+     * Stop fusing the gather or scatter at the given PC. Used by fused
+     * micro-ops that cannot issue their access as a single request
+     * before they ask for the instruction to be re-executed.
+     */
+    void
+    disableSveGatherFusion(Addr pc)
+    {
+        sveUnfusedPCs.insert(pc);
+    }
 };
 
 } // namespace ArmISA
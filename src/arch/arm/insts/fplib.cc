@@ -41,6 +41,8 @@
 #include <stdint.h>
 
 #include <cassert>
+#include <cmath>
+#include <cstring>
 
 #include "fplib.hh"
 
@@ -2232,6 +2234,157 @@ set_fpscr(FPSCR &fpscr, int flags)
     }
 }
 
+// Host floating-point fast path. Once the cumulative inexact flag is
+// set, a single or double precision operation whose operands and
+// result are normal numbers or zeros cannot raise any other exception,
+// so only its result matters. In round-to-nearest mode, the host FPU
+// computes the same result much faster. Everything else, including
+// subnormals, infinities, NaNs, overflow and underflow, goes through
+// the software implementation. The switch is global, the ISA objects
+// make sure that they all ask for the same setting.
+
+static bool hostFastPath = false;
+
+void
+fplibSetHostFastPath(bool enable)
+{
+    hostFastPath = enable;
+}
+
+bool
+fplibHostFastPath()
+{
+    return hostFastPath;
+}
+
+template <class T>
+struct HostFp;
+
+template <>
+struct HostFp<uint32_t>
+{
+    typedef float Type;
+    static const int ExpInf = FP32_EXP_INF;
+
+    static int exp(uint32_t x) { return FP32_EXP(x); }
+};
+
+template <>
+struct HostFp<uint64_t>
+{
+    typedef double Type;
+    static const int ExpInf = FP64_EXP_INF;
+
+    static int exp(uint64_t x) { return FP64_EXP(x); }
+};
+
+template <class T>
+static inline bool
+host_fp_zero(T x)
+{
+    return !(T)(x << 1);
+}
+
+// Normal number or zero
+template <class T>
+static inline bool
+host_fp_operand(T x)
+{
+    int exp = HostFp<T>::exp(x);
+    return exp != HostFp<T>::ExpInf && (exp || host_fp_zero(x));
+}
+
+template <class T>
+static inline bool
+host_fp_enabled(FPSCR fpscr)
+{
+    return hostFastPath && fpscr.ixc && (modeConv(fpscr) & 3) == FPLIB_RN;
+}
+
+template <class T>
+static inline typename HostFp<T>::Type
+host_fp_from(T x)
+{
+    typename HostFp<T>::Type f;
+    memcpy(&f, &x, sizeof(f));
+    return f;
+}
+
+// Accept a host result that is a normal number, or a zero if the
+// operation cannot have underflowed. The smallest normal exponent is
+// rejected too, since the host may detect tininess after rounding.
+template <class T>
+static inline bool
+host_fp_result(typename HostFp<T>::Type f, bool zero_ok, T &result)
+{
+    memcpy(&result, &f, sizeof(result));
+    int exp = HostFp<T>::exp(result);
+    return exp != HostFp<T>::ExpInf &&
+        (exp > 1 || (zero_ok && host_fp_zero(result)));
+}
+
+template <class T>
+static bool
+host_fp_add(T a, T b, bool neg, FPSCR fpscr, T &result)
+{
+    if (!host_fp_enabled<T>(fpscr) || !host_fp_operand(a) ||
+        !host_fp_operand(b)) {
+        return false;
+    }
+    typename HostFp<T>::Type x = host_fp_from(a), y = host_fp_from(b);
+    // A zero sum of normal numbers is an exact cancellation
+    return host_fp_result(neg ? x - y : x + y, true, result);
+}
+
+template <class T>
+static bool
+host_fp_mul(T a, T b, FPSCR fpscr, T &result)
+{
+    if (!host_fp_enabled<T>(fpscr) || !host_fp_operand(a) ||
+        !host_fp_operand(b)) {
+        return false;
+    }
+    return host_fp_result(host_fp_from(a) * host_fp_from(b),
+                          host_fp_zero(a) || host_fp_zero(b), result);
+}
+
+template <class T>
+static bool
+host_fp_muladd(T a, T b, T c, FPSCR fpscr, T &result)
+{
+    if (!host_fp_enabled<T>(fpscr) || !host_fp_operand(a) ||
+        !host_fp_operand(b) || !host_fp_operand(c)) {
+        return false;
+    }
+    return host_fp_result(std::fma(host_fp_from(b), host_fp_from(c),
+                                   host_fp_from(a)),
+                          host_fp_zero(b) || host_fp_zero(c), result);
+}
+
+template <class T>
+static bool
+host_fp_div(T a, T b, FPSCR fpscr, T &result)
+{
+    if (!host_fp_enabled<T>(fpscr) || !host_fp_operand(a) ||
+        !host_fp_operand(b)) {
+        return false;
+    }
+    return host_fp_result(host_fp_from(a) / host_fp_from(b),
+                          host_fp_zero(a), result);
+}
+
+template <class T>
+static bool
+host_fp_sqrt(T a, FPSCR fpscr, T &result)
+{
+    // Negative operands other than -0 are invalid
+    if (!host_fp_enabled<T>(fpscr) || !host_fp_operand(a) ||
+        (a >> (sizeof(T) * 8 - 1) && !host_fp_zero(a))) {
+        return false;
+    }
+    return host_fp_result(std::sqrt(host_fp_from(a)), true, result);
+}
+
 template <>
 bool
 fplibCompareEQ(uint16_t a, uint16_t b, FPSCR &fpscr)
@@ -2387,8 +2540,12 @@ template <>
 uint32_t
 fplibAdd(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_add(op1, op2, false, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_add(op1, op2, 0, modeConv(fpscr), &flags);
+    result = fp32_add(op1, op2, 0, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -2397,8 +2554,12 @@ template <>
 uint64_t
 fplibAdd(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_add(op1, op2, false, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_add(op1, op2, 0, modeConv(fpscr), &flags);
+    result = fp64_add(op1, op2, 0, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -2872,8 +3033,12 @@ template <>
 uint32_t
 fplibMulAdd(uint32_t addend, uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_muladd(addend, op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_muladd(addend, op1, op2, 0, modeConv(fpscr), &flags);
+    result = fp32_muladd(addend, op1, op2, 0, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -2882,8 +3047,12 @@ template <>
 uint64_t
 fplibMulAdd(uint64_t addend, uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_muladd(addend, op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_muladd(addend, op1, op2, 0, modeConv(fpscr), &flags);
+    result = fp64_muladd(addend, op1, op2, 0, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -2902,8 +3071,12 @@ template <>
 uint32_t
 fplibDiv(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_div(op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_div(op1, op2, modeConv(fpscr), &flags);
+    result = fp32_div(op1, op2, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -2912,8 +3085,12 @@ template <>
 uint64_t
 fplibDiv(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_div(op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_div(op1, op2, modeConv(fpscr), &flags);
+    result = fp64_div(op1, op2, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -3362,8 +3539,12 @@ template <>
 uint32_t
 fplibMul(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_mul(op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_mul(op1, op2, modeConv(fpscr), &flags);
+    result = fp32_mul(op1, op2, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -3372,8 +3553,12 @@ template <>
 uint64_t
 fplibMul(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_mul(op1, op2, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_mul(op1, op2, modeConv(fpscr), &flags);
+    result = fp64_mul(op1, op2, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -4302,8 +4487,12 @@ template <>
 uint32_t
 fplibSqrt(uint32_t op, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_sqrt(op, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_sqrt(op, modeConv(fpscr), &flags);
+    result = fp32_sqrt(op, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -4312,8 +4501,12 @@ template <>
 uint64_t
 fplibSqrt(uint64_t op, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_sqrt(op, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_sqrt(op, modeConv(fpscr), &flags);
+    result = fp64_sqrt(op, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -4332,8 +4525,12 @@ template <>
 uint32_t
 fplibSub(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
+    uint32_t result;
+    if (host_fp_add(op1, op2, true, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint32_t result = fp32_add(op1, op2, 1, modeConv(fpscr), &flags);
+    result = fp32_add(op1, op2, 1, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -4342,8 +4539,12 @@ template <>
 uint64_t
 fplibSub(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
+    uint64_t result;
+    if (host_fp_add(op1, op2, true, fpscr, result))
+        return result;
+
     int flags = 0;
-    uint64_t result = fp64_add(op1, op2, 1, modeConv(fpscr), &flags);
+    result = fp64_add(op1, op2, 1, modeConv(fpscr), &flags);
     set_fpscr0(fpscr, flags);
     return result;
 }
@@ -174,6 +174,15 @@ T fplibInfinity(int sgn);
 /** Foating-point value for default NaN. */
 template <class T>
 T fplibDefaultNaN();
+/**
+ * Compute single and double precision add, subtract, multiply,
+ * multiply-add, divide and square root on the host FPU when it gives
+ * the same result and flags as the software implementation. This is
+ * a global setting of the library, shared by all the simulated CPUs.
+ */
+void fplibSetHostFastPath(bool enable);
+/** Whether the host FPU fast path is enabled. */
+bool fplibHostFastPath();
 
 /* Function specializations... */
 template <>
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "arch/arm/insts/fplib.hh"
+
+using namespace ArmISA;
+
+namespace
+{
+
+template <class T>
+struct Format;
+
+template <>
+struct Format<uint32_t>
+{
+    static const int ExpBits = 8;
+    static const int MantBits = 23;
+};
+
+template <>
+struct Format<uint64_t>
+{
+    static const int ExpBits = 11;
+    static const int MantBits = 52;
+};
+
+template <class T>
+T
+makeFp(bool sgn, uint64_t exp, uint64_t mnt)
+{
+    const int exp_bits = Format<T>::ExpBits;
+    const int mnt_bits = Format<T>::MantBits;
+    return (T)sgn << (exp_bits + mnt_bits) |
+        (T)(exp & ((1ULL << exp_bits) - 1)) << mnt_bits |
+        (T)(mnt & ((1ULL << mnt_bits) - 1));
+}
+
+/**
+ * Operands at the edges of the fast path: zeros, subnormals, the
+ * smallest and largest normal numbers, infinities and NaNs, and values
+ * whose products and quotients land next to the overflow and underflow
+ * thresholds.
+ */
+template <class T>
+std::vector<T>
+edgeOperands()
+{
+    const uint64_t exp_max = (1ULL << Format<T>::ExpBits) - 1;
+    const uint64_t bias = exp_max >> 1;
+    const uint64_t mnt_max = (1ULL << Format<T>::MantBits) - 1;
+    const uint64_t quiet = 1ULL << (Format<T>::MantBits - 1);
+
+    std::vector<T> ops;
+    for (bool sgn : { false, true }) {
+        ops.push_back(makeFp<T>(sgn, 0, 0));
+        ops.push_back(makeFp<T>(sgn, 0, 1));
+        ops.push_back(makeFp<T>(sgn, 0, mnt_max));
+        ops.push_back(makeFp<T>(sgn, 1, 0));
+        ops.push_back(makeFp<T>(sgn, 1, 1));
+        ops.push_back(makeFp<T>(sgn, 2, 0));
+        ops.push_back(makeFp<T>(sgn, bias / 2, 0));
+        ops.push_back(makeFp<T>(sgn, bias / 2 + 1, mnt_max));
+        ops.push_back(makeFp<T>(sgn, bias - 1, mnt_max));
+        ops.push_back(makeFp<T>(sgn, bias, 0));
+        ops.push_back(makeFp<T>(sgn, bias, 1));
+        ops.push_back(makeFp<T>(sgn, bias + 1, quiet));
+        ops.push_back(makeFp<T>(sgn, bias + bias / 2, mnt_max));
+        ops.push_back(makeFp<T>(sgn, exp_max - 1, 0));
+        ops.push_back(makeFp<T>(sgn, exp_max - 1, mnt_max));
+        ops.push_back(makeFp<T>(sgn, exp_max, 0));
+        ops.push_back(makeFp<T>(sgn, exp_max, quiet));
+        ops.push_back(makeFp<T>(sgn, exp_max, 1));
+    }
+    return ops;
+}
+
+/**
+ * A random operand. Most are normal numbers with exponents clustered
+ * around one, the underflow threshold and the overflow threshold, so
+ * that results often fall just either side of them.
+ */
+template <class T>
+T
+randomOperand(std::mt19937_64 &rng)
+{
+    const uint64_t exp_max = (1ULL << Format<T>::ExpBits) - 1;
+    const uint64_t bias = exp_max >> 1;
+    const uint64_t spread = 8;
+
+    uint64_t exp;
+    switch (rng() % 8) {
+      case 0:
+        // any encoding, including subnormals, infinities and NaNs
+        return rng();
+      case 1:
+        exp = rng() % spread;
+        break;
+      case 2:
+        exp = exp_max - 1 - rng() % spread;
+        break;
+      case 3:
+        exp = bias / 2 + rng() % spread - spread / 2;
+        break;
+      case 4:
+        exp = bias + bias / 2 + rng() % spread - spread / 2;
+        break;
+      default:
+        exp = bias + rng() % (2 * spread) - spread;
+        break;
+    }
+    return makeFp<T>(rng() & 1, exp, rng());
+}
+
+template <class T>
+using FpOp = std::function<T(T, T, T, FPSCR &)>;
+
+template <class T>
+std::vector<std::pair<const char *, FpOp<T>>>
+fastPathOps()
+{
+    return {
+        { "add", [](T a, T b, T c, FPSCR &f) { return fplibAdd(a, b, f); } },
+        { "sub", [](T a, T b, T c, FPSCR &f) { return fplibSub(a, b, f); } },
+        { "mul", [](T a, T b, T c, FPSCR &f) { return fplibMul(a, b, f); } },
+        { "muladd",
+          [](T a, T b, T c, FPSCR &f) { return fplibMulAdd(a, b, c, f); } },
+        { "div", [](T a, T b, T c, FPSCR &f) { return fplibDiv(a, b, f); } },
+        { "sqrt", [](T a, T b, T c, FPSCR &f) { return fplibSqrt(a, f); } },
+    };
+}
+
+/**
+ * Every FPSCR setting that the arithmetic looks at: the four rounding
+ * modes, flush-to-zero and default NaN, with the cumulative flags
+ * either clear or all set. The fast path only kicks in once IXC is set.
+ */
+std::vector<uint32_t>
+fpscrModes()
+{
+    std::vector<uint32_t> modes;
+    for (int rmode = 0; rmode < 4; ++rmode) {
+        for (int fz = 0; fz < 2; ++fz) {
+            for (int dn = 0; dn < 2; ++dn) {
+                for (int flags = 0; flags < 3; ++flags) {
+                    FPSCR fpscr = 0;
+                    fpscr.rMode = rmode;
+                    fpscr.fz = fz;
+                    fpscr.dn = dn;
+                    fpscr.ixc = flags > 0;
+                    if (flags == 2) {
+                        fpscr.ioc = 1;
+                        fpscr.dzc = 1;
+                        fpscr.ofc = 1;
+                        fpscr.ufc = 1;
+                        fpscr.idc = 1;
+                    }
+                    modes.push_back(fpscr);
+                }
+            }
+        }
+    }
+    return modes;
+}
+
+/**
+ * Run one operation with and without the host fast path and check
+ * that the result and the FPSCR flags are the same.
+ */
+template <class T>
+void
+checkOp(const char *name, const FpOp<T> &op, uint32_t mode, T a, T b, T c)
+{
+    FPSCR soft_fpscr = mode;
+    fplibSetHostFastPath(false);
+    T soft = op(a, b, c, soft_fpscr);
+
+    FPSCR host_fpscr = mode;
+    fplibSetHostFastPath(true);
+    T host = op(a, b, c, host_fpscr);
+    fplibSetHostFastPath(false);
+
+    ASSERT_EQ(soft, host) << std::hex << name << " " << a << " " << b
+                          << " " << c << " fpscr " << mode;
+    ASSERT_EQ((uint32_t)soft_fpscr, (uint32_t)host_fpscr)
+        << std::hex << name << " " << a << " " << b << " " << c
+        << " fpscr " << mode;
+}
+
+template <class T>
+void
+checkEdgeOperands()
+{
+    const std::vector<T> ops = edgeOperands<T>();
+    for (const auto &op : fastPathOps<T>()) {
+        for (uint32_t mode : fpscrModes()) {
+            for (T a : ops) {
+                for (T b : ops) {
+                    // a third operand only matters to muladd
+                    for (T c : ops) {
+                        checkOp<T>(op.first, op.second, mode, a, b, c);
+                        if (::testing::Test::HasFatalFailure())
+                            return;
+                        if (op.first != std::string("muladd"))
+                            break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void
+checkRandomOperands()
+{
+    std::mt19937_64 rng(1);
+    for (const auto &op : fastPathOps<T>()) {
+        for (uint32_t mode : fpscrModes()) {
+            for (int i = 0; i < 2000; ++i) {
+                T a = randomOperand<T>(rng);
+                T b = randomOperand<T>(rng);
+                T c = randomOperand<T>(rng);
+                checkOp<T>(op.first, op.second, mode, a, b, c);
+                if (::testing::Test::HasFatalFailure())
+                    return;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+TEST(FplibTest, HostFastPathEdgeOperands32)
+{
+    checkEdgeOperands<uint32_t>();
+}
+
+TEST(FplibTest, HostFastPathEdgeOperands64)
+{
+    checkEdgeOperands<uint64_t>();
+}
+
+TEST(FplibTest, HostFastPathRandomOperands32)
+{
+    checkRandomOperands<uint32_t>();
+}
+
+TEST(FplibTest, HostFastPathRandomOperands64)
+{
+    checkRandomOperands<uint64_t>();
+}
+
+/**
+ * Exact results of normal operands: once IXC is set these are computed
+ * on the host, and must still match the IEEE values.
+ */
+TEST(FplibTest, HostFastPathExactResults)
+{
+    FPSCR fpscr = 0;
+    fpscr.ixc = 1;
+    fplibSetHostFastPath(true);
+
+    const uint64_t one = 0x3ff0000000000000ULL;
+    const uint64_t two = 0x4000000000000000ULL;
+    const uint64_t three = 0x4008000000000000ULL;
+    const uint64_t four = 0x4010000000000000ULL;
+    EXPECT_EQ(three, fplibAdd(one, two, fpscr));
+    EXPECT_EQ(one, fplibSub(three, two, fpscr));
+    EXPECT_EQ(four, fplibMul(two, two, fpscr));
+    EXPECT_EQ(three, fplibMulAdd(one, one, two, fpscr));
+    EXPECT_EQ(two, fplibDiv(four, two, fpscr));
+    EXPECT_EQ(two, fplibSqrt(four, fpscr));
+    // exact cancellation gives +0 when rounding to nearest
+    EXPECT_EQ(0u, fplibSub(three, three, fpscr));
+    EXPECT_EQ(0x10u, (uint32_t)fpscr);
+
+    fplibSetHostFastPath(false);
+}
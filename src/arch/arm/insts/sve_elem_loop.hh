@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Element loops of the SVE execute bodies, specialised on the vector
+ * length.
+ *
+ * The generated execute methods used to loop over a number of elements
+ * that is only known at run time, which keeps the host compiler from
+ * unrolling or vectorising them. sveForEachElem() switches once on the
+ * current element count and runs the body in a loop with a compile-time
+ * trip count for each of the power-of-two vector lengths (128 to 2048
+ * bits). Other vector lengths fall back to a plain loop.
+ */
+
+#ifndef __ARCH_ARM_INSTS_SVE_ELEM_LOOP_HH__
+#define __ARCH_ARM_INSTS_SVE_ELEM_LOOP_HH__
+
+namespace ArmISA
+{
+
+/** Run body(i) for i in [0, N), with N known at compile time. */
+template <unsigned N, typename Body>
+inline void
+sveFixedElemLoop(Body &body)
+{
+    for (unsigned i = 0; i < N; i++)
+        body(i);
+}
+
+/**
+ * Run body(i) for every element index i of a vector of eCount elements
+ * of type Element. The body is called in increasing index order.
+ */
+template <typename Element, typename Body>
+inline void
+sveForEachElem(unsigned eCount, Body body)
+{
+    static_assert(sizeof(Element) <= 16, "SVE elements are at most 128-bit");
+    constexpr unsigned qElems = 16 / sizeof(Element);
+
+    switch (eCount) {
+      case qElems:
+        sveFixedElemLoop<qElems>(body);
+        break;
+      case 2 * qElems:
+        sveFixedElemLoop<2 * qElems>(body);
+        break;
+      case 4 * qElems:
+        sveFixedElemLoop<4 * qElems>(body);
+        break;
+      case 8 * qElems:
+        sveFixedElemLoop<8 * qElems>(body);
+        break;
+      case 16 * qElems:
+        sveFixedElemLoop<16 * qElems>(body);
+        break;
+      default:
+        for (unsigned i = 0; i < eCount; i++)
+            body(i);
+        break;
+    }
+}
+
+} // namespace ArmISA
+
+#endif // __ARCH_ARM_INSTS_SVE_ELEM_LOOP_HH__
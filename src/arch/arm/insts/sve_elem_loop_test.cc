@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arch/arm/insts/sve_elem_loop.hh"
+#include "arch/generic/vec_reg.hh"
+
+using namespace ArmISA;
+
+namespace
+{
+
+typedef VecRegContainer<256> Reg;
+
+/** Element loop of an unpredicated SVE add as generated before. */
+template <typename Element>
+void
+addRuntime(const Reg &op1, const Reg &op2, Reg &dest, unsigned eCount)
+{
+    const Reg tmp_s0(op1, VecRegLiveCopy());
+    const Reg tmp_s1(op2, VecRegLiveCopy());
+    auto op1_x = tmp_s0.as<Element>();
+    auto op2_x = tmp_s1.as<Element>();
+    auto dest_x = dest.as<Element>();
+    for (unsigned i = 0; i < eCount; i++) {
+        const Element& srcElem1 = op1_x[i];
+        const Element& srcElem2 = op2_x[i];
+        Element destElem = 0;
+        destElem = srcElem1 + srcElem2;
+        dest_x[i] = destElem;
+    }
+}
+
+/** The same loop with the vector length specialised. */
+template <typename Element>
+void
+addSpecialised(const Reg &op1, const Reg &op2, Reg &dest, unsigned eCount)
+{
+    const Reg tmp_s0(op1, VecRegLiveCopy());
+    const Reg tmp_s1(op2, VecRegLiveCopy());
+    auto op1_x = tmp_s0.as<Element>();
+    auto op2_x = tmp_s1.as<Element>();
+    auto dest_x = dest.as<Element>();
+    sveForEachElem<Element>(eCount, [&](unsigned i) {
+        const Element& srcElem1 = op1_x[i];
+        const Element& srcElem2 = op2_x[i];
+        Element destElem = 0;
+        destElem = srcElem1 + srcElem2;
+        dest_x[i] = destElem;
+    });
+}
+
+template <typename Element>
+void
+checkOrder()
+{
+    // Every vector length the architecture allows, not only the powers
+    // of two.
+    for (unsigned bits = 128; bits <= 2048; bits += 128) {
+        const unsigned eCount = bits / 8 / sizeof(Element);
+        std::vector<unsigned> seen;
+        sveForEachElem<Element>(eCount, [&](unsigned i) {
+            seen.push_back(i);
+        });
+        ASSERT_EQ(eCount, seen.size()) << bits;
+        for (unsigned i = 0; i < eCount; i++)
+            EXPECT_EQ(i, seen[i]) << bits;
+    }
+}
+
+template <typename Element>
+void
+checkAdd(std::mt19937 &rng)
+{
+    Reg op1, op2, expected, actual;
+    for (unsigned bits = 128; bits <= 2048; bits += 128) {
+        const unsigned eCount = bits / 8 / sizeof(Element);
+        for (unsigned i = 0; i < Reg::SIZE; i++) {
+            op1.as<uint8_t>()[i] = rng();
+            op2.as<uint8_t>()[i] = rng();
+        }
+        expected.zero();
+        actual.zero();
+        addRuntime<Element>(op1, op2, expected, eCount);
+        addSpecialised<Element>(op1, op2, actual, eCount);
+        EXPECT_EQ(expected, actual) << bits;
+    }
+}
+
+} // anonymous namespace
+
+TEST(SveElemLoopTest, VisitsEveryElementInOrder)
+{
+    checkOrder<uint8_t>();
+    checkOrder<uint16_t>();
+    checkOrder<uint32_t>();
+    checkOrder<uint64_t>();
+}
+
+TEST(SveElemLoopTest, MatchesRuntimeLoop)
+{
+    std::mt19937 rng(1);
+    checkAdd<uint8_t>(rng);
+    checkAdd<uint16_t>(rng);
+    checkAdd<uint32_t>(rng);
+    checkAdd<uint64_t>(rng);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "arch/arm/insts/sve_fusion.hh"
+
+#include <algorithm>
+
+namespace ArmISA
+{
+
+bool
+sveFusedAccessRange(const std::vector<Addr> &addrs,
+                    const std::vector<bool> &active, unsigned elemSize,
+                    unsigned maxSpan, Addr &base, unsigned &size,
+                    std::vector<bool> &byteEnable)
+{
+    Addr lo = MaxAddr;
+    Addr hi = 0;
+    for (int i = 0; i < addrs.size(); i++) {
+        if (active[i]) {
+            lo = std::min(lo, addrs[i]);
+            hi = std::max(hi, addrs[i]);
+        }
+    }
+
+    base = lo;
+    size = 0;
+    byteEnable.clear();
+
+    if (lo > hi)
+        return true;
+
+    if (hi - lo + elemSize > maxSpan)
+        return false;
+
+    size = hi - lo + elemSize;
+    byteEnable.assign(size, false);
+    for (int i = 0; i < addrs.size(); i++) {
+        if (active[i]) {
+            std::fill_n(byteEnable.begin() + (addrs[i] - lo), elemSize, true);
+        }
+    }
+    return true;
+}
+
+} // namespace ArmISA
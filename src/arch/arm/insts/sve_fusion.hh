@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Access range of the fused SVE gather and scatter micro-ops.
+ */
+
+#ifndef __ARCH_ARM_INSTS_SVE_FUSION_HH__
+#define __ARCH_ARM_INSTS_SVE_FUSION_HH__
+
+#include <vector>
+
+#include "base/types.hh"
+
+namespace ArmISA
+{
+
+/**
+ * Computes the single access issued by a fused gather or scatter
+ * micro-op: the byte range between the lowest and the highest active
+ * element, and a byte-enable mask that selects the active elements
+ * only. The LSQ turns such an access into one request per cache line
+ * that holds at least one active element.
+ *
+ * @param addrs Element addresses.
+ * @param active Element predicates.
+ * @param elemSize Size of a memory element in bytes.
+ * @param maxSpan Largest range the access is allowed to cover.
+ * @param base Lowest address of the access.
+ * @param size Size of the access, zero if no element is active.
+ * @param byteEnable Byte-enable mask of the access.
+ * @return false if the active elements do not fit within maxSpan bytes.
+ */
+bool sveFusedAccessRange(const std::vector<Addr> &addrs,
+                         const std::vector<bool> &active, unsigned elemSize,
+                         unsigned maxSpan, Addr &base, unsigned &size,
+                         std::vector<bool> &byteEnable);
+
+} // namespace ArmISA
+
+#endif // __ARCH_ARM_INSTS_SVE_FUSION_HH__
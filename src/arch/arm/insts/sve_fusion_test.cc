@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "arch/arm/insts/sve_fusion.hh"
+#include "base/intmath.hh"
+
+using namespace ArmISA;
+
+TEST(SveFusionTest, AccessRange)
+{
+    const std::vector<Addr> addrs = {0x1010, 0x1000, 0x1030, 0x2000};
+    const std::vector<bool> active = {true, true, true, false};
+    Addr base;
+    unsigned size;
+    std::vector<bool> en;
+
+    ASSERT_TRUE(sveFusedAccessRange(addrs, active, 4, 64, base, size, en));
+    EXPECT_EQ(0x1000, base);
+    EXPECT_EQ(0x34, size);
+    ASSERT_EQ(size, en.size());
+    for (unsigned i = 0; i < size; ++i) {
+        const bool expected = i < 4 || (i >= 0x10 && i < 0x14) || i >= 0x30;
+        EXPECT_EQ(expected, en[i]) << i;
+    }
+
+    // Inactive elements do not count towards the span.
+    ASSERT_FALSE(sveFusedAccessRange(addrs, {true, true, true, true}, 4,
+                                     64, base, size, en));
+}
+
+TEST(SveFusionTest, NoActiveElement)
+{
+    Addr base;
+    unsigned size = 1;
+    std::vector<bool> en(1);
+    EXPECT_TRUE(sveFusedAccessRange({0x1000, 0x9000}, {false, false}, 8, 64,
+                                    base, size, en));
+    EXPECT_EQ(0, size);
+    EXPECT_TRUE(en.empty());
+}
+
+/*
+ * With the span capped at a cache line, as TimingSimpleCPU does, a
+ * fused access never touches more than the two lines that CPU can split
+ * an access into.
+ */
+TEST(SveFusionTest, LineCapKeepsAccessesSplittable)
+{
+    const unsigned line = 64;
+    std::mt19937 rng(1);
+    for (int n = 0; n < 10000; ++n) {
+        const unsigned elem_size = 1 << (rng() % 4);
+        const unsigned elems = 512 / 8 / elem_size;
+        const Addr region = 0x10000 + (rng() % 64) * line;
+        const unsigned spread = 1 << (rng() % 10);
+        std::vector<Addr> addrs(elems);
+        std::vector<bool> active(elems);
+        for (unsigned i = 0; i < elems; ++i) {
+            addrs[i] = region + (rng() % spread) * elem_size;
+            active[i] = rng() % 4 != 0;
+        }
+
+        Addr base;
+        unsigned size;
+        std::vector<bool> en;
+        if (!sveFusedAccessRange(addrs, active, elem_size, line, base, size,
+                                 en)) {
+            continue;
+        }
+        ASSERT_LE(size, line);
+        if (size > 0) {
+            EXPECT_LE(roundDown(base + size - 1, line) - roundDown(base, line),
+                      line);
+        }
+    }
+}
@@ -336,6 +336,7 @@ class SveStStructSI : public PredMacroOp
 
 template <typename RegElemType, typename MemElemType,
           template <typename, typename> class MicroopType,
+          template <typename, typename> class FusedMicroopType,
           template <typename> class FirstFaultWritebackMicroopType>
 class SveIndexedMemVI : public PredMacroOp
 {
@@ -358,7 +359,11 @@ class SveIndexedMemVI : public PredMacroOp
 
         int num_elems = ((machInst.sveLen + 1) * 16) / sizeof(RegElemType);
 
-        numMicroops = num_elems;
+        // First-faulting gathers keep one micro-op per element, as the
+        // FFR update depends on which element faulted
+        bool fused = machInst.sveGatherFusion && !firstFault;
+
+        numMicroops = fused ? 1 : num_elems;
         if (isLoad) {
             if (firstFault) {
                 numMicroops += 2;
@@ -382,11 +387,19 @@ class SveIndexedMemVI : public PredMacroOp
             uop++;
         }
 
-        for (int i = 0; i < num_elems; i++, uop++) {
-            *uop = new MicroopType<RegElemType, MemElemType>(
+        if (fused) {
+            *uop = new FusedMicroopType<RegElemType, MemElemType>(
                 mnem, machInst, __opClass, _dest, _gp,
-                isLoad ? (IntRegIndex) VECREG_UREG0 : _base, _imm, i,
-                num_elems, firstFault);
+                isLoad ? (IntRegIndex) VECREG_UREG0 : _base, _imm,
+                num_elems);
+            uop++;
+        } else {
+            for (int i = 0; i < num_elems; i++, uop++) {
+                *uop = new MicroopType<RegElemType, MemElemType>(
+                    mnem, machInst, __opClass, _dest, _gp,
+                    isLoad ? (IntRegIndex) VECREG_UREG0 : _base, _imm, i,
+                    num_elems, firstFault);
+            }
         }
 
         if (firstFault)
@@ -432,6 +445,7 @@ class SveIndexedMemVI : public PredMacroOp
 
 template <typename RegElemType, typename MemElemType,
           template <typename, typename> class MicroopType,
+          template <typename, typename> class FusedMicroopType,
           template <typename> class FirstFaultWritebackMicroopType>
 class SveIndexedMemSV : public PredMacroOp
 {
@@ -462,7 +476,11 @@ class SveIndexedMemSV : public PredMacroOp
 
         int num_elems = ((machInst.sveLen + 1) * 16) / sizeof(RegElemType);
 
-        numMicroops = num_elems;
+        // First-faulting gathers keep one micro-op per element, as the
+        // FFR update depends on which element faulted
+        bool fused = machInst.sveGatherFusion && !firstFault;
+
+        numMicroops = fused ? 1 : num_elems;
         if (isLoad) {
             if (firstFault) {
                 numMicroops += 2;
@@ -486,11 +504,20 @@ class SveIndexedMemSV : public PredMacroOp
             uop++;
         }
 
-        for (int i = 0; i < num_elems; i++, uop++) {
-            *uop = new MicroopType<RegElemType, MemElemType>(
+        if (fused) {
+            *uop = new FusedMicroopType<RegElemType, MemElemType>(
                 mnem, machInst, __opClass, _dest, _gp, _base,
                 isLoad ? (IntRegIndex) VECREG_UREG0 : _offset, _offsetIs32,
-                _offsetIsSigned, _offsetIsScaled, i, num_elems, firstFault);
+                _offsetIsSigned, _offsetIsScaled, num_elems);
+            uop++;
+        } else {
+            for (int i = 0; i < num_elems; i++, uop++) {
+                *uop = new MicroopType<RegElemType, MemElemType>(
+                    mnem, machInst, __opClass, _dest, _gp, _base,
+                    isLoad ? (IntRegIndex) VECREG_UREG0 : _offset,
+                    _offsetIs32, _offsetIsSigned, _offsetIsScaled, i,
+                    num_elems, firstFault);
+            }
         }
 
         if (firstFault)
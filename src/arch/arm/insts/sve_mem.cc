@@ -39,6 +39,12 @@
 
 #include "arch/arm/insts/sve_mem.hh"
 
+#include <algorithm>
+
+#include "arch/arm/decoder.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+
 namespace ArmISA
 {
 
@@ -113,4 +119,11 @@ SveContigMemSI::generateDisassembly(Addr pc, const SymbolTable *symtab) const
     return ss.str();
 }
 
+unsigned
+sveFusedMaxSpan(ThreadContext *tc)
+{
+    return std::min(tc->getDecoderPtr()->getSveGatherFusionMaxSpan(),
+                    tc->getCpuPtr()->maxMemAccessSpan());
+}
+
 }  // namespace ArmISA
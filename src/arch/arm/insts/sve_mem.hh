@@ -40,7 +40,10 @@
 #ifndef __ARCH_ARM_SVE_MEM_HH__
 #define __ARCH_ARM_SVE_MEM_HH__
 
+#include <vector>
+
 #include "arch/arm/insts/static_inst.hh"
+#include "arch/arm/insts/sve_fusion.hh"
 #include "arch/arm/tlb.hh"
 
 namespace ArmISA
@@ -148,6 +151,13 @@ class SveContigMemSI : public ArmStaticInst
     std::string generateDisassembly(Addr pc, const SymbolTable *symtab) const;
 };
 
+/**
+ * Largest range a fused gather or scatter micro-op may cover on the
+ * given thread: the configured limit, or less if the CPU cannot split
+ * an access that large.
+ */
+unsigned sveFusedMaxSpan(ThreadContext *tc);
+
 }  // namespace ArmISA
 
 #endif  // __ARCH_ARM_SVE_MEM_HH__
@@ -39,9 +39,12 @@
  */
 
 #include "arch/arm/isa.hh"
+#include "arch/arm/decoder.hh"
+#include "arch/arm/insts/fplib.hh"
 #include "arch/arm/pmu.hh"
 #include "arch/arm/system.hh"
 #include "arch/arm/tlb.hh"
+#include "base/intmath.hh"
 #include "cpu/base.hh"
 #include "cpu/checker/cpu.hh"
 #include "debug/Arm.hh"
@@ -60,10 +63,29 @@ ISA::ISA(Params *p)
       system(NULL),
       _decoderFlavour(p->decoderFlavour),
       _vecRegRenameMode(p->vecRegRenameMode),
+      _sveGatherFusion(p->sve_gather_fusion),
+      _sveGatherFusionMaxSpan(p->sve_gather_fusion_max_span),
+      _decodeFrontCacheEntries(p->decode_front_cache_entries),
       pmu(p->pmu)
 {
     miscRegs[MISCREG_SCTLR_RST] = 0;
 
+    // The fast path is a global setting of fplib, which the first ISA
+    // object sets for all of them
+    static std::string host_fp_owner;
+    if (host_fp_owner.empty()) {
+        host_fp_owner = name();
+        fplibSetHostFastPath(p->host_fp_fast_path);
+    }
+    fatal_if(fplibHostFastPath() != p->host_fp_fast_path,
+             "%s: host_fp_fast_path differs from that of %s\n",
+             name(), host_fp_owner);
+
+    fatal_if(_decodeFrontCacheEntries &&
+             !isPowerOf2(_decodeFrontCacheEntries),
+             "%s: decode_front_cache_entries must be a power of two\n",
+             name());
+
     // Hook up a dummy device if we haven't been configured with a
     // real PMU. By using a dummy device, we don't need to check that
     // the PMU exist every time we try to access a PMU register.
@@ -96,6 +118,7 @@ ISA::ISA(Params *p)
     preUnflattenMiscReg();
 
     clear();
+    updateVecRegLiveSize();
 }
 
 std::vector<struct ISA::MiscRegLUTEntry> ISA::lookUpMiscReg(NUM_MISCREGS);
@@ -1952,6 +1975,26 @@ ISA::getGenericTimer(ThreadContext *tc)
     return *timer.get();
 }
 
+void
+ISA::setSveVectorLength(unsigned vl)
+{
+    fatal_if(vl < 1 || vl > 16, "Invalid SVE vector length %d\n", vl);
+
+    sveVL = vl;
+    miscRegs[MISCREG_ZIDR_EL1] =
+        insertBits(miscRegs[MISCREG_ZIDR_EL1], 3, 0, vl - 1);
+    for (auto decoder : decoders)
+        decoder->setSveLen((getCurSveVecLenInBits() >> 7) - 1);
+    updateVecRegLiveSize();
+}
+
+void
+ISA::updateVecRegLiveSize() const
+{
+    unsigned bytes = ((miscRegs[MISCREG_ZIDR_EL1] & 0xf) + 1) * 16;
+    VecRegContainer::setLiveSize(std::min(bytes, MaxSveVecLenInBytes));
+}
+
 int
 ISA::getCurSveVecLenInBits() const
 {
@@ -43,6 +43,8 @@
 #ifndef __ARCH_ARM_ISA_HH__
 #define __ARCH_ARM_ISA_HH__
 
+#include <vector>
+
 #include "arch/arm/isa_device.hh"
 #include "arch/arm/miscregs.hh"
 #include "arch/arm/registers.hh"
@@ -63,6 +65,8 @@ class EventManager;
 
 namespace ArmISA
 {
+    class Decoder;
+
     class ISA : public SimObject
     {
       protected:
@@ -73,6 +77,16 @@ namespace ArmISA
         const Enums::DecoderFlavour _decoderFlavour;
         const Enums::VecRegRenameMode _vecRegRenameMode;
 
+        // SVE gather/scatter micro-op fusion
+        const bool _sveGatherFusion;
+        const unsigned _sveGatherFusionMaxSpan;
+
+        // Entries in the decoder's PC-indexed front cache
+        const unsigned _decodeFrontCacheEntries;
+
+        // Decoders of the thread contexts using this ISA
+        std::vector<Decoder *> decoders;
+
         /** Dummy device for to handle non-existing ISA devices */
         DummyISADevice dummyDevice;
 
@@ -641,6 +655,23 @@ namespace ArmISA
 
         int getCurSveVecLenInBits() const;
 
+        /** Register a decoder that reads its vector length from here. */
+        void addDecoder(Decoder *decoder) { decoders.push_back(decoder); }
+
+        /**
+         * Change the implemented SVE vector length to vl x 128 bits
+         * (the --arm-sve-vl value). ZIDR_EL1 and the registered
+         * decoders are updated, so the system must be drained to keep
+         * instructions decoded at the old length out of the pipeline.
+         */
+        void setSveVectorLength(unsigned vl);
+
+        /**
+         * Let vector register copies skip the bytes past the longest
+         * vector length this thread can use (ZIDR_EL1).
+         */
+        void updateVecRegLiveSize() const;
+
         static void zeroSveVecRegUpperPart(VecRegContainer &vc,
                                            unsigned eCount);
 
@@ -673,12 +704,26 @@ namespace ArmISA
             UNSERIALIZE_SCALAR(haveSVE);
             UNSERIALIZE_SCALAR(sveVL);
             UNSERIALIZE_SCALAR(physAddrRange64);
+            updateVecRegLiveSize();
         }
 
         void startup(ThreadContext *tc) {}
 
         Enums::DecoderFlavour decoderFlavour() const { return _decoderFlavour; }
 
+        bool sveGatherFusion() const { return _sveGatherFusion; }
+        unsigned
+        sveGatherFusionMaxSpan() const
+        {
+            return _sveGatherFusionMaxSpan;
+        }
+
+        unsigned
+        decodeFrontCacheEntries() const
+        {
+            return _decodeFrontCacheEntries;
+        }
+
         Enums::VecRegRenameMode
         vecRegRenameMode() const
         {
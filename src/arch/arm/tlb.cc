@@ -57,6 +57,7 @@
 #include "arch/arm/utility.hh"
 #include "arch/generic/mmapped_ipr.hh"
 #include "base/inifile.hh"
+#include "base/random.hh"
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
@@ -74,10 +75,14 @@ using namespace std;
 using namespace ArmISA;
 
 TLB::TLB(const ArmTLBParams *p)
-    : BaseTLB(p), table(new TlbEntry[p->size]), size(p->size),
+    : BaseTLB(p),
+      // On lookup, only move entries ahead when outside the first two
+      table(p->size, p->assoc, p->replacement_policy, 1,
+            [](int count) { return random_mt.random<int>(0, count - 1); }),
+      size(p->size),
       isStage2(p->is_stage2), stage2Req(false), _attr(0),
       directToStage2(false), tableWalker(p->walker), stage2Tlb(NULL),
-      stage2Mmu(NULL), test(nullptr), rangeMRU(1),
+      stage2Mmu(NULL), test(nullptr),
       aarch64(false), aarch64EL(EL0), isPriv(false), isSecure(false),
       isHyp(false), asid(0), vmid(0), hcr(0), dacr(0),
       miscRegValid(false), miscRegContext(0), curTranType(NormalTran)
@@ -97,7 +102,6 @@ TLB::TLB(const ArmTLBParams *p)
 
 TLB::~TLB()
 {
-    delete[] table;
 }
 
 void
@@ -152,29 +156,10 @@ TLB::lookup(Addr va, uint16_t asn, uint8_t vmid, bool hyp, bool secure,
             bool functional, bool ignore_asn, uint8_t target_el)
 {
 
-    TlbEntry *retval = NULL;
-
-    // Maintaining LRU array
-    int x = 0;
-    while (retval == NULL && x < size) {
-        if ((!ignore_asn && table[x].match(va, asn, vmid, hyp, secure, false,
-             target_el)) ||
-            (ignore_asn && table[x].match(va, vmid, hyp, secure, target_el))) {
-            // We only move the hit entry ahead when the position is higher
-            // than rangeMRU
-            if (x > rangeMRU && !functional) {
-                TlbEntry tmp_entry = table[x];
-                for (int i = x; i > 0; i--)
-                    table[i] = table[i - 1];
-                table[0] = tmp_entry;
-                retval = &table[0];
-            } else {
-                retval = &table[x];
-            }
-            break;
-        }
-        ++x;
-    }
+    TlbEntry *retval = table.lookup(va, [&](const TlbEntry &e) {
+            return ignore_asn ? e.match(va, vmid, hyp, secure, target_el) :
+                e.match(va, asn, vmid, hyp, secure, false, target_el);
+        }, !functional);
 
     DPRINTF(TLBVerbose, "Lookup %#x, asn %#x -> %s vmn 0x%x hyp %d secure %d "
             "ppn %#x size: %#x pa: %#x ap:%d ns:%d nstid:%d g:%d asid: %d "
@@ -201,20 +186,17 @@ TLB::insert(Addr addr, TlbEntry &entry)
             entry.ap, static_cast<uint8_t>(entry.domain), entry.ns, entry.nstid,
             entry.isHyp);
 
-    if (table[size - 1].valid)
+    const TlbEntry &victim = table.victim(entry);
+    if (victim.valid)
         DPRINTF(TLB, " - Replacing Valid entry %#x, asn %d vmn %d ppn %#x "
                 "size: %#x ap:%d ns:%d nstid:%d g:%d isHyp:%d el: %d\n",
-                table[size-1].vpn << table[size-1].N, table[size-1].asid,
-                table[size-1].vmid, table[size-1].pfn << table[size-1].N,
-                table[size-1].size, table[size-1].ap, table[size-1].ns,
-                table[size-1].nstid, table[size-1].global, table[size-1].isHyp,
-                table[size-1].el);
+                victim.vpn << victim.N, victim.asid, victim.vmid,
+                victim.pfn << victim.N, victim.size, victim.ap, victim.ns,
+                victim.nstid, victim.global, victim.isHyp, victim.el);
 
-    //inserting to MRU position and evicting the LRU one
+    //inserting to MRU position and evicting the victim
 
-    for (int i = size - 1; i > 0; --i)
-        table[i] = table[i-1];
-    table[0] = entry;
+    table.insert(entry);
 
     inserts++;
     ppRefills->notify(1);
@@ -223,15 +205,11 @@ TLB::insert(Addr addr, TlbEntry &entry)
 void
 TLB::printTlb() const
 {
-    int x = 0;
-    TlbEntry *te;
     DPRINTF(TLB, "Current TLB contents:\n");
-    while (x < size) {
-        te = &table[x];
-        if (te->valid)
-            DPRINTF(TLB, " *  %s\n", te->print());
-        ++x;
-    }
+    table.forEachInOrder([this](const TlbEntry &te) {
+            if (te.valid)
+                DPRINTF(TLB, " *  %s\n", te.print());
+        });
 }
 
 void
@@ -393,6 +371,18 @@ TLB::takeOverFrom(BaseTLB *_otlb)
         directToStage2 = otlb->directToStage2;
         stage2Req = otlb->stage2Req;
 
+        // Carry the translations over, so that the TLB stays warm
+        // across CPU switches and holds no stale entries from the
+        // last time this CPU was active.
+        std::vector<TlbEntry> entries;
+        otlb->table.forEachInOrder([&entries](const TlbEntry &e) {
+                entries.push_back(e);
+            });
+        entries.resize(min(size, (int)entries.size()));
+        for (int i = 0; i < size; i++)
+            table[i].valid = false;
+        table.restore(entries);
+
         /* Sync the stage2 MMU if they exist in both
          * the old CPU and the new
          */
@@ -417,8 +407,10 @@ TLB::serialize(CheckpointOut &cp) const
 
     int num_entries = size;
     SERIALIZE_SCALAR(num_entries);
-    for (int i = 0; i < size; i++)
-        table[i].serializeSection(cp, csprintf("TlbEntry%d", i));
+    int i = 0;
+    table.forEachInOrder([&cp, &i](const TlbEntry &e) {
+            e.serializeSection(cp, csprintf("TlbEntry%d", i++));
+        });
 }
 
 void
@@ -433,8 +425,10 @@ TLB::unserialize(CheckpointIn &cp)
 
     int num_entries;
     UNSERIALIZE_SCALAR(num_entries);
-    for (int i = 0; i < min(size, num_entries); i++)
-        table[i].unserializeSection(cp, csprintf("TlbEntry%d", i));
+    std::vector<TlbEntry> entries(min(size, num_entries));
+    for (size_t i = 0; i < entries.size(); i++)
+        entries[i].unserializeSection(cp, csprintf("TlbEntry%d", i));
+    table.restore(entries);
 }
 
 void
@@ -46,6 +46,7 @@
 
 #include "arch/arm/isa_traits.hh"
 #include "arch/arm/pagetable.hh"
+#include "arch/arm/tlb_table.hh"
 #include "arch/arm/utility.hh"
 #include "arch/arm/vtophys.hh"
 #include "arch/generic/tlb.hh"
@@ -140,7 +141,7 @@ class TLB : public BaseTLB
         S12E1Tran = 0x100
     };
   protected:
-    TlbEntry* table;     // the Page Table
+    TlbTable<TlbEntry> table; // the Page Table
     int size;            // TLB Size
     bool isStage2;       // Indicates this TLB is part of the second stage MMU
     bool stage2Req;      // Indicates whether a stage 2 lookup is also required
@@ -182,7 +183,6 @@ class TLB : public BaseTLB
     /** PMU probe for TLB refills */
     ProbePoints::PMUUPtr ppRefills;
 
-    int rangeMRU; //On lookup, only move entries ahead when outside rangeMRU
 
   public:
     TLB(const ArmTLBParams *p);
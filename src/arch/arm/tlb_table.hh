@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_ARM_TLB_TABLE_HH__
+#define __ARCH_ARM_TLB_TABLE_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+#include "enums/ArmTLBReplacement.hh"
+
+namespace ArmISA {
+
+/**
+ * The entries of an Arm TLB. The table is split into sets, each of
+ * which is kept in most to least recently used order. A single set
+ * makes the table fully associative. Otherwise an entry goes to the
+ * set selected by its virtual page number, so each page size has its
+ * own set index.
+ *
+ * Entries are also indexed by page size and virtual page number, and
+ * a lookup only probes the page sizes present in the table. The
+ * lookup result is the first matching entry in recency order, as in a
+ * linear scan of a fully associative table.
+ *
+ * The table only looks at the vpn, N, size and valid fields of an
+ * entry, which is a TlbEntry in the simulator.
+ */
+template <class Entry>
+class TlbTable
+{
+  public:
+    /** Returns a way in [0, count) for random replacement. */
+    typedef std::function<int(int count)> RandomWay;
+
+    /**
+     * @param size The number of entries.
+     * @param assoc The number of entries per set, 0 for fully
+     *              associative.
+     * @param repl The replacement policy.
+     * @param range_mru Hits on the first range_mru + 1 entries of a
+     *                  set do not update the recency order.
+     * @param random_way Source of random victims.
+     */
+    TlbTable(int size, int assoc, Enums::ArmTLBReplacement repl,
+             int range_mru, RandomWay random_way);
+
+    int size() const { return table.size(); }
+
+    /** Entry i of the table, in no particular order. */
+    Entry &operator[](int i) { return table[i]; }
+    const Entry &operator[](int i) const { return table[i]; }
+
+    /**
+     * Find the most recently used entry for which match returns true.
+     *
+     * @param va The virtual address to look up.
+     * @param match Entry predicate, only called on entries that may
+     *              contain va.
+     * @param update Whether a hit updates the recency order.
+     * @return The entry or nullptr on a miss.
+     */
+    template <class Match>
+    Entry *
+    lookup(Addr va, const Match &match, bool update)
+    {
+        // the most recently used entry of the whole table is first in
+        // the order of any lookup, and never moves on a hit
+        if (lastHit >= 0 && ways[lastHit].stamp == nextStamp + 1 &&
+            match(table[lastHit])) {
+            return &table[lastHit];
+        }
+
+        int hit = -1;
+        auto consider = [&](int way) {
+            if ((hit < 0 || ways[way].stamp < ways[hit].stamp) &&
+                match(table[way])) {
+                hit = way;
+            }
+        };
+
+        for (uint8_t shift : shifts) {
+            auto range = index.equal_range(key(va >> shift, shift));
+            for (auto i = range.first; i != range.second; ++i)
+                consider(i->second);
+        }
+        for (int way : irregular)
+            consider(way);
+
+        if (hit < 0)
+            return nullptr;
+
+        if (update)
+            touch(hit);
+        lastHit = hit;
+        return &table[hit];
+    }
+
+    /**
+     * The entry that inserting an entry would replace.
+     */
+    const Entry &victim(const Entry &entry) const;
+
+    /** Insert an entry as the most recently used one of its set. */
+    void insert(const Entry &entry);
+
+    /** Calls func on every entry, sets in order, each in recency order. */
+    template <class Func>
+    void
+    forEachInOrder(Func func) const
+    {
+        for (const Set &set : sets) {
+            for (int way = set.head; way >= 0; way = ways[way].next)
+                func(table[way]);
+        }
+    }
+
+    /**
+     * Restore entries saved with forEachInOrder. Entries are placed as
+     * if inserted in reverse order with LRU replacement, so the saved
+     * order is kept.
+     */
+    void restore(const std::vector<Entry> &entries);
+
+  private:
+    /** Recency list links and index state of each entry. */
+    struct Way
+    {
+        int prev;
+        int next;
+        /** Recency stamp, lower is more recent across all sets. */
+        int64_t stamp;
+        /** The page size this entry is indexed under, or -1. */
+        int shift;
+        bool irregular;
+    };
+
+    struct Set
+    {
+        int head;
+        int tail;
+    };
+
+    static uint64_t
+    key(Addr vpn, unsigned shift)
+    {
+        return (uint64_t(vpn) << 6) | shift;
+    }
+
+    /** The page size of an entry, -1 if it is not naturally aligned. */
+    static int pageShift(const Entry &entry);
+
+    int setOf(const Entry &entry) const;
+    int victimWay(int set) const;
+
+    void unlink(int way);
+    void pushFront(int way);
+    void touch(int way);
+
+    void addToIndex(int way);
+    void removeFromIndex(int way);
+    void replace(int way, const Entry &entry);
+
+    const Enums::ArmTLBReplacement repl;
+    const int rangeMRU;
+    const RandomWay randomWay;
+
+    std::vector<Entry> table;
+    std::vector<Way> ways;
+    std::vector<Set> sets;
+
+    /** Entries by page size and virtual page number. */
+    std::unordered_multimap<uint64_t, int> index;
+    /** Page sizes (log2) present in the index. */
+    std::vector<uint8_t> shifts;
+    /** Number of indexed entries per page size. */
+    std::vector<int> shiftCount;
+    /** Entries whose range is not a naturally aligned power of two. */
+    std::vector<int> irregular;
+
+    /** Entries per set; way w belongs to set w / setWays. */
+    const int setWays;
+
+    /** Next (decreasing) recency stamp. */
+    int64_t nextStamp;
+    /** The entry of the last hit, checked before the index. */
+    int lastHit;
+};
+
+template <class Entry>
+TlbTable<Entry>::TlbTable(int size, int assoc,
+                          Enums::ArmTLBReplacement _repl, int range_mru,
+                          RandomWay random_way)
+    : repl(_repl), rangeMRU(range_mru), randomWay(random_way), table(size),
+      ways(size),
+      shiftCount(64, 0), setWays(assoc ? assoc : size), nextStamp(-1),
+      lastHit(-1)
+{
+    fatal_if(size <= 0, "TLB size must be positive\n");
+    fatal_if(assoc < 0 || (assoc && size % assoc),
+             "TLB size %d is not a multiple of its associativity %d\n",
+             size, assoc);
+
+    const int num_sets = size / setWays;
+    sets.resize(num_sets);
+
+    // Lay out the sets in table order, first entry most recent
+    for (int s = 0; s < num_sets; ++s) {
+        sets[s].head = -1;
+        sets[s].tail = -1;
+        for (int way = s * setWays; way < (s + 1) * setWays; ++way) {
+            ways[way].prev = sets[s].tail;
+            ways[way].next = -1;
+            ways[way].stamp = 0;
+            ways[way].shift = -1;
+            ways[way].irregular = false;
+            if (sets[s].tail >= 0)
+                ways[sets[s].tail].next = way;
+            else
+                sets[s].head = way;
+            sets[s].tail = way;
+        }
+    }
+}
+
+template <class Entry>
+int
+TlbTable<Entry>::pageShift(const Entry &entry)
+{
+    const Addr bytes = entry.size + 1;
+    if (!isPowerOf2(bytes))
+        return -1;
+    const int shift = floorLog2(bytes);
+    if (((entry.vpn << entry.N) & entry.size) != 0)
+        return -1;
+    return shift;
+}
+
+template <class Entry>
+int
+TlbTable<Entry>::setOf(const Entry &entry) const
+{
+    if (sets.size() == 1)
+        return 0;
+    const int shift = pageShift(entry);
+    const Addr vpn = shift < 0 ? (entry.vpn << entry.N) >> 12 :
+        (entry.vpn << entry.N) >> shift;
+    return vpn % sets.size();
+}
+
+template <class Entry>
+int
+TlbTable<Entry>::victimWay(int set) const
+{
+    if (repl == Enums::TlbRandom) {
+        int count = 0;
+        for (int way = sets[set].head; way >= 0; way = ways[way].next) {
+            if (!table[way].valid)
+                return way;
+            ++count;
+        }
+        int pick = randomWay(count);
+        int way = sets[set].head;
+        while (pick--)
+            way = ways[way].next;
+        return way;
+    }
+
+    // LRU and FIFO replace the last entry of the set, valid or not
+    return sets[set].tail;
+}
+
+template <class Entry>
+const Entry &
+TlbTable<Entry>::victim(const Entry &entry) const
+{
+    return table[victimWay(setOf(entry))];
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::unlink(int way)
+{
+    Way &w = ways[way];
+    Set &set = sets[way / setWays];
+    if (w.prev >= 0)
+        ways[w.prev].next = w.next;
+    else
+        set.head = w.next;
+    if (w.next >= 0)
+        ways[w.next].prev = w.prev;
+    else
+        set.tail = w.prev;
+    w.prev = w.next = -1;
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::pushFront(int way)
+{
+    Way &w = ways[way];
+    Set &set = sets[way / setWays];
+    w.prev = -1;
+    w.next = set.head;
+    if (set.head >= 0)
+        ways[set.head].prev = way;
+    else
+        set.tail = way;
+    set.head = way;
+    w.stamp = nextStamp--;
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::touch(int way)
+{
+    if (repl != Enums::TlbLRU)
+        return;
+
+    // We only move the hit entry ahead when the position is higher
+    // than rangeMRU
+    int pos = 0;
+    for (int w = ways[way].prev; w >= 0 && pos <= rangeMRU;
+         w = ways[w].prev) {
+        ++pos;
+    }
+    if (pos > rangeMRU) {
+        unlink(way);
+        pushFront(way);
+    }
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::addToIndex(int way)
+{
+    const Entry &entry = table[way];
+    const int shift = pageShift(entry);
+    if (shift < 0) {
+        irregular.push_back(way);
+        ways[way].irregular = true;
+        return;
+    }
+
+    index.emplace(key((entry.vpn << entry.N) >> shift, shift), way);
+    ways[way].shift = shift;
+    if (shiftCount[shift]++ == 0) {
+        shifts.push_back(shift);
+        std::sort(shifts.begin(), shifts.end());
+    }
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::removeFromIndex(int way)
+{
+    Way &w = ways[way];
+    if (w.irregular) {
+        irregular.erase(std::find(irregular.begin(), irregular.end(), way));
+        w.irregular = false;
+        return;
+    }
+    if (w.shift < 0)
+        return;
+
+    const Entry &entry = table[way];
+    auto range = index.equal_range(
+        key((entry.vpn << entry.N) >> w.shift, w.shift));
+    for (auto i = range.first; i != range.second; ++i) {
+        if (i->second == way) {
+            index.erase(i);
+            break;
+        }
+    }
+    if (--shiftCount[w.shift] == 0) {
+        shifts.erase(std::find(shifts.begin(), shifts.end(), w.shift));
+    }
+    w.shift = -1;
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::replace(int way, const Entry &entry)
+{
+    unlink(way);
+    removeFromIndex(way);
+    table[way] = entry;
+    if (entry.valid)
+        addToIndex(way);
+    pushFront(way);
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::insert(const Entry &entry)
+{
+    replace(victimWay(setOf(entry)), entry);
+}
+
+template <class Entry>
+void
+TlbTable<Entry>::restore(const std::vector<Entry> &entries)
+{
+    for (auto e = entries.rbegin(); e != entries.rend(); ++e)
+        replace(sets[setOf(*e)].tail, *e);
+    lastHit = -1;
+}
+
+} // namespace ArmISA
+
+#endif // __ARCH_ARM_TLB_TABLE_HH__
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arch/arm/tlb_table.hh"
+
+using namespace ArmISA;
+
+namespace
+{
+
+/** The parts of TlbEntry the table and a lookup look at. */
+struct Entry
+{
+    Addr vpn = 0;
+    uint8_t N = 0;
+    Addr size = 0;
+    bool valid = false;
+    uint16_t asid = 0;
+    /** Tells entries apart, 0 for the initial invalid entries. */
+    int id = 0;
+
+    bool
+    match(Addr va, uint16_t asn) const
+    {
+        Addr v = vpn << N;
+        return valid && va >= v && va <= v + size && asid == asn;
+    }
+};
+
+typedef TlbTable<Entry> Table;
+
+/**
+ * The table TLB::lookup and TLB::insert used to keep: one array in
+ * most to least recently used order, with hits beyond rangeMRU moved
+ * to the front and inserts evicting the last entry.
+ */
+struct LinearTable
+{
+    std::vector<Entry> table;
+    const int rangeMRU;
+
+    LinearTable(int size, int range_mru)
+        : table(size), rangeMRU(range_mru)
+    {}
+
+    Entry *
+    lookup(Addr va, uint16_t asn, bool functional)
+    {
+        for (int x = 0; x < table.size(); ++x) {
+            if (!table[x].match(va, asn))
+                continue;
+            if (x > rangeMRU && !functional) {
+                Entry tmp_entry = table[x];
+                for (int i = x; i > 0; i--)
+                    table[i] = table[i - 1];
+                table[0] = tmp_entry;
+                return &table[0];
+            }
+            return &table[x];
+        }
+        return nullptr;
+    }
+
+    void
+    insert(const Entry &entry)
+    {
+        for (int i = table.size() - 1; i > 0; --i)
+            table[i] = table[i - 1];
+        table[0] = entry;
+    }
+};
+
+Table::RandomWay
+randomWay(std::mt19937 &rng)
+{
+    return [&rng](int count) { return int(rng() % count); };
+}
+
+std::vector<Entry>
+inOrder(const Table &table)
+{
+    std::vector<Entry> entries;
+    table.forEachInOrder([&entries](const Entry &e) {
+            entries.push_back(e);
+        });
+    return entries;
+}
+
+/**
+ * A random entry in a 1GB region, so that entries of different page
+ * sizes overlap. Some have a size that is not a naturally aligned
+ * power of two, which the table keeps out of its index.
+ */
+Entry
+randomEntry(std::mt19937 &rng, int id)
+{
+    static const uint8_t shifts[] = { 12, 12, 12, 16, 21, 29 };
+    Entry e;
+    e.N = shifts[rng() % 6];
+    e.vpn = (rng() % (1 << 30)) >> e.N;
+    e.size = (Addr(1) << e.N) - 1;
+    if (rng() % 16 == 0) {
+        e.N = 12;
+        e.vpn = (rng() % (1 << 30)) >> 12;
+        e.size = 3 * 4096 - 1;
+    }
+    e.valid = true;
+    e.asid = rng() % 4;
+    e.id = id;
+    return e;
+}
+
+/** An address inside an entry of the table, or anywhere in the region. */
+Addr
+randomAddr(std::mt19937 &rng, const LinearTable &ref)
+{
+    if (rng() % 4 == 0)
+        return rng() % (1 << 30);
+    const Entry &e = ref.table[rng() % ref.table.size()];
+    return (e.vpn << e.N) + rng() % (e.size + 1);
+}
+
+int
+idOf(const Entry *e)
+{
+    return e ? e->id : -1;
+}
+
+} // anonymous namespace
+
+/**
+ * Lookups, inserts and flushes give the same entries, evict the same
+ * entries and leave the same recency order as the old linear scan.
+ */
+TEST(TlbTableTest, MatchesLinearScan)
+{
+    for (int size : { 1, 2, 3, 16, 64 }) {
+        std::mt19937 rng(size);
+        Table table(size, 0, Enums::TlbLRU, 1, randomWay(rng));
+        LinearTable ref(size, 1);
+        int next_id = 1;
+
+        for (int i = 0; i < 20000; ++i) {
+            switch (rng() % 8) {
+              case 0:
+              case 1: {
+                Entry e = randomEntry(rng, next_id++);
+                ASSERT_EQ(ref.table.back().id, table.victim(e).id)
+                    << size << " " << i;
+                table.insert(e);
+                ref.insert(e);
+                break;
+              }
+              case 2: {
+                // invalidate as TLB::flushAsid does
+                uint16_t asn = rng() % 4;
+                for (int x = 0; x < size; ++x) {
+                    if (table[x].asid == asn)
+                        table[x].valid = false;
+                }
+                for (auto &e : ref.table) {
+                    if (e.asid == asn)
+                        e.valid = false;
+                }
+                break;
+              }
+              default: {
+                Addr va = randomAddr(rng, ref);
+                uint16_t asn = rng() % 4;
+                bool functional = rng() % 8 == 0;
+                Entry *hit = table.lookup(va, [va, asn](const Entry &e) {
+                        return e.match(va, asn);
+                    }, !functional);
+                ASSERT_EQ(idOf(ref.lookup(va, asn, functional)), idOf(hit))
+                    << size << " " << i;
+                break;
+              }
+            }
+
+            std::vector<Entry> order = inOrder(table);
+            ASSERT_EQ(ref.table.size(), order.size());
+            for (int x = 0; x < size; ++x) {
+                ASSERT_EQ(ref.table[x].id, order[x].id) << size << " " << i;
+                ASSERT_EQ(ref.table[x].valid, order[x].valid);
+            }
+        }
+    }
+}
+
+/** Restoring the saved order gives the same table. */
+TEST(TlbTableTest, RestoreKeepsOrder)
+{
+    std::mt19937 rng(1);
+    Table table(32, 0, Enums::TlbLRU, 1, randomWay(rng));
+    for (int id = 1; id <= 20; ++id)
+        table.insert(randomEntry(rng, id));
+    std::vector<Entry> saved = inOrder(table);
+
+    Table restored(32, 0, Enums::TlbLRU, 1, randomWay(rng));
+    restored.restore(saved);
+    std::vector<Entry> order = inOrder(restored);
+    ASSERT_EQ(saved.size(), order.size());
+    for (int x = 0; x < saved.size(); ++x)
+        EXPECT_EQ(saved[x].id, order[x].id);
+
+    // a partial checkpoint fills the front of the table
+    Table partial(32, 0, Enums::TlbLRU, 1, randomWay(rng));
+    partial.restore(std::vector<Entry>(saved.begin(), saved.begin() + 5));
+    order = inOrder(partial);
+    for (int x = 0; x < 5; ++x)
+        EXPECT_EQ(saved[x].id, order[x].id);
+}
+
+/**
+ * With sets, an entry stays in the set of its page number until
+ * another entry of that set evicts it, and the victim is the least
+ * recently used entry of the set.
+ */
+TEST(TlbTableTest, SetAssociative)
+{
+    const int size = 64, assoc = 4, num_sets = size / assoc;
+    std::mt19937 rng(1);
+    Table table(size, assoc, Enums::TlbLRU, 0, randomWay(rng));
+
+    // per set, the ids in recency order
+    std::vector<std::vector<int>> ref(num_sets);
+    for (int id = 1; id <= 2000; ++id) {
+        Entry e;
+        e.N = 12;
+        e.vpn = rng() % 1024;
+        e.size = 4095;
+        e.valid = true;
+        e.id = id;
+        std::vector<int> &set = ref[e.vpn % num_sets];
+        if (set.size() == assoc) {
+            ASSERT_EQ(set.back(), table.victim(e).id);
+            set.pop_back();
+        }
+        table.insert(e);
+        set.insert(set.begin(), id);
+
+        // hit a random entry of the same set
+        int way = rng() % set.size();
+        const int hit_id = set[way];
+        Entry *hit = nullptr;
+        for (int x = 0; x < size && !hit; ++x) {
+            if (table[x].id == hit_id)
+                hit = &table[x];
+        }
+        ASSERT_TRUE(hit);
+        Addr va = (hit->vpn << 12) + rng() % 4096;
+        ASSERT_EQ(hit, table.lookup(va, [hit_id](const Entry &e) {
+                return e.id == hit_id;
+            }, true));
+        set.erase(set.begin() + way);
+        set.insert(set.begin(), hit_id);
+    }
+}
+
+/** FIFO ignores hits, random replacement fills invalid entries first. */
+TEST(TlbTableTest, ReplacementPolicies)
+{
+    std::mt19937 rng(1);
+    Table fifo(4, 0, Enums::TlbFIFO, 0, randomWay(rng));
+    for (int id = 1; id <= 4; ++id)
+        fifo.insert(randomEntry(rng, id));
+    Entry first = inOrder(fifo).back();
+    EXPECT_EQ(1, first.id);
+    Addr va = first.vpn << first.N;
+    EXPECT_EQ(1, idOf(fifo.lookup(va, [](const Entry &e) {
+            return e.id == 1;
+        }, true)));
+    EXPECT_EQ(1, fifo.victim(first).id);
+
+    Table random(8, 0, Enums::TlbRandom, 0, randomWay(rng));
+    for (int id = 1; id <= 8; ++id) {
+        Entry e = randomEntry(rng, id);
+        EXPECT_FALSE(random.victim(e).valid);
+        random.insert(e);
+    }
+    std::vector<int> evicted(9, 0);
+    for (int i = 0; i < 800; ++i)
+        ++evicted[random.victim(randomEntry(rng, 0)).id];
+    for (int id = 1; id <= 8; ++id)
+        EXPECT_LT(0, evicted[id]);
+}
@@ -71,6 +71,9 @@ namespace ArmISA
         // Decoder state
         Bitfield<63, 62> decoderFault; // See DecoderFault
 
+        // Decode SVE gathers/scatters into a single fused micro-op
+        Bitfield<60>     sveGatherFusion;
+
         // SVE vector length (same format as ZCR_ELx.LEN)
         Bitfield<59, 56> sveLen;
 
@@ -144,8 +144,10 @@
 #ifndef __ARCH_GENERIC_VEC_REG_HH__
 #define __ARCH_GENERIC_VEC_REG_HH__
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <type_traits>
@@ -159,6 +161,9 @@ constexpr unsigned MaxVecRegLenInBytes = 256;
 template <size_t Sz>
 class VecRegContainer;
 
+/** Tag for the VecRegContainer constructor that copies the live bytes. */
+struct VecRegLiveCopy {};
+
 /** Vector Register Abstraction
  * This generic class is a view in a particularization of MVC, to vector
  * registers. There is a VecRegContainer that implements the model, and
@@ -266,6 +271,13 @@ class VecLaneT;
  * This generic class is the model in a particularization of MVC, to vector
  * registers. The model has functionality to create views of itself, or a
  * portion through the method 'as
+ *
+ * The container is sized for the longest vector the ISA supports. When an
+ * ISA runs with shorter vectors, it sets the live size of the container,
+ * see setLiveSize(). Assignments and comparisons then only touch the live
+ * bytes, so a register file is read and written at the configured vector
+ * length. The bytes past the live size keep the value they had when the
+ * container was last zeroed or copied in full.
  * @tparam Sz Size of the container in bytes.
  */
 template <size_t Sz>
@@ -282,8 +294,25 @@ class VecRegContainer
     Container container;
     using MyClass = VecRegContainer<SIZE>;
 
+    /** Bytes moved by assignments and compared by operator==. */
+    static size_t liveSize;
+    /** Whether an ISA has set liveSize. */
+    static bool liveSizeSet;
+
   public:
     VecRegContainer() {}
+    /** Copy all SIZE bytes, e.g. to take a checkpoint. */
+    VecRegContainer(const VecRegContainer& that) = default;
+    /**
+     * Copy the live bytes of another container. The other bytes are left
+     * undefined, so this is only meant for temporaries that are read at
+     * the current vector length, such as the source operands of an
+     * instruction.
+     */
+    VecRegContainer(const MyClass& that, VecRegLiveCopy)
+    {
+        std::memcpy(container.data(), that.container.data(), liveSize);
+    }
     /* This is required for de-serialisation. */
     VecRegContainer(const std::vector<uint8_t>& that)
     {
@@ -296,12 +325,12 @@ class VecRegContainer
 
     /** Assignment operators. */
     /** @{ */
-    /** From VecRegContainer */
+    /** From VecRegContainer, only the live bytes. */
     MyClass& operator=(const MyClass& that)
     {
         if (&that == this)
             return *this;
-        memcpy(container.data(), that.container.data(), SIZE);
+        memcpy(container.data(), that.container.data(), liveSize);
         return *this;
     }
 
@@ -349,7 +378,7 @@ class VecRegContainer
     operator==(const VecRegContainer<S2>& that) const
     {
         return SIZE == S2 &&
-               !memcmp(container.data(), that.container.data(), SIZE);
+               !memcmp(container.data(), that.container.data(), liveSize);
     }
     /** Inequality operator.
      * Required to compare thread contexts.
@@ -362,6 +391,23 @@ class VecRegContainer
     }
 
     const std::string print() const { return csprintf("%s", *this); }
+
+    /**
+     * Set the number of bytes assignments and comparisons move for all
+     * containers of this size. Each ISA object passes the longest vector
+     * it can use, and the largest value passed is kept, so the live size
+     * never shrinks below what a thread may access.
+     */
+    static void
+    setLiveSize(size_t bytes)
+    {
+        assert(bytes > 0 && bytes <= SIZE);
+        liveSize = liveSizeSet ? std::max(liveSize, bytes) : bytes;
+        liveSizeSet = true;
+    }
+
+    static size_t getLiveSize() { return liveSize; }
+
     /** Get pointer to bytes. */
     template <typename Ret>
     const Ret* raw_ptr() const { return (const Ret*)container.data(); }
@@ -425,6 +471,12 @@ class VecRegContainer
     }
 };
 
+template <size_t Sz>
+size_t VecRegContainer<Sz>::liveSize = Sz;
+
+template <size_t Sz>
+bool VecRegContainer<Sz>::liveSizeSet = false;
+
 /** We define an auxiliary abstraction for LaneData. The ISA should care
  * about the semantics of a, e.g., 32bit element, treating it as a signed or
  * unsigned int, or a float depending on the semantics of a particular
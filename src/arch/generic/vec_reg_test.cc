@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arch/generic/vec_reg.hh"
+
+/*
+ * The live size is shared by all containers of one size, so each test
+ * uses a size of its own.
+ */
+
+TEST(VecRegTest, FullByDefault)
+{
+    VecRegContainer<8> a, b;
+    a.as<uint8_t>()[7] = 1;
+    b.zero();
+    EXPECT_NE(a, b);
+    b = a;
+    EXPECT_EQ(8, VecRegContainer<8>::getLiveSize());
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(1, b.as<uint8_t>()[7]);
+}
+
+TEST(VecRegTest, LiveCopies)
+{
+    using Reg = VecRegContainer<64>;
+    Reg::setLiveSize(16);
+    EXPECT_EQ(16, Reg::getLiveSize());
+
+    Reg src, dst;
+    for (int i = 0; i < 64; ++i)
+        src.as<uint8_t>()[i] = i + 1;
+    dst.zero();
+
+    // Assignment moves the live bytes only and leaves the rest alone.
+    dst = src;
+    for (int i = 0; i < 64; ++i)
+        EXPECT_EQ(i < 16 ? i + 1 : 0, dst.as<uint8_t>()[i]) << i;
+
+    // Comparisons ignore the bytes past the live size.
+    EXPECT_EQ(src, dst);
+    dst.as<uint8_t>()[15] = 0;
+    EXPECT_NE(src, dst);
+
+    // So does the live copy constructor.
+    const Reg tmp(src, VecRegLiveCopy());
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(i + 1, tmp.as<uint8_t>()[i]);
+
+    // A full copy still moves everything, e.g. for checkpoints.
+    Reg full(src);
+    EXPECT_EQ(64, full.as<uint8_t>()[63]);
+    std::vector<uint8_t> bytes;
+    src.copyTo(bytes);
+    EXPECT_EQ(64, bytes.size());
+}
+
+TEST(VecRegTest, LiveSizeNeverShrinks)
+{
+    using Reg = VecRegContainer<128>;
+    Reg::setLiveSize(64);
+    Reg::setLiveSize(32);
+    EXPECT_EQ(64, Reg::getLiveSize());
+    Reg::setLiveSize(128);
+    EXPECT_EQ(128, Reg::getLiveSize());
+}
@@ -773,7 +773,9 @@ class VecRegOperand(Operand):
         if self.is_dest and self.is_src:
             name += '_merger'
 
-        c_read =  '\t\t%s tmp_s%s = xc->%s(this, %s);\n' \
+        # Only the live part of the register is copied, see
+        # VecRegContainer::setLiveSize()
+        c_read =  '\t\t%s tmp_s%s(xc->%s(this, %s), VecRegLiveCopy());\n' \
                 % ('const TheISA::VecRegContainer', rindex, func, rindex)
         # If the parser has detected that elements are being access, create
         # the appropriate view
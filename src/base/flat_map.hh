@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FLAT_MAP_HH__
+#define __BASE_FLAT_MAP_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "base/intmath.hh"
+
+/**
+ * A hash map with open addressing and linear probing. Keys and values
+ * are stored inline in a power-of-two sized table, so a lookup usually
+ * touches a single cache line instead of chasing the bucket and node
+ * pointers of std::unordered_map. The table doubles when it becomes
+ * half full.
+ *
+ * Entries cannot be erased, and references to values are invalidated
+ * when the table grows. This is what lookup caches such as the decode
+ * cache need. The interface mirrors the subset of std::unordered_map
+ * they use: iterators point at entries with first and second members.
+ *
+ * The hash is multiplied by a large odd constant and the table index
+ * is taken from the top bits, so that identity hashes of integer keys
+ * (std::hash in libstdc++) still spread over the table.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatMap
+{
+  public:
+    struct Entry
+    {
+        Key first;
+        Value second;
+        bool used;
+
+        Entry() : first(), second(), used(false) {}
+    };
+
+    typedef Entry *iterator;
+
+  private:
+    std::vector<Entry> table;
+
+    /** Shift that turns the mixed hash into a table index. */
+    unsigned shift;
+
+    /** Number of used entries. */
+    size_t count;
+
+    size_t
+    index(const Key &key) const
+    {
+        return (uint64_t(Hash()(key)) * 0x9e3779b97f4a7c15ULL) >> shift;
+    }
+
+    size_t next(size_t i) const { return (i + 1) & (table.size() - 1); }
+
+    /** Find the first unused entry on the probe sequence of key. */
+    Entry &
+    freeEntry(const Key &key)
+    {
+        size_t i = index(key);
+        while (table[i].used)
+            i = next(i);
+        return table[i];
+    }
+
+    void
+    resize(size_t entries)
+    {
+        std::vector<Entry> old(entries);
+        old.swap(table);
+        shift = 64 - floorLog2(entries);
+
+        for (auto &e : old) {
+            if (e.used)
+                freeEntry(e.first) = std::move(e);
+        }
+    }
+
+  public:
+    /**
+     * @param entries Initial number of entries in the table, rounded
+     *                up to a power of two.
+     */
+    explicit FlatMap(size_t entries = 1024)
+        : count(0)
+    {
+        size_t n = 2;
+        while (n < entries)
+            n *= 2;
+        resize(n);
+    }
+
+    iterator end() { return nullptr; }
+
+    iterator
+    find(const Key &key)
+    {
+        for (size_t i = index(key); table[i].used; i = next(i)) {
+            if (table[i].first == key)
+                return &table[i];
+        }
+        return end();
+    }
+
+    /** Find the value of key, inserting a default value if missing. */
+    Value &
+    operator[](const Key &key)
+    {
+        iterator it = find(key);
+        if (it != end())
+            return it->second;
+
+        if (2 * (count + 1) > table.size())
+            resize(2 * table.size());
+
+        Entry &e = freeEntry(key);
+        e.first = key;
+        e.used = true;
+        ++count;
+        return e.second;
+    }
+
+    size_t size() const { return count; }
+
+    bool empty() const { return count == 0; }
+
+    /** Number of entries in the table, used or not. */
+    size_t capacity() const { return table.size(); }
+};
+
+#endif // __BASE_FLAT_MAP_HH__
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "base/flat_map.hh"
+
+TEST(FlatMapTest, Empty)
+{
+    FlatMap<uint64_t, int> map(16);
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), 16u);
+    EXPECT_EQ(map.find(0), map.end());
+    EXPECT_EQ(map.find(42), map.end());
+}
+
+TEST(FlatMapTest, InsertFind)
+{
+    FlatMap<uint64_t, int> map;
+
+    map[1] = 10;
+    map[0] = 20;
+    map[~0ULL] = 30;
+
+    EXPECT_EQ(map.size(), 3u);
+    ASSERT_NE(map.find(1), map.end());
+    EXPECT_EQ(map.find(1)->second, 10);
+    EXPECT_EQ(map.find(0)->second, 20);
+    EXPECT_EQ(map.find(~0ULL)->first, ~0ULL);
+    EXPECT_EQ(map.find(~0ULL)->second, 30);
+    EXPECT_EQ(map.find(2), map.end());
+
+    // operator[] on an existing key does not insert
+    map[1] = 11;
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map[1], 11);
+}
+
+TEST(FlatMapTest, Grow)
+{
+    FlatMap<uint64_t, uint64_t> map(2);
+
+    // keys differing only in their low bits collide in an identity
+    // hashed table
+    for (uint64_t i = 0; i < 1000; i++)
+        map[i << 32] = i;
+
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_GE(map.capacity(), 2000u);
+    for (uint64_t i = 0; i < 1000; i++) {
+        ASSERT_NE(map.find(i << 32), map.end());
+        EXPECT_EQ(map.find(i << 32)->second, i);
+    }
+}
+
+TEST(FlatMapTest, MatchesUnorderedMap)
+{
+    FlatMap<uint64_t, std::string> map(4);
+    std::unordered_map<uint64_t, std::string> model;
+    std::mt19937_64 rng(1);
+
+    for (int i = 0; i < 100000; i++) {
+        uint64_t key = rng() % 5000;
+        if (rng() % 2) {
+            map[key] = std::to_string(i);
+            model[key] = std::to_string(i);
+        } else {
+            auto it = map.find(key);
+            auto model_it = model.find(key);
+            ASSERT_EQ(it == map.end(), model_it == model.end());
+            if (it != map.end()) {
+                ASSERT_EQ(it->second, model_it->second);
+            }
+        }
+    }
+    EXPECT_EQ(map.size(), model.size());
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/pool.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+BufferPool::BufferPool(size_t max_bytes, size_t chunk_bytes)
+    : maxBytes(max_bytes), chunkBytes(chunk_bytes),
+      classes(max_bytes / Granule + 1), _inUse(0), _peakInUse(0),
+      _allocations(0), _unpooled(0), _reservedBytes(0)
+{
+}
+
+BufferPool::~BufferPool()
+{
+    // Objects that outlive their pool (e.g. instructions still
+    // referenced when the simulator exits) keep their chunks alive
+    if (_inUse)
+        return;
+    for (void *chunk : chunks)
+        ::operator delete(chunk);
+}
+
+void
+BufferPool::refill(SizeClass &size_class)
+{
+    const size_t blocks =
+        std::max<size_t>(chunkBytes / size_class.blockBytes, 16);
+    const size_t bytes = blocks * size_class.blockBytes;
+    char *chunk = static_cast<char *>(::operator new(bytes));
+    chunks.push_back(chunk);
+    _reservedBytes += bytes;
+
+    for (size_t i = blocks; i-- > 0; ) {
+        void *block = chunk + i * size_class.blockBytes;
+        *static_cast<void **>(block) = size_class.freeList;
+        size_class.freeList = block;
+    }
+}
+
+void *
+BufferPool::allocate(size_t size)
+{
+    ++_allocations;
+    if (++_inUse > _peakInUse)
+        _peakInUse = _inUse;
+
+    const size_t granules = (size + Granule - 1) / Granule;
+    Header *header;
+    if (size > maxBytes) {
+        ++_unpooled;
+        header = static_cast<Header *>(
+            ::operator new(sizeof(Header) + granules * Granule));
+        header->sizeClass = nullptr;
+    } else {
+        std::unique_ptr<SizeClass> &size_class = classes[granules];
+        if (!size_class) {
+            size_class.reset(new SizeClass{
+                sizeof(Header) + granules * Granule, nullptr});
+        }
+        if (!size_class->freeList)
+            refill(*size_class);
+
+        void *block = size_class->freeList;
+        size_class->freeList = *static_cast<void **>(block);
+        header = static_cast<Header *>(block);
+        header->sizeClass = size_class.get();
+    }
+    header->pool = this;
+    return header + 1;
+}
+
+void
+BufferPool::release(void *buffer)
+{
+    if (!buffer)
+        return;
+
+    Header *header = static_cast<Header *>(buffer) - 1;
+    BufferPool *pool = header->pool;
+    assert(pool->_inUse > 0);
+    --pool->_inUse;
+
+    SizeClass *size_class = header->sizeClass;
+    if (!size_class) {
+        ::operator delete(header);
+        return;
+    }
+
+    *reinterpret_cast<void **>(header) = size_class->freeList;
+    size_class->freeList = header;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_HH__
+#define __BASE_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * A size-classed memory pool for objects that are allocated and freed
+ * at a high rate, such as the dynamic instructions of a CPU model and
+ * their data buffers. Requests are rounded up to a multiple of
+ * Granule bytes, and each size gets its own free list of blocks,
+ * carved out of larger chunks. Freed blocks are kept for reuse and
+ * only returned to the system when the pool is destroyed.
+ *
+ * Every block is preceded by a header that points to its size class,
+ * so release() needs no pool or size. Requests larger than the
+ * largest pooled size fall back to operator new.
+ *
+ * A pool is not thread safe. It is meant to be owned by one simulated
+ * object and used from the event queue that object runs on.
+ */
+class BufferPool
+{
+  public:
+    /** Size granularity and alignment of the returned buffers. */
+    static constexpr size_t Granule = 16;
+
+    /**
+     * @param max_bytes The largest request served from the pool.
+     * @param chunk_bytes The number of bytes reserved at once for a
+     *                    size class.
+     */
+    BufferPool(size_t max_bytes = 4096, size_t chunk_bytes = 64 * 1024);
+    ~BufferPool();
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    /** Allocate a buffer of at least size bytes. */
+    void *allocate(size_t size);
+
+    /** Free a buffer returned by allocate() on any pool. */
+    static void release(void *buffer);
+
+    /** Number of buffers currently allocated. */
+    uint64_t inUse() const { return _inUse; }
+    /** Largest number of buffers allocated at the same time. */
+    uint64_t peakInUse() const { return _peakInUse; }
+    /** Total number of allocations. */
+    uint64_t allocations() const { return _allocations; }
+    /** Number of allocations that were too large for the pool. */
+    uint64_t unpooled() const { return _unpooled; }
+    /** Bytes reserved from the system for pooled buffers. */
+    uint64_t reservedBytes() const { return _reservedBytes; }
+
+  private:
+    struct SizeClass
+    {
+        /** Block size, including the header. */
+        size_t blockBytes;
+        /** Free blocks, linked through their first word. */
+        void *freeList;
+    };
+
+    /** Precedes every buffer, keeps the buffer aligned to Granule. */
+    struct alignas(Granule) Header
+    {
+        BufferPool *pool;
+        /** Owning size class, null for unpooled buffers. */
+        SizeClass *sizeClass;
+    };
+
+    void refill(SizeClass &size_class);
+
+    const size_t maxBytes;
+    const size_t chunkBytes;
+
+    /** Size classes by size in granules, created on first use. */
+    std::vector<std::unique_ptr<SizeClass>> classes;
+    std::vector<void *> chunks;
+
+    uint64_t _inUse;
+    uint64_t _peakInUse;
+    uint64_t _allocations;
+    uint64_t _unpooled;
+    uint64_t _reservedBytes;
+};
+
+#endif // __BASE_POOL_HH__
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "base/pool.hh"
+
+TEST(PoolTest, Alignment)
+{
+    BufferPool pool(256);
+
+    for (size_t size = 1; size <= 512; size += 7) {
+        void *p = pool.allocate(size);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % BufferPool::Granule, 0);
+        memset(p, 0xa5, size);
+        BufferPool::release(p);
+    }
+    EXPECT_EQ(pool.inUse(), 0);
+}
+
+TEST(PoolTest, Reuse)
+{
+    BufferPool pool;
+
+    void *a = pool.allocate(64);
+    BufferPool::release(a);
+    void *b = pool.allocate(60);
+    EXPECT_EQ(a, b);
+
+    // a different size class does not get the same block
+    void *c = pool.allocate(200);
+    EXPECT_NE(b, c);
+    BufferPool::release(b);
+    BufferPool::release(c);
+}
+
+TEST(PoolTest, Occupancy)
+{
+    BufferPool pool(1024, 4096);
+    std::vector<void *> buffers;
+
+    for (int i = 0; i < 1000; ++i)
+        buffers.push_back(pool.allocate(i % 2 ? 48 : 2000));
+
+    EXPECT_EQ(pool.inUse(), 1000);
+    EXPECT_EQ(pool.peakInUse(), 1000);
+    EXPECT_EQ(pool.allocations(), 1000);
+    EXPECT_EQ(pool.unpooled(), 500);
+    EXPECT_GE(pool.reservedBytes(), 500 * 48);
+
+    for (size_t i = 0; i < buffers.size(); i += 2)
+        BufferPool::release(buffers[i]);
+    EXPECT_EQ(pool.inUse(), 500);
+
+    const uint64_t reserved = pool.reservedBytes();
+    for (int i = 0; i < 500; ++i)
+        buffers[2 * i] = pool.allocate(48);
+    // the freed blocks cover the new requests, except for the
+    // unpooled ones which were returned to the system
+    EXPECT_EQ(pool.peakInUse(), 1000);
+
+    for (void *p : buffers)
+        BufferPool::release(p);
+    EXPECT_EQ(pool.inUse(), 0);
+    EXPECT_GE(pool.reservedBytes(), reserved);
+}
+
+TEST(PoolTest, TwoPools)
+{
+    BufferPool a, b;
+
+    void *p = a.allocate(32);
+    void *q = b.allocate(32);
+    EXPECT_EQ(a.inUse(), 1);
+    EXPECT_EQ(b.inUse(), 1);
+
+    BufferPool::release(q);
+    EXPECT_EQ(a.inUse(), 1);
+    EXPECT_EQ(b.inUse(), 0);
+    BufferPool::release(p);
+    EXPECT_EQ(a.inUse(), 0);
+
+    BufferPool::release(nullptr);
+}
@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+
+using namespace std;
+
+namespace Stats {
+
+namespace {
+
+const char magic[] = "gem5stat";
+const uint32_t version = 1;
+
+template <class T>
+void
+put(std::vector<char> &buf, T value)
+{
+    value = htole(value);
+    const char *p = reinterpret_cast<const char *>(&value);
+    buf.insert(buf.end(), p, p + sizeof(value));
+}
+
+uint64_t
+bits(Result value)
+{
+    uint64_t b;
+    memcpy(&b, &value, sizeof(b));
+    return b;
+}
+
+} // anonymous namespace
+
+Binary::Binary()
+    : mystream(false), stream(NULL), schemaWritten(false)
+{
+}
+
+Binary::Binary(const std::string &file)
+    : mystream(false), stream(NULL), schemaWritten(false)
+{
+    open(file);
+}
+
+Binary::~Binary()
+{
+    if (mystream) {
+        assert(stream);
+        delete stream;
+    }
+}
+
+void
+Binary::open(std::ostream &_stream)
+{
+    if (stream)
+        panic("stream already set!");
+
+    mystream = false;
+    stream = &_stream;
+    if (!valid())
+        fatal("Unable to open output stream for writing\n");
+}
+
+void
+Binary::open(const std::string &file)
+{
+    if (stream)
+        panic("stream already set!");
+
+    mystream = true;
+    stream = new ofstream(file.c_str(), ios::trunc | ios::binary);
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+}
+
+bool
+Binary::valid() const
+{
+    return stream != NULL && stream->good();
+}
+
+void
+Binary::begin()
+{
+    values.clear();
+}
+
+void
+Binary::writeSchema()
+{
+    record.clear();
+    record.insert(record.end(), magic, magic + sizeof(magic) - 1);
+    put<uint32_t>(record, version);
+
+    record.push_back('S');
+    put<uint32_t>(record, names.size());
+    for (const auto &name : names) {
+        put<uint32_t>(record, name.size());
+        record.insert(record.end(), name.begin(), name.end());
+    }
+    stream->write(record.data(), record.size());
+
+    // The names are not needed anymore
+    std::vector<std::string>().swap(names);
+    schemaWritten = true;
+}
+
+void
+Binary::end()
+{
+    if (!schemaWritten) {
+        assert(names.size() == values.size());
+        writeSchema();
+    }
+
+    size_t columns = values.size();
+    panic_if(!last.empty() && last.size() != columns,
+             "Number of statistics changed from %d to %d between dumps\n",
+             last.size(), columns);
+
+    record.clear();
+    record.push_back('D');
+    put<uint64_t>(record, curTick());
+
+    size_t mask = record.size();
+    record.resize(mask + (columns + 7) / 8, 0);
+    for (size_t i = 0; i < columns; ++i) {
+        uint64_t b = bits(values[i]);
+        if (last.empty() || b != bits(last[i])) {
+            record[mask + i / 8] |= 1 << (i % 8);
+            put<uint64_t>(record, b);
+        }
+    }
+
+    stream->write(record.data(), record.size());
+    stream->flush();
+
+    last.swap(values);
+}
+
+bool
+Binary::noOutput(const Info &info)
+{
+    // Unlike the text output, stats with a zero prerequisite are kept
+    // so that every dump has the same columns.
+    return !info.flags.isSet(display);
+}
+
+void
+Binary::vectorColumns(const string &name, const string &sep,
+                      const std::vector<string> &subnames, const VResult &vec,
+                      bool print_total, Result total, bool force_subnames)
+{
+    size_type size = vec.size();
+
+    bool havesub = false;
+    for (const auto &subname : subnames)
+        havesub = havesub || !subname.empty();
+
+    string base = name + sep;
+
+    if (size == 1) {
+        if (naming()) {
+            names.push_back(!force_subnames ? name :
+                base + (havesub ? subnames[0] : std::to_string(0)));
+        }
+        column(vec[0]);
+        return;
+    }
+
+    for (off_type i = 0; i < size; ++i) {
+        if (havesub && (i >= subnames.size() || subnames[i].empty()))
+            continue;
+
+        if (naming())
+            names.push_back(base +
+                (havesub ? subnames[i] : std::to_string(i)));
+        column(vec[i]);
+    }
+
+    if (print_total) {
+        if (naming())
+            names.push_back(base + "total");
+        column(total);
+    }
+}
+
+void
+Binary::distColumns(const string &name, const DistData &data)
+{
+    string base = name + Info::separatorString;
+
+    if (naming()) {
+        names.push_back(base + "samples");
+        names.push_back(base + "mean");
+        if (data.type == Hist)
+            names.push_back(base + "gmean");
+        names.push_back(base + "stdev");
+    }
+
+    column(data.samples);
+    column(data.samples ? data.sum / data.samples : NAN);
+    if (data.type == Hist)
+        column(data.samples ? exp(data.logs / data.samples) : NAN);
+
+    Result stdev = NAN;
+    if (data.samples)
+        stdev = sqrt((data.samples * data.squares - data.sum * data.sum) /
+                     (data.samples * (data.samples - 1.0)));
+    column(stdev);
+
+    if (data.type == Deviation)
+        return;
+
+    size_t size = data.cvec.size();
+
+    Result total = 0.0;
+    if (data.type == Dist)
+        total += data.underflow;
+    for (off_type i = 0; i < size; ++i)
+        total += data.cvec[i];
+    if (data.type == Dist)
+        total += data.overflow;
+
+    if (data.type == Dist) {
+        if (naming())
+            names.push_back(base + "underflows");
+        column(data.underflow);
+    }
+
+    // A histogram widens its buckets as its samples grow, so its
+    // buckets are named by index and their range is a column too.
+    if (data.type == Hist) {
+        if (naming()) {
+            names.push_back(base + "bucket_min");
+            names.push_back(base + "bucket_size");
+        }
+        column(data.min);
+        column(data.bucket_size);
+    }
+
+    for (off_type i = 0; i < size; ++i) {
+        if (naming() && data.type == Hist) {
+            names.push_back(base + "bucket" + std::to_string(i));
+        } else if (naming()) {
+            stringstream namestr;
+            namestr << base;
+
+            Counter low = i * data.bucket_size + data.min;
+            Counter high = ::min(low + data.bucket_size - 1.0, data.max);
+            namestr << low;
+            if (low < high)
+                namestr << "-" << high;
+            names.push_back(namestr.str());
+        }
+        column(data.cvec[i]);
+    }
+
+    if (data.type == Dist) {
+        if (naming()) {
+            names.push_back(base + "overflows");
+            names.push_back(base + "min_value");
+            names.push_back(base + "max_value");
+        }
+        column(data.overflow);
+        column(data.min_val);
+        column(data.max_val);
+    }
+
+    if (naming())
+        names.push_back(base + "total");
+    column(total);
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (naming())
+        names.push_back(info.name);
+    column(info.result());
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    vectorColumns(info.name, info.separatorString, info.subnames,
+                  info.result(), info.flags.isSet(total), info.total(),
+                  false);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    bool havesub = false;
+    for (const auto &subname : info.subnames)
+        havesub = havesub || !subname.empty();
+
+    bool print_total = info.flags.isSet(total);
+    VResult yvec(info.y);
+
+    for (off_type i = 0; i < info.x; ++i) {
+        if (havesub && (i >= info.subnames.size() || info.subnames[i].empty()))
+            continue;
+
+        off_type iy = i * info.y;
+        Result row_total = 0.0;
+        for (off_type j = 0; j < info.y; ++j) {
+            yvec[j] = info.cvec[iy + j];
+            row_total += yvec[j];
+        }
+
+        vectorColumns(info.name + "_" +
+                      (havesub ? info.subnames[i] : std::to_string(i)),
+                      info.separatorString, info.y_subnames, yvec,
+                      print_total, row_total, true);
+    }
+
+    if (print_total && info.x > 1) {
+        if (naming())
+            names.push_back(info.name + info.separatorString + "total");
+        column(info.total());
+    }
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    distColumns(info.name, info.data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    for (off_type i = 0; i < info.size(); ++i) {
+        distColumns(info.name + "_" +
+                    (info.subnames[i].empty() ?
+                     std::to_string(i) : info.subnames[i]),
+                    info.data[i]);
+    }
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    // The buckets of a sparse histogram change from dump to dump, so
+    // only the number of samples fits in a fixed set of columns.
+    if (naming())
+        names.push_back(info.name + info.separatorString + "samples");
+    column(info.data.samples);
+}
+
+Output *
+initBinary(const string &filename)
+{
+    static Binary binary;
+    static bool connected = false;
+
+    if (!connected) {
+        binary.open(*simout.findOrCreate(filename, true)->stream());
+        connected = true;
+    }
+
+    return &binary;
+}
+
+} // namespace Stats
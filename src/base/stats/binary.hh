@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+#include "base/output.hh"
+
+namespace Stats {
+
+struct DistData;
+
+/**
+ * Columnar binary statistics output.
+ *
+ * Every value the text output would print for a dump becomes a column.
+ * The column names are written once, at the first dump, and every dump
+ * then appends one record holding only the columns whose value changed
+ * since the previous dump. The layout (all integers and values are
+ * little-endian) is:
+ *
+ *   "gem5stat" u32:version
+ *   'S' u32:columns { u32:length char[length]:name }*
+ *   'D' u64:tick u8[(columns + 7) / 8]:changed { f64:value }*
+ *   'D' ...
+ *
+ * The buckets of a histogram (Stats::Histogram) are named by index,
+ * as their range grows with the samples; the bucket_min and
+ * bucket_size columns give the range at each dump.
+ *
+ * util/binstats.py reads the file back into per-stat time series.
+ */
+class Binary : public Output
+{
+  protected:
+    bool mystream;
+    std::ostream *stream;
+
+    /** Column names, only gathered while writing the schema */
+    std::vector<std::string> names;
+    bool schemaWritten;
+
+    /** Values of the current and the previous dump */
+    std::vector<Result> values;
+    std::vector<Result> last;
+
+    /** Scratch buffer for a dump record */
+    std::vector<char> record;
+
+  protected:
+    bool noOutput(const Info &info);
+
+    bool naming() const { return !schemaWritten; }
+    void column(Result value) { values.push_back(value); }
+
+    void vectorColumns(const std::string &name, const std::string &sep,
+                       const std::vector<std::string> &subnames,
+                       const VResult &vec, bool print_total, Result total,
+                       bool force_subnames);
+    void distColumns(const std::string &name, const DistData &data);
+
+    void writeSchema();
+
+  public:
+    Binary();
+    Binary(const std::string &file);
+    ~Binary();
+
+    void open(std::ostream &stream);
+    void open(const std::string &file);
+
+    // Implement Visit
+    virtual void visit(const ScalarInfo &info);
+    virtual void visit(const VectorInfo &info);
+    virtual void visit(const DistInfo &info);
+    virtual void visit(const VectorDistInfo &info);
+    virtual void visit(const Vector2dInfo &info);
+    virtual void visit(const FormulaInfo &info);
+    virtual void visit(const SparseHistInfo &info);
+
+    // Implement Output
+    virtual bool valid() const;
+    virtual void begin();
+    virtual void end();
+};
+
+Output *initBinary(const std::string &filename);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -41,6 +41,7 @@
 #include <sstream>
 #include <string>
 
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/logging.hh"
 #include "base/output.hh"
@@ -157,4 +158,23 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     stream.flush();
 }
 
+BinaryLogger::BinaryLogger(std::ostream &stream_)
+    : trace(stream_)
+{
+    binary = &trace;
+    // Loggers are never deleted, so write the last records at exit
+    registerExitCallback(
+        new MakeCallback<BinaryTrace, &BinaryTrace::close>(&trace));
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+                         const std::string &message)
+{
+    if (!name.empty() && ignore.match(name))
+        return;
+
+    trace.recordText(when, name, message);
+}
+
 } // namespace Trace
@@ -41,6 +41,7 @@
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
+#include "base/trace_binary.hh"
 #include "base/types.hh"
 #include "sim/core.hh"
 
@@ -54,6 +55,9 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Record messages unformatted in this trace if not null */
+    BinaryTrace *binary = nullptr;
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -63,6 +67,11 @@ class Logger
         if (!name.empty() && ignore.match(name))
             return;
 
+        if (binary) {
+            binary->record(when, name, fmt, args...);
+            return;
+        }
+
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, line.str());
@@ -106,6 +115,22 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger recording messages in a binary trace, see
+ *  base/trace_binary.hh */
+class BinaryLogger : public Logger
+{
+  protected:
+    BinaryTrace trace;
+
+  public:
+    BinaryLogger(std::ostream &stream_);
+
+    void logMessage(Tick when, const std::string &name,
+                    const std::string &message) override;
+
+    std::ostream &getOstream() override { return trace.rawStream(); }
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
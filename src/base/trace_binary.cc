@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_binary.hh"
+
+#include <algorithm>
+#include <istream>
+#include <stdexcept>
+#include <tuple>
+
+
+namespace Trace {
+
+static const char magic[] = "gem5dbgt";
+static const uint32_t version = 1;
+
+__thread BinaryTrace::ThreadState *BinaryTrace::threadState = nullptr;
+__thread uint64_t BinaryTrace::threadTrace = 0;
+std::atomic<uint64_t> BinaryTrace::nextTrace(1);
+
+/** Records what a thread writes to the ostream of the logger. */
+class BinaryTrace::RawBuf : public std::stringbuf
+{
+  private:
+    BinaryTrace &trace;
+    ThreadState &state;
+
+  protected:
+    int
+    sync() override
+    {
+        const std::string text = str();
+        if (!text.empty()) {
+            std::string &rec = state.record;
+            rec.clear();
+            rec += 'R';
+            put(rec, uint32_t(text.size()));
+            rec += text;
+            trace.commit(state);
+            str("");
+        }
+        return 0;
+    }
+
+  public:
+    RawBuf(BinaryTrace &_trace, ThreadState &_state)
+        : trace(_trace), state(_state)
+    {}
+};
+
+BinaryTrace::BinaryTrace(std::ostream &_stream, size_t chunk_size,
+                         size_t max_chunks)
+    : traceNumber(nextTrace++), stream(_stream), chunkSize(chunk_size), maxChunks(max_chunks),
+      closing(false)
+{
+    stream.write(magic, sizeof(magic) - 1);
+    stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    writer = std::thread([this]() { writeChunks(); });
+}
+
+BinaryTrace::~BinaryTrace()
+{
+    close();
+}
+
+BinaryTrace::ThreadState &
+BinaryTrace::attach()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    threads.emplace_back(new ThreadState());
+    ThreadState &state = *threads.back();
+    state.id = threads.size() - 1;
+    state.chunk = closing ? nullptr : takeChunk(lock);
+    threadState = &state;
+    threadTrace = traceNumber;
+    return state;
+}
+
+BinaryTrace::Chunk *
+BinaryTrace::takeChunk(std::unique_lock<std::mutex> &lock)
+{
+    if (freeChunks.empty() && chunks.size() < maxChunks) {
+        chunks.emplace_back(new Chunk());
+        chunks.back()->data.resize(chunkSize);
+        chunks.back()->used = 0;
+        return chunks.back().get();
+    }
+
+    chunkFree.wait(lock, [this]() { return !freeChunks.empty(); });
+    Chunk *chunk = freeChunks.back();
+    freeChunks.pop_back();
+    return chunk;
+}
+
+void
+BinaryTrace::swapChunk(ThreadState &state, size_t size)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!state.chunk)
+        return;
+
+    if (state.chunk->used) {
+        state.chunk->thread = state.id;
+        fullChunks.push_back(state.chunk);
+        chunkFull.notify_one();
+        state.chunk = takeChunk(lock);
+    }
+    if (state.chunk->data.size() < size)
+        state.chunk->data.resize(size);
+}
+
+void
+BinaryTrace::writeChunks()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        chunkFull.wait(lock, [this]() {
+            return !fullChunks.empty() || closing; });
+        if (fullChunks.empty())
+            break;
+
+        Chunk *chunk = fullChunks.front();
+        fullChunks.pop_front();
+        lock.unlock();
+
+        uint32_t header[2] = { chunk->thread, uint32_t(chunk->used) };
+        stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+        stream.write(chunk->data.data(), chunk->used);
+
+        lock.lock();
+        chunk->used = 0;
+        freeChunks.push_back(chunk);
+        chunkFree.notify_one();
+    }
+}
+
+uint32_t
+BinaryTrace::defineFormat(ThreadState &state, const char *fmt)
+{
+    uint32_t id = state.formats.size();
+    state.formats.emplace_back(fmt);
+    state.formatIds[fmt] = id;
+
+    std::string &rec = state.record;
+    rec.clear();
+    rec += 'F';
+    put(rec, id);
+    put(rec, uint32_t(state.formats.back().size()));
+    rec += state.formats.back();
+    commit(state);
+    return id;
+}
+
+uint32_t
+BinaryTrace::defineName(ThreadState &state, const std::string &name)
+{
+    uint32_t id = state.nameIds.size();
+    state.nameIds.emplace(name, id);
+
+    std::string &rec = state.record;
+    rec.clear();
+    rec += 'N';
+    put(rec, id);
+    put(rec, uint32_t(name.size()));
+    rec += name;
+    commit(state);
+    return id;
+}
+
+void
+BinaryTrace::recordText(Tick when, const std::string &name,
+                        const std::string &message)
+{
+    ThreadState &s = state();
+    uint32_t name_id = nameId(s, name);
+
+    std::string &rec = s.record;
+    rec.clear();
+    rec += 'S';
+    put(rec, uint64_t(when));
+    put(rec, name_id);
+    put(rec, uint32_t(message.size()));
+    rec += message;
+    commit(s);
+}
+
+std::ostream &
+BinaryTrace::rawStream()
+{
+    ThreadState &s = state();
+    if (!s.rawStream) {
+        s.rawBuf.reset(new RawBuf(*this, s));
+        s.rawStream.reset(new std::ostream(s.rawBuf.get()));
+    }
+    return *s.rawStream;
+}
+
+void
+BinaryTrace::close()
+{
+    if (!writer.joinable())
+        return;
+
+    // Other threads no longer record at this point
+    for (auto &state : threads) {
+        if (state->rawBuf)
+            state->rawBuf->pubsync();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &state : threads) {
+            if (state->chunk && state->chunk->used) {
+                state->chunk->thread = state->id;
+                fullChunks.push_back(state->chunk);
+            }
+            state->chunk = nullptr;
+        }
+        closing = true;
+        chunkFull.notify_one();
+    }
+
+    writer.join();
+    stream.flush();
+}
+
+namespace {
+
+/** Reads the records of one chunk. */
+class RecordReader
+{
+  private:
+    const char *ptr;
+    const char *end;
+
+  public:
+    RecordReader(const std::vector<char> &data)
+        : ptr(data.data()), end(data.data() + data.size())
+    {}
+
+    bool done() const { return ptr == end; }
+
+    template <class T>
+    T
+    get()
+    {
+        if (end - ptr < (ptrdiff_t)sizeof(T))
+            throw std::out_of_range("truncated record");
+        T v;
+        memcpy(&v, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return v;
+    }
+
+    std::string
+    getString()
+    {
+        uint32_t len = get<uint32_t>();
+        if (uint32_t(end - ptr) < len)
+            throw std::out_of_range("truncated record");
+        std::string s(ptr, len);
+        ptr += len;
+        return s;
+    }
+};
+
+/** Dictionaries of a thread and the fate of its last timed record. */
+struct ThreadDecoder
+{
+    std::vector<std::string> formats;
+    std::vector<std::string> names;
+    Tick lastTick = 0;
+    bool lastShown = true;
+};
+
+void
+setString(std::vector<std::string> &table, uint32_t id, std::string s)
+{
+    if (table.size() <= id)
+        table.resize(id + 1);
+    table[id] = std::move(s);
+}
+
+const std::string &
+lookup(const std::vector<std::string> &table, uint32_t id)
+{
+    static const std::string none;
+    if (id == BinaryTrace::NoName)
+        return none;
+    if (id >= table.size())
+        throw std::out_of_range("undefined string id");
+    return table[id];
+}
+
+/** Add an argument to a cprintf with its original type. */
+void
+addArg(cp::Print &print, RecordReader &reader)
+{
+    auto type = BinaryArgType(reader.get<uint8_t>());
+    if (type == BinaryArgType::String) {
+        print.add_arg(reader.getString());
+        return;
+    }
+    if (type == BinaryArgType::Float) {
+        print.add_arg(reader.get<float>());
+        return;
+    }
+    if (type == BinaryArgType::Double) {
+        print.add_arg(reader.get<double>());
+        return;
+    }
+
+    int64_t v = reader.get<int64_t>();
+    switch (type) {
+      case BinaryArgType::Bool: print.add_arg(bool(v)); break;
+      case BinaryArgType::Char: print.add_arg(char(v)); break;
+      case BinaryArgType::SignedChar: print.add_arg((signed char)v); break;
+      case BinaryArgType::UnsignedChar: print.add_arg((unsigned char)v); break;
+      case BinaryArgType::Short: print.add_arg(short(v)); break;
+      case BinaryArgType::UnsignedShort:
+        print.add_arg((unsigned short)v);
+        break;
+      case BinaryArgType::Int: print.add_arg(int(v)); break;
+      case BinaryArgType::UnsignedInt: print.add_arg((unsigned int)v); break;
+      case BinaryArgType::Long: print.add_arg(long(v)); break;
+      case BinaryArgType::UnsignedLong: print.add_arg((unsigned long)v); break;
+      case BinaryArgType::LongLong: print.add_arg((long long)v); break;
+      case BinaryArgType::UnsignedLongLong:
+        print.add_arg((unsigned long long)v);
+        break;
+      case BinaryArgType::Pointer:
+        print.add_arg((const void *)uintptr_t(v));
+        break;
+      default:
+        throw std::out_of_range("bad argument type");
+    }
+}
+
+} // anonymous namespace
+
+bool
+decodeBinaryTrace(std::istream &in, std::ostream &out,
+                  const BinaryTraceFilter &filter)
+{
+    char file_magic[sizeof(magic) - 1];
+    uint32_t file_version;
+    in.read(file_magic, sizeof(file_magic));
+    in.read(reinterpret_cast<char *>(&file_version), sizeof(file_version));
+    if (!in || memcmp(file_magic, magic, sizeof(file_magic)) ||
+        file_version != version) {
+        return false;
+    }
+
+    ObjectMatch names(filter.names);
+    std::vector<ThreadDecoder> threads;
+    // Tick, sequence and text of each line, when sorting
+    std::vector<std::tuple<Tick, size_t, std::string>> lines;
+    std::vector<char> data;
+
+    try {
+        uint32_t header[2];
+        while (in.read(reinterpret_cast<char *>(header), sizeof(header))) {
+            data.resize(header[1]);
+            if (!in.read(data.data(), data.size()))
+                return false;
+            if (threads.size() <= header[0])
+                threads.resize(header[0] + 1);
+            ThreadDecoder &thread = threads[header[0]];
+
+            RecordReader reader(data);
+            while (!reader.done()) {
+                char type = reader.get<char>();
+                if (type == 'F' || type == 'N') {
+                    uint32_t id = reader.get<uint32_t>();
+                    setString(type == 'F' ? thread.formats : thread.names, id,
+                              reader.getString());
+                    continue;
+                }
+
+                Tick when = MaxTick;
+                std::string name;
+                std::ostringstream line;
+                if (type == 'R') {
+                    line << reader.getString();
+                } else if (type == 'S' || type == 'M') {
+                    when = reader.get<uint64_t>();
+                    name = lookup(thread.names, reader.get<uint32_t>());
+                    if (when != MaxTick)
+                        ccprintf(line, "%7d: ", when);
+                    if (!name.empty())
+                        line << name << ": ";
+
+                    if (type == 'S') {
+                        line << reader.getString();
+                    } else {
+                        const std::string &fmt =
+                            lookup(thread.formats, reader.get<uint32_t>());
+                        int count = reader.get<uint8_t>();
+                        cp::Print print(line, fmt);
+                        for (int i = 0; i < count; i++)
+                            addArg(print, reader);
+                        print.end_args();
+                    }
+                } else {
+                    return false;
+                }
+
+                // Untimed records belong to the last timed record
+                if (when != MaxTick) {
+                    thread.lastTick = when;
+                    thread.lastShown = when >= filter.start &&
+                        when <= filter.end &&
+                        (filter.names.empty() || names.match(name));
+                }
+                if (!thread.lastShown)
+                    continue;
+
+                if (filter.sort) {
+                    lines.emplace_back(thread.lastTick, lines.size(),
+                                       line.str());
+                } else {
+                    out << line.str();
+                }
+            }
+        }
+    } catch (const std::out_of_range &) {
+        return false;
+    }
+
+    if (filter.sort) {
+        std::sort(lines.begin(), lines.end());
+        for (auto &line : lines)
+            out << std::get<2>(line);
+    }
+    out.flush();
+    return true;
+}
+
+} // namespace Trace
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Binary debug trace.
+ *
+ * Instead of formatting each DPRINTF, the binary trace records its
+ * tick, object name, format string and raw arguments. Names and format
+ * strings are written once and then referred to by an id. Each thread
+ * appends records to its own chunk of memory, and a background thread
+ * writes full chunks to the file. decodeBinaryTrace() renders the
+ * records offline with the same cprintf code as the text trace.
+ *
+ * File layout, in host byte order:
+ *   "gem5dbgt", u32 version
+ *   chunks: u32 thread, u32 length, records of that thread
+ * Records:
+ *   'F'/'N' u32 id, u32 length, format string / object name
+ *   'M' u64 tick, u32 name id, u32 format id, u8 count, arguments
+ *       (u8 ArgType, then 8 bytes, 4 for floats, or u32 length and
+ *       bytes for strings)
+ *   'S' u64 tick, u32 name id, u32 length, message formatted at run
+ *       time (arguments without a raw encoding, DDUMP)
+ *   'R' u32 length, text written to the logger's ostream (Exec)
+ */
+
+#ifndef __BASE_TRACE_BINARY_HH__
+#define __BASE_TRACE_BINARY_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/match.hh"
+#include "base/types.hh"
+
+namespace Trace {
+
+/** Type of an argument recorded raw. */
+enum class BinaryArgType : uint8_t {
+    Bool, Char, SignedChar, UnsignedChar, Short, UnsignedShort,
+    Int, UnsignedInt, Long, UnsignedLong, LongLong, UnsignedLongLong,
+    Float, Double, String, Pointer
+};
+
+/**
+ * Argument types the binary trace records raw. Messages with any
+ * other argument (enums, classes with an operator<<) are formatted at
+ * run time, as the decoder could not print them.
+ */
+template <class T>
+struct BinaryArg { static const bool raw = false; };
+
+#define BINARY_TRACE_ARG(T, TYPE)                                         \
+template <>                                                               \
+struct BinaryArg<T>                                                       \
+{                                                                         \
+    static const bool raw = true;                                         \
+    static const BinaryArgType type = BinaryArgType::TYPE;                \
+}
+
+BINARY_TRACE_ARG(bool, Bool);
+BINARY_TRACE_ARG(char, Char);
+BINARY_TRACE_ARG(signed char, SignedChar);
+BINARY_TRACE_ARG(unsigned char, UnsignedChar);
+BINARY_TRACE_ARG(short, Short);
+BINARY_TRACE_ARG(unsigned short, UnsignedShort);
+BINARY_TRACE_ARG(int, Int);
+BINARY_TRACE_ARG(unsigned int, UnsignedInt);
+BINARY_TRACE_ARG(long, Long);
+BINARY_TRACE_ARG(unsigned long, UnsignedLong);
+BINARY_TRACE_ARG(long long, LongLong);
+BINARY_TRACE_ARG(unsigned long long, UnsignedLongLong);
+BINARY_TRACE_ARG(float, Float);
+BINARY_TRACE_ARG(double, Double);
+BINARY_TRACE_ARG(std::string, String);
+BINARY_TRACE_ARG(char *, String);
+BINARY_TRACE_ARG(const char *, String);
+
+#undef BINARY_TRACE_ARG
+
+template <size_t N>
+struct BinaryArg<char[N]> : public BinaryArg<const char *> {};
+
+template <size_t N>
+struct BinaryArg<const char[N]> : public BinaryArg<const char *> {};
+
+template <class T>
+struct BinaryArg<T *>
+{
+    // An ostream prints these as strings, not addresses
+    static const bool raw = !std::is_same<T, signed char>::value &&
+        !std::is_same<T, unsigned char>::value &&
+        !std::is_same<T, const signed char>::value &&
+        !std::is_same<T, const unsigned char>::value;
+    static const BinaryArgType type = BinaryArgType::Pointer;
+};
+
+template <class ...Args>
+struct BinaryArgs { static const bool raw = true; };
+
+template <class T, class ...Args>
+struct BinaryArgs<T, Args...>
+{
+    static const bool raw = BinaryArg<T>::raw && BinaryArgs<Args...>::raw;
+};
+
+class BinaryTrace
+{
+  public:
+    static const uint32_t NoName = ~uint32_t(0);
+
+  private:
+    struct Chunk
+    {
+        std::vector<char> data;
+        size_t used;
+        uint32_t thread;
+    };
+
+    class RawBuf;
+
+    /** Recording state of a thread. */
+    struct ThreadState
+    {
+        uint32_t id;
+        Chunk *chunk;
+        /** The record being built. */
+        std::string record;
+        /** Id of each format string pointer, with a copy to check it. */
+        std::unordered_map<const char *, uint32_t> formatIds;
+        std::vector<std::string> formats;
+        std::unordered_map<std::string, uint32_t> nameIds;
+        std::unique_ptr<RawBuf> rawBuf;
+        std::unique_ptr<std::ostream> rawStream;
+    };
+
+    /**
+     * State of the calling thread in the trace numbered threadTrace.
+     * The pointer dangles once that trace is destroyed, so it is only
+     * used if the number matches. Numbers are never reused.
+     */
+    static __thread ThreadState *threadState;
+    static __thread uint64_t threadTrace;
+    static std::atomic<uint64_t> nextTrace;
+
+    /** Number of this trace, to match threadTrace against. */
+    const uint64_t traceNumber;
+
+    std::ostream &stream;
+    const size_t chunkSize;
+    const size_t maxChunks;
+
+    std::mutex mutex;
+    std::condition_variable chunkFull;
+    std::condition_variable chunkFree;
+    std::vector<std::unique_ptr<ThreadState>> threads;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<Chunk *> freeChunks;
+    std::deque<Chunk *> fullChunks;
+    bool closing;
+    std::thread writer;
+
+    ThreadState &attach();
+    Chunk *takeChunk(std::unique_lock<std::mutex> &lock);
+    void swapChunk(ThreadState &state, size_t size);
+    void writeChunks();
+
+    uint32_t defineFormat(ThreadState &state, const char *fmt);
+    uint32_t defineName(ThreadState &state, const std::string &name);
+
+    ThreadState &
+    state()
+    {
+        return threadTrace == traceNumber ? *threadState : attach();
+    }
+
+    uint32_t
+    formatId(ThreadState &state, const char *fmt)
+    {
+        auto it = state.formatIds.find(fmt);
+        // The same pointer may hold another format if it is not a literal
+        if (it != state.formatIds.end() &&
+            !strcmp(state.formats[it->second].c_str(), fmt)) {
+            return it->second;
+        }
+        return defineFormat(state, fmt);
+    }
+
+    uint32_t
+    nameId(ThreadState &state, const std::string &name)
+    {
+        if (name.empty())
+            return NoName;
+        auto it = state.nameIds.find(name);
+        return it != state.nameIds.end() ? it->second :
+            defineName(state, name);
+    }
+
+    template <class T>
+    static void
+    put(std::string &rec, const T &v)
+    {
+        rec.append(reinterpret_cast<const char *>(&v), sizeof(v));
+    }
+
+    static void
+    putString(std::string &rec, const char *s, size_t len)
+    {
+        rec += char(BinaryArgType::String);
+        put(rec, uint32_t(len));
+        rec.append(s, len);
+    }
+
+    template <class T>
+    static typename std::enable_if<std::is_integral<T>::value>::type
+    putArg(std::string &rec, const T &v)
+    {
+        rec += char(BinaryArg<T>::type);
+        put(rec, int64_t(v));
+    }
+
+    static void
+    putArg(std::string &rec, const float &v)
+    {
+        rec += char(BinaryArgType::Float);
+        put(rec, v);
+    }
+
+    static void
+    putArg(std::string &rec, const double &v)
+    {
+        rec += char(BinaryArgType::Double);
+        put(rec, v);
+    }
+
+    static void
+    putArg(std::string &rec, const std::string &s)
+    {
+        putString(rec, s.data(), s.size());
+    }
+
+    static void
+    putArg(std::string &rec, const char *s)
+    {
+        putString(rec, s, strlen(s));
+    }
+
+    template <class T>
+    static void
+    putArg(std::string &rec, const T *p)
+    {
+        rec += char(BinaryArgType::Pointer);
+        put(rec, uint64_t(uintptr_t(p)));
+    }
+
+    /** Append the record being built to the chunk of the thread. */
+    void
+    commit(ThreadState &state)
+    {
+        Chunk *chunk = state.chunk;
+        if (!chunk || chunk->used + state.record.size() > chunk->data.size()) {
+            swapChunk(state, state.record.size());
+            chunk = state.chunk;
+            if (!chunk)
+                return;
+        }
+        memcpy(&chunk->data[chunk->used], state.record.data(),
+               state.record.size());
+        chunk->used += state.record.size();
+    }
+
+    template <typename ...Args>
+    void
+    record(std::false_type, Tick when, const std::string &name,
+           const char *fmt, const Args &...args)
+    {
+        std::ostringstream line;
+        ccprintf(line, fmt, args...);
+        recordText(when, name, line.str());
+    }
+
+    template <typename ...Args>
+    void
+    record(std::true_type, Tick when, const std::string &name,
+           const char *fmt, const Args &...args)
+    {
+        ThreadState &s = state();
+        uint32_t name_id = nameId(s, name);
+        uint32_t fmt_id = formatId(s, fmt);
+
+        std::string &rec = s.record;
+        rec.clear();
+        rec += 'M';
+        put(rec, uint64_t(when));
+        put(rec, name_id);
+        put(rec, fmt_id);
+        rec += char(sizeof...(args));
+        int expand[] = { 0, (putArg(rec, args), 0)... };
+        (void)expand;
+        commit(s);
+    }
+
+  public:
+    /**
+     * @param stream Binary stream of the trace file.
+     * @param chunk_size Size of the chunk of each thread.
+     * @param max_chunks Chunks in use or waiting to be written at most;
+     * a thread waits for the writer when they are all full.
+     */
+    BinaryTrace(std::ostream &stream, size_t chunk_size = 1 << 20,
+                size_t max_chunks = 64);
+    ~BinaryTrace();
+
+    /** Record a DPRINTF. */
+    template <typename ...Args>
+    void
+    record(Tick when, const std::string &name, const char *fmt,
+           const Args &...args)
+    {
+        record(std::integral_constant<bool, BinaryArgs<Args...>::raw>(),
+               when, name, fmt, args...);
+    }
+
+    /** Record a message formatted at run time. */
+    void recordText(Tick when, const std::string &name,
+                    const std::string &message);
+
+    /** A stream whose output is recorded at each flush. */
+    std::ostream &rawStream();
+
+    /** Write all records and stop the writer thread. */
+    void close();
+};
+
+/** Records decodeBinaryTrace() renders. */
+struct BinaryTraceFilter
+{
+    /** Ticks of the records to render. */
+    Tick start = 0;
+    Tick end = MaxTick;
+    /**
+     * Objects whose records are rendered, with the syntax of
+     * --debug-ignore, or all objects if empty.
+     */
+    std::string names;
+    /** Merge the records of all threads in tick order. */
+    bool sort = false;
+};
+
+/**
+ * Render a binary trace as the text trace would have been.
+ * @return false if the file is not a binary trace or is truncated.
+ */
+bool decodeBinaryTrace(std::istream &in, std::ostream &out,
+                       const BinaryTraceFilter &filter);
+
+} // namespace Trace
+
+#endif // __BASE_TRACE_BINARY_HH__
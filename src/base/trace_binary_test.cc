@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "base/trace_binary.hh"
+
+using namespace Trace;
+
+namespace {
+
+enum Colour { Red, Green };
+
+struct Printable { int v; };
+
+std::ostream &
+operator<<(std::ostream &os, const Printable &p)
+{
+    return os << "P(" << p.v << ")";
+}
+
+/**
+ * Records messages in a binary trace and in text, as OstreamLogger
+ * formats them.
+ */
+struct Recorder
+{
+    std::stringstream bin;
+    std::ostringstream text;
+    BinaryTrace trace;
+
+    Recorder(size_t chunk_size = 1 << 20, size_t max_chunks = 64)
+        : trace(bin, chunk_size, max_chunks)
+    {}
+
+    template <typename ...Args>
+    void
+    dprintf(Tick when, const std::string &name, const char *fmt,
+            const Args &...args)
+    {
+        trace.record(when, name, fmt, args...);
+        if (when != MaxTick)
+            ccprintf(text, "%7d: ", when);
+        if (!name.empty())
+            text << name << ": ";
+        ccprintf(text, fmt, args...);
+    }
+
+    std::string
+    decode(const BinaryTraceFilter &filter = BinaryTraceFilter())
+    {
+        trace.close();
+        std::istringstream in(bin.str());
+        std::ostringstream out;
+        EXPECT_TRUE(decodeBinaryTrace(in, out, filter));
+        return out.str();
+    }
+};
+
+} // anonymous namespace
+
+TEST(BinaryTraceTest, MatchesText)
+{
+    Recorder r;
+    const char *cstr = "c-string";
+    char buf[8] = "array";
+    std::string str("std::string");
+    int8_t i8 = -5;
+    uint8_t u8 = 200;
+    int16_t i16 = -300;
+    uint16_t u16 = 60000;
+    int32_t i32 = -70000;
+    uint32_t u32 = 0xdeadbeef;
+    int64_t i64 = -(int64_t(1) << 40);
+    uint64_t u64 = ~uint64_t(0);
+    long long ll = -42;
+    unsigned long long ull = 42;
+
+    r.dprintf(100, "system.cpu", "ints %d %d %d %d %d %d\n",
+              i8, u8, i16, u16, i32, u32);
+    r.dprintf(100, "system.cpu", "hex %x %#x %08x %#010x %X %o\n",
+              i32, u32, i16, u8, i64, u16);
+    r.dprintf(101, "system.cpu", "wide %d %x %lld %llu %u\n",
+              i64, u64, ll, ull, u64);
+    r.dprintf(102, "system.l2", "chars %c %c %d %s\n", 'a', 66, 'c', 'd');
+    r.dprintf(103, "system.l2", "bool %d %s\n", true, false);
+    r.dprintf(104, "system.l2", "fp %f %.3f %g %e %10.2f %5.1e\n",
+              1.5, 2.0f / 3, 1e-7, 12345.678, -3.25, 0.125f);
+    r.dprintf(105, "system.l2", "str '%s' '%10s' '%-10s' '%s' %s\n",
+              cstr, str, "lit", buf, std::string());
+    r.dprintf(106, "system.l2", "ptr %p %s\n", (void *)&r, &r);
+    r.dprintf(107, "system.l2", "star %*d|%-*d|\n", 6, 42, 4, 7);
+    r.dprintf(108, "system.l2", "mismatch %s %d %x\n", 12, "abc");
+    r.dprintf(109, "system.l2", "extra %d\n", 1, 2);
+    r.dprintf(110, "system.l2", "%% no args %d\n");
+    r.dprintf(111, "system.l2", "multi\nline %d\n", 3);
+    // Formatted at run time
+    r.dprintf(112, "system.mem", "enum %d %s\n", Green, Printable{3});
+    r.dprintf(113, "system.mem", "mixed %d %s %x\n", 4, Printable{5}, 6);
+    // DPRINTFR and DPRINTFN without a name
+    r.dprintf(MaxTick, "", "raw %d\n", 7);
+    r.dprintf(114, "", "unnamed %d\n", 8);
+    r.dprintf(115, "system.cpu", "no newline");
+    r.dprintf(115, "system.cpu", "\n");
+
+    ASSERT_EQ(r.decode(), r.text.str());
+}
+
+TEST(BinaryTraceTest, TextAndRawRecords)
+{
+    Recorder r;
+    r.trace.recordText(10, "system.cpu", "dump line\n");
+    r.trace.rawStream() << "    10: system.cpu T0 : 0x400 : nop" << std::endl;
+    r.trace.rawStream() << "partial";
+    ASSERT_EQ(r.decode(), "     10: system.cpu: dump line\n"
+              "    10: system.cpu T0 : 0x400 : nop\npartial");
+}
+
+TEST(BinaryTraceTest, ReusedFormatPointer)
+{
+    Recorder r;
+    char fmt[32];
+    strcpy(fmt, "first %d\n");
+    r.dprintf(1, "a", fmt, 1);
+    strcpy(fmt, "second %x\n");
+    r.dprintf(2, "a", fmt, 255);
+    r.dprintf(3, "a", fmt, 16);
+    ASSERT_EQ(r.decode(), r.text.str());
+}
+
+TEST(BinaryTraceTest, SmallChunks)
+{
+    // Many chunks, fewer than in use over time, and records larger
+    // than a chunk
+    Recorder r(64, 2);
+    std::string big(300, 'x');
+    for (int i = 0; i < 2000; i++) {
+        r.dprintf(i, "system.cpu" + std::to_string(i % 7), "%d %s\n", i,
+                  i % 100 ? std::string("small") : big);
+    }
+    ASSERT_EQ(r.decode(), r.text.str());
+}
+
+TEST(BinaryTraceTest, Filter)
+{
+    Recorder r;
+    for (Tick t = 0; t < 100; t++) {
+        r.trace.record(t, "system.cpu0", "cpu0 %d\n", t);
+        r.trace.record(MaxTick, "", "  cont %d\n", t);
+        r.trace.record(t, "system.l2", "l2 %d\n", t);
+    }
+
+    BinaryTraceFilter filter;
+    filter.start = 10;
+    filter.end = 11;
+    filter.names = "system.cpu0";
+    ASSERT_EQ(r.decode(filter), "     10: system.cpu0: cpu0 10\n  cont 10\n"
+              "     11: system.cpu0: cpu0 11\n  cont 11\n");
+}
+
+TEST(BinaryTraceTest, Threads)
+{
+    Recorder r(256);
+    const int per_thread = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&r, t]() {
+            std::string name = "system.cmg" + std::to_string(t);
+            for (int i = 0; i < per_thread; i++)
+                r.trace.record(i * 4 + t, name, "event %d\n", i);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    BinaryTraceFilter filter;
+    filter.sort = true;
+    std::string out = r.decode(filter);
+
+    std::ostringstream expected;
+    for (int i = 0; i < per_thread; i++) {
+        for (int t = 0; t < 4; t++)
+            ccprintf(expected, "%7d: system.cmg%d: event %d\n", i * 4 + t, t, i);
+    }
+    ASSERT_EQ(out, expected.str());
+}
+
+TEST(BinaryTraceTest, NotATrace)
+{
+    std::istringstream in("not a trace at all");
+    std::ostringstream out;
+    ASSERT_FALSE(decodeBinaryTrace(in, out, BinaryTraceFilter()));
+}
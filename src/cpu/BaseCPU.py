@@ -211,6 +211,20 @@ class BaseCPU(MemObject):
         "Desplay Flops and Bytes at every dumpstat (o3 only)")
     show_flops_detailed = Param.Bool(False,
         "Desplay Flops and Bytes at every dumpstat - detailed version (o3 only)")
+    roofline_profile = Param.Bool(False,
+        "Write per-function and per-PC roofline tables at every dumpstat "
+        "(o3 only)")
+    pipe_trace = Param.Bool(False,
+        "Write a binary per-instruction pipeline trace (o3 only)")
+    pipe_trace_start = Param.Tick(0,
+        "Trace instructions fetched from this tick on")
+    pipe_trace_end = Param.Tick(MaxTick,
+        "Trace instructions fetched before this tick")
+    pipe_trace_start_inst = Param.Counter(0,
+        "Trace instructions fetched once this many have committed")
+    pipe_trace_end_inst = Param.Counter(0,
+        "Trace instructions fetched before this many have committed "
+        "(0: no limit)")
 
 
     max_insts_all_threads = Param.Counter(0,
@@ -140,6 +140,7 @@ BaseCPU::BaseCPU(Params *p, bool is_checker)
       syscallRetryLatency(p->syscallRetryLatency),
       showFlops(p->show_flops),
       showFlopsDetailed(p->show_flops_detailed),
+      rooflineProfile(p->roofline_profile),
       pwrGatingLatency(p->pwr_gating_latency),
       powerGatingOnIdle(p->power_gating_on_idle),
       enterPwrGatingEvent([this]{ enterPwrGating(); }, name())
@@ -46,6 +46,7 @@
 #ifndef __CPU_BASE_HH__
 #define __CPU_BASE_HH__
 
+#include <limits>
 #include <vector>
 
 // Before we do anything else, check if this build is the NULL ISA,
@@ -391,6 +392,17 @@ class BaseCPU : public MemObject
      */
     inline unsigned int cacheLineSize() const { return _cacheLineSize; }
 
+    /**
+     * Get the largest number of bytes a single memory access of an
+     * instruction may cover. CPUs that can only split an access in two
+     * limit it to a cache line.
+     */
+    virtual unsigned
+    maxMemAccessSpan() const
+    {
+        return std::numeric_limits<unsigned>::max();
+    }
+
     /**
      * Serialize this object to the given output stream.
      *
@@ -639,6 +651,7 @@ class BaseCPU : public MemObject
 
     const int showFlops;
     const int showFlopsDetailed;
+    const bool rooflineProfile;
 
 
   // Enables CPU to enter power gating on a configurable cycle count
@@ -54,6 +54,7 @@
 
 #include "arch/generic/tlb.hh"
 #include "arch/utility.hh"
+#include "base/pool.hh"
 #include "base/trace.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -232,6 +233,14 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** Pointer to the data for the memory access. */
     uint8_t *memData;
 
+    /** Allocate memData from the CPU's buffer pool. */
+    void
+    allocMemData(size_t size)
+    {
+        assert(!memData);
+        memData = static_cast<uint8_t *>(cpu->memDataPool.allocate(size));
+    }
+
     /** Load queue index. */
     int16_t lqIdx;
     LQIterator lqIt;
@@ -530,6 +539,7 @@ class BaseDynInst : public ExecContext, public RefCounted
     bool isAtomic()       const { return staticInst->isAtomic(); }
     bool isStoreConditional() const
     { return staticInst->isStoreConditional(); }
+    bool isIndexed() const { return staticInst->isIndexed(); }
     bool isInstPrefetch() const { return staticInst->isInstPrefetch(); }
     bool isDataPrefetch() const { return staticInst->isDataPrefetch(); }
     bool isInteger()      const { return staticInst->isInteger(); }
@@ -147,7 +147,7 @@ template <class Impl>
 BaseDynInst<Impl>::~BaseDynInst()
 {
     if (memData) {
-        delete [] memData;
+        BufferPool::release(memData);
     }
 
     if (traceData) {
@@ -35,6 +35,7 @@
 
 #include "arch/isa_traits.hh"
 #include "arch/types.hh"
+#include "base/flat_map.hh"
 #include "config/the_isa.hh"
 #include "cpu/static_inst_fwd.hh"
 
@@ -47,7 +48,7 @@ namespace DecodeCache
 {
 
 /// Hash for decoded instructions.
-typedef std::unordered_map<TheISA::ExtMachInst, StaticInstPtr> InstMap;
+typedef FlatMap<TheISA::ExtMachInst, StaticInstPtr> InstMap;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value>
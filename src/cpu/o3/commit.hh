@@ -49,10 +49,12 @@
 #include "base/statistics.hh"
 #include "cpu/exetrace.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/roofline.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
 struct DerivO3CPUParams;
+class OutputStream;
 
 template <class>
 struct O3ThreadState;
@@ -147,6 +149,23 @@ class DefaultCommit
 
     int numReset;
 
+    /** Per-PC flop, byte and cycle counters of committed instructions.
+     *  Only filled in when the CPU's roofline_profile parameter is set.
+     */
+    RooflineProfile roofline;
+
+    /** Output file for the roofline tables, created on first use. */
+    OutputStream *rooflineStream;
+
+    /** Cycle of the last commit, charged to the next committed PC. */
+    Cycles rooflineLastCycle;
+
+    /** Number of roofline tables written so far. */
+    int rooflineDumps;
+
+    /** Append the current roofline tables to the output and clear them. */
+    void dumpRoofline();
+
   public:
     /** Construct a DefaultCommit with the given parameters. */
     DefaultCommit(O3CPU *_cpu, DerivO3CPUParams *params);
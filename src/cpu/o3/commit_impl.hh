@@ -49,8 +49,10 @@
 #include <string>
 
 #include "arch/utility.hh"
+#include "base/callback.hh"
 #include "base/cp_annotate.hh"
 #include "base/loader/symtab.hh"
+#include "base/output.hh"
 #include "config/the_isa.hh"
 #include "cpu/base.hh"
 #include "cpu/checker/cpu.hh"
@@ -68,7 +70,9 @@
 #include "debug/ROBEntries.hh"
 #include "params/DerivO3CPU.hh"
 #include "sim/faults.hh"
+#include "sim/core.hh"
 #include "sim/full_system.hh"
+#include "sim/sim_exit.hh"
 
 using namespace std;
 
@@ -150,6 +154,15 @@ DefaultCommit<Impl>::DefaultCommit(O3CPU *_cpu, DerivO3CPUParams *params)
     }
     interrupt = NoFault;
     numReset = 0;
+
+    rooflineStream = nullptr;
+    rooflineLastCycle = Cycles(0);
+    rooflineDumps = 0;
+    if (cpu->rooflineProfile) {
+        registerExitCallback(
+            new MakeCallback<DefaultCommit<Impl>,
+                             &DefaultCommit<Impl>::dumpRoofline>(this));
+    }
 }
 
 template <class Impl>
@@ -404,6 +417,36 @@ DefaultCommit<Impl>::resetStats()
             std::cout << "=================================================================" << std::endl;
         }
     }
+
+    if (cpu->rooflineProfile) {
+        if (numReset % 2)
+            dumpRoofline();
+        roofline.clear();
+        rooflineLastCycle = cpu->curCycle();
+    }
+}
+
+template <class Impl>
+void
+DefaultCommit<Impl>::dumpRoofline()
+{
+    if (roofline.empty())
+        return;
+
+    if (!rooflineStream) {
+        rooflineStream =
+            simout.create(csprintf("roofline.%s.txt", cpu->name()));
+    }
+
+    std::ostream &os = *rooflineStream->stream();
+    ccprintf(os, "==================== %s region %d ====================\n",
+             cpu->name(), rooflineDumps++);
+    roofline.dump(os, debugSymbolTable,
+                  cpu->clockPeriod() / double(SimClock::Frequency));
+    ccprintf(os, "\n");
+    os.flush();
+
+    roofline.clear();
 }
 
 
@@ -572,6 +615,9 @@ DefaultCommit<Impl>::takeOverFrom()
         squashAfterInst[tid] = NULL;
     }
     rob->takeOverFrom();
+
+    // Don't charge the switched-out period to the first committed PC.
+    rooflineLastCycle = cpu->curCycle();
 }
 
 template <class Impl>
@@ -1449,11 +1495,9 @@ DefaultCommit<Impl>::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     // Finally clear the head ROB entry.
     rob->retireHead(tid);
 
-#if TRACING_ON
-    if (DTRACE(O3PipeView)) {
+    if (DTRACE(O3PipeView) || head_inst->pipeTraced) {
         head_inst->commitTick = curTick() - head_inst->fetchTick;
     }
-#endif
 
     // If this was a store, record it for this cycle.
     if (head_inst->isStore() || head_inst->isAtomic())
@@ -1701,11 +1745,24 @@ DefaultCommit<Impl>::updateComInstStats(const DynInstPtr &inst)
         addPAMemops = (addMemops * numActiveElems) / numVectorElems;
     }
 
+    int addPABytes = 0;
+
     switch(inst->staticInst->getElemBits()) {
-        case 16:pahflops += addPAFlops;pabytes += addPAMemops * 2;break;
-        case 32:pasflops += addPAFlops;pabytes += addPAMemops * 4;break;
-        case 64:padflops += addPAFlops;pabytes += addPAMemops * 8;break;
-        default:pabytes += addPAMemops * 8;break;// this should be modified
+        case 16:pahflops += addPAFlops;addPABytes = addPAMemops * 2;break;
+        case 32:pasflops += addPAFlops;addPABytes = addPAMemops * 4;break;
+        case 64:padflops += addPAFlops;addPABytes = addPAMemops * 8;break;
+        default:addPABytes = addPAMemops * 8;break;// this should be modified
+    }
+    pabytes += addPABytes;
+
+    if (cpu->rooflineProfile) {
+        Cycles now = cpu->curCycle();
+        bool inst_end = !inst->isMicroop() || inst->isLastMicroop();
+        roofline.sample(inst->instAddr(), inst_end ? 1 : 0,
+                        now - rooflineLastCycle, addPAFlops, addPABytes,
+                        predicate ? numActiveElems : 0,
+                        predicate ? numVectorElems : 0);
+        rooflineLastCycle = now;
     }
 
 }
@@ -48,10 +48,13 @@
 
 #include "arch/generic/traits.hh"
 #include "arch/kernel_stats.hh"
+#include "base/callback.hh"
+#include "base/output.hh"
 #include "config/the_isa.hh"
 #include "cpu/activity.hh"
 #include "cpu/checker/cpu.hh"
 #include "cpu/checker/thread_context.hh"
+#include "cpu/o3/fu_pool.hh"
 #include "cpu/o3/isa_specific.hh"
 #include "cpu/o3/thread_context.hh"
 #include "cpu/quiesce_event.hh"
@@ -63,6 +66,7 @@
 #include "debug/Quiesce.hh"
 #include "enums/MemoryMode.hh"
 #include "sim/core.hh"
+#include "sim/sim_exit.hh"
 #include "sim/full_system.hh"
 #include "sim/process.hh"
 #include "sim/stat_control.hh"
@@ -152,6 +156,8 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      // instructions are large, so pool them in bigger chunks
+      instPool(16 * 1024, 256 * 1024),
       removeInstsThisCycle(false),
       fetch(this, params),
       decode(this, params),
@@ -431,6 +437,25 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
 
     for (ThreadID tid = 0; tid < this->numThreads; tid++)
         this->thread[tid]->setFuncExeInst(0);
+
+    if (params->pipe_trace) {
+        std::vector<std::string> op_classes(
+            Enums::OpClassStrings, Enums::OpClassStrings + Enums::Num_OpClass);
+        std::vector<std::string> fus;
+        for (int i = 0; i < params->fuPool->size(); ++i)
+            fus.push_back(params->fuPool->unitName(i));
+
+        OutputStream *os =
+            simout.create(csprintf("pipetrace.%s.bin", name()), true);
+        pipeTrace.reset(new PipeTrace(*os->stream(), clockPeriod(),
+                                      op_classes, fus));
+        pipeTrace->setWindow(params->pipe_trace_start,
+                             params->pipe_trace_end,
+                             params->pipe_trace_start_inst,
+                             params->pipe_trace_end_inst);
+        registerExitCallback(new MakeCallback<PipeTrace, &PipeTrace::flush>(
+                                 pipeTrace.get()));
+    }
 }
 
 template <class Impl>
@@ -460,6 +485,26 @@ FullO3CPU<Impl>::regStats()
     BaseO3CPU::regStats();
 
     // Register any of the O3CPU's stats here.
+    instPoolPeak
+        .name(name() + ".instPoolPeak")
+        .desc("Peak number of dynamic instructions allocated at once")
+        .method(&instPool, &BufferPool::peakInUse);
+
+    memDataPoolPeak
+        .name(name() + ".memDataPoolPeak")
+        .desc("Peak number of load/store data buffers allocated at once")
+        .method(&memDataPool, &BufferPool::peakInUse);
+
+    wbEventPoolPeak
+        .name(name() + ".wbEventPoolPeak")
+        .desc("Peak number of LSQ writeback events allocated at once")
+        .method(&wbEventPool, &BufferPool::peakInUse);
+
+    poolReservedBytes
+        .name(name() + ".poolReservedBytes")
+        .desc("Bytes reserved by the instruction, data and event pools")
+        .method(this, &FullO3CPU<Impl>::poolBytes);
+
     timesIdled
         .name(name() + ".timesIdled")
         .desc("Number of times that the entire CPU went into an idle state and"
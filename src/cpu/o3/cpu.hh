@@ -49,12 +49,14 @@
 
 #include <iostream>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <vector>
 
 #include "arch/generic/types.hh"
 #include "arch/types.hh"
+#include "base/pool.hh"
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
@@ -63,6 +65,7 @@
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
 #include "cpu/base.hh"
+#include "cpu/pipe_trace.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/timebuf.hh"
 //#include "cpu/o3/thread_context.hh"
@@ -314,6 +317,16 @@ class FullO3CPU : public BaseO3CPU
     /** Count the Total Ops (including micro ops) committed in the CPU. */
     Counter totalOps() const override;
 
+    /** Binary pipeline trace, null unless pipe_trace is set. */
+    std::unique_ptr<PipeTrace> pipeTrace;
+
+    /** Whether an instruction fetched now goes into the pipeline trace. */
+    bool
+    pipeTraceCapturing() const
+    {
+        return pipeTrace && pipeTrace->capturing(curTick(), totalInsts());
+    }
+
     /** Add Thread to Active Threads List. */
     void activateContext(ThreadID tid) override;
 
@@ -588,6 +601,21 @@ class FullO3CPU : public BaseO3CPU
     int instcount;
 #endif
 
+    /** Memory for dynamic instructions. */
+    BufferPool instPool;
+    /** Memory for the data of loads and stores. */
+    BufferPool memDataPool;
+    /** Memory for the writeback events of the LSQ. */
+    BufferPool wbEventPool;
+
+    /** Bytes reserved by the pools above. */
+    uint64_t
+    poolBytes() const
+    {
+        return instPool.reservedBytes() + memDataPool.reservedBytes() +
+            wbEventPool.reservedBytes();
+    }
+
     /** List of all the instructions in flight. */
     std::list<DynInstPtr> instList;
 
@@ -794,6 +822,15 @@ class FullO3CPU : public BaseO3CPU
     /** Get the dcache port (used to find block size for translations). */
     MasterPort &getDataPort() override { return dcachePort; }
 
+    /** Peak number of instructions allocated from instPool. */
+    Stats::Value instPoolPeak;
+    /** Peak number of buffers allocated from memDataPool. */
+    Stats::Value memDataPoolPeak;
+    /** Peak number of events allocated from wbEventPool. */
+    Stats::Value wbEventPoolPeak;
+    /** Bytes reserved by the three pools. */
+    Stats::Value poolReservedBytes;
+
     /** Stat for total number of times the CPU is descheduled. */
     Stats::Scalar timesIdled;
     /** Stat for total number of cycles the CPU spends descheduled. */
@@ -703,11 +703,9 @@ DefaultDecode<Impl>::decodeInsts(ThreadID tid)
         ++decodeDecodedInsts;
         --insts_available;
 
-#if TRACING_ON
-        if (DTRACE(O3PipeView)) {
+        if (DTRACE(O3PipeView) || inst->pipeTraced) {
             inst->decodeTick = curTick() - inst->fetchTick;
         }
-#endif
 
         // Ensure that if it was predicted as a branch, it really is a
         // branch.
@@ -98,6 +98,25 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /** Instructions are allocated from a pool of the CPU. */
+    static void *
+    operator new(size_t size, BufferPool &pool)
+    {
+        return pool.allocate(size);
+    }
+
+    static void
+    operator delete(void *p, BufferPool &pool)
+    {
+        BufferPool::release(p);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        BufferPool::release(p);
+    }
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -133,8 +152,8 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
 
   public:
-#if TRACING_ON
-    /** Tick records used for the pipeline activity viewer. */
+    /** Tick records used for the pipeline activity viewer and the
+     * pipeline trace. */
     Tick fetchTick;      // instruction fetch is completed.
     int32_t decodeTick;  // instruction enters decode phase
     int32_t renameTick;  // instruction enters rename phase
@@ -143,7 +162,12 @@ class BaseO3DynInst : public BaseDynInst<Impl>
     int32_t completeTick;
     int32_t commitTick;
     int32_t storeTick;
-#endif
+
+    /** Functional unit the instruction issued to, -1 if none. */
+    int16_t fuIdx;
+
+    /** Whether the instruction goes into the CPU's pipeline trace. */
+    bool pipeTraced;
 
 
     //void setNumActiveElems(int val) {numActiveElems = val;}
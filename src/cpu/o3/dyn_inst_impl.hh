@@ -99,6 +99,41 @@ template <class Impl>BaseO3DynInst<Impl>::~BaseO3DynInst()
         }
     }
 #endif
+
+    if (this->pipeTraced) {
+        PipeTrace &trace = *this->cpu->pipeTrace;
+        PipeTrace::Record rec;
+        rec.seqNum = this->seqNum;
+        rec.pc = this->instAddr();
+        rec.upc = this->microPC();
+        rec.thread = this->threadNumber;
+        rec.flags = (this->isCommitted() ? PipeTrace::Committed : 0) |
+            (this->isLoad() ? PipeTrace::IsLoad : 0) |
+            (this->isStore() ? PipeTrace::IsStore : 0) |
+            (this->isVector() ? PipeTrace::IsVector : 0) |
+            (this->isMicroop() ? PipeTrace::IsMicroop : 0) |
+            (this->isLastMicroop() ? PipeTrace::IsLastMicroop : 0);
+        rec.opClass = this->opClass();
+        rec.fu = this->fuIdx;
+        rec.text = trace.textId(this->staticInst.get(), rec.pc, [this]() {
+            return this->staticInst->disassemble(this->instAddr());
+        });
+        rec.fetch = this->fetchTick;
+        rec.stage[PipeTrace::Decode] = this->decodeTick;
+        rec.stage[PipeTrace::Rename] = this->renameTick;
+        rec.stage[PipeTrace::Dispatch] = this->dispatchTick;
+        rec.stage[PipeTrace::Issue] = this->issueTick;
+        rec.stage[PipeTrace::Complete] = this->completeTick;
+        rec.stage[PipeTrace::Retire] = this->commitTick;
+        rec.stage[PipeTrace::Store] = this->storeTick;
+        rec.end = curTick() - this->fetchTick;
+        if (this->staticInst->getNumActiveElems() >= 0) {
+            rec.flags |= PipeTrace::Predicated;
+            rec.activeElems = this->staticInst->getNumActiveElems();
+            rec.vecElems = this->staticInst->getNumVecElems();
+        }
+        trace.record(rec);
+    }
 };
 
 
@@ -110,7 +145,6 @@ BaseO3DynInst<Impl>::initVars()
 
     _numDestMiscRegs = 0;
 
-#if TRACING_ON
     // Value -1 indicates that particular phase
     // hasn't happened (yet).
     fetchTick = -1;
@@ -121,7 +155,8 @@ BaseO3DynInst<Impl>::initVars()
     completeTick = -1;
     commitTick = -1;
     storeTick = -1;
-#endif
+    fuIdx = -1;
+    pipeTraced = false;
 }
 
 template <class Impl>
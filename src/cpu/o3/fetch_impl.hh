@@ -1112,7 +1112,8 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction =
-        new DynInst(staticInst, curMacroop, thisPC, nextPC, seq, cpu);
+        new (cpu->instPool) DynInst(staticInst, curMacroop, thisPC, nextPC,
+                                    seq, cpu);
     instruction->setTid(tid);
 
     instruction->setASID(tid);
@@ -1339,11 +1340,10 @@ DefaultFetch<Impl>::fetch(bool &status_change)
             ppFetch->notify(instruction);
             numInst++;
 
-#if TRACING_ON
-            if (DTRACE(O3PipeView)) {
+            instruction->pipeTraced = cpu->pipeTraceCapturing();
+            if (DTRACE(O3PipeView) || instruction->pipeTraced) {
                 instruction->fetchTick = curTick();
             }
-#endif
 
             nextPC = thisPC;
 
@@ -229,6 +229,12 @@ FUPool::processFreeUnits()
     }
 }
 
+const std::string &
+FUPool::unitName(int fu_idx) const
+{
+    return funcUnits[fu_idx]->name;
+}
+
 void
 FUPool::dump()
 {
@@ -170,6 +170,9 @@ class FUPool : public SimObject
     /** Returns the total number of FUs. */
     int size() { return numFU; }
 
+    /** Returns the name of a FU, as used by the pipeline trace. */
+    const std::string &unitName(int fu_idx) const;
+
     /** Debugging function used to dump FU information. */
     void dump();
 
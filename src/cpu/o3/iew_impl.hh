@@ -1149,9 +1149,7 @@ DefaultIEW<Impl>::dispatchInsts(ThreadID tid)
 
         ++iewDispatchedInsts;
 
-#if TRACING_ON
         inst->dispatchTick = curTick() - inst->fetchTick;
-#endif
         ppDispatch->notify(inst);
     }
 
@@ -1626,11 +1624,9 @@ DefaultIEW<Impl>::updateExeInstStats(const DynInstPtr& inst)
 
     iewExecutedInsts++;
 
-#if TRACING_ON
-    if (DTRACE(O3PipeView)) {
+    if (DTRACE(O3PipeView) || inst->pipeTraced) {
         inst->completeTick = curTick() - inst->fetchTick;
     }
-#endif
 
     //
     //  Control operations
@@ -49,6 +49,7 @@
 #include <queue>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
@@ -94,6 +95,7 @@ class InstructionQueue
 
     // Typedef of iterator through the list of instructions.
     typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator RingIt;
 
     /** FU completion event class. */
     class FUCompletion : public Event {
@@ -312,11 +314,13 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Entries stay until commit, so each ring is sized like the ROB.
+     */
+    CircularQueue<DynInstPtr> instList[Impl::MaxThreads];
 
     /** List of instructions that are ready to be executed. */
-    std::list<DynInstPtr> instsToExecute;
+    CircularQueue<DynInstPtr> instsToExecute;
 
     /** List of instructions waiting for their DTB translation to
      *  complete (hw page table walk in progress).
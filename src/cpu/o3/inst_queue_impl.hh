@@ -89,6 +89,7 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params->fuPool),
+      instsToExecute(params->numROBEntries),
       numEntries(params->numIQEntries),
       totalWidth(params->issueWidth),
       commitToIEWDelay(params->commitToIEWDelay)
@@ -97,6 +98,12 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
 
     numThreads = params->numThreads;
 
+    // Issued instructions leave the free-entry count but stay listed
+    // until they commit, so the lists are bounded by the ROB instead.
+    for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        instList[tid] = CircularQueue<DynInstPtr>(params->numROBEntries);
+    }
+
     // Set the number of total physical registers
     // As the vector registers have two addressing modes, they are added twice
     numPhysRegs = params->numPhysIntRegs + params->numPhysFloatRegs +
@@ -412,7 +419,10 @@ InstructionQueue<Impl>::resetState()
     //Initialize thread IQ counts
     for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
         count[tid] = 0;
-        instList[tid].clear();
+        while (!instList[tid].empty()) {
+            instList[tid].front() = NULL;
+            instList[tid].pop_front();
+        }
     }
 
     // Initialize the number of free IQ entries.
@@ -606,6 +616,7 @@ InstructionQueue<Impl>::insert(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
+    assert(!instList[new_inst->threadNumber].full());
     instList[new_inst->threadNumber].push_back(new_inst);
 
     --freeEntries;
@@ -657,6 +668,7 @@ InstructionQueue<Impl>::insertNonSpec(const DynInstPtr &new_inst)
 
     assert(freeEntries != 0);
 
+    assert(!instList[new_inst->threadNumber].full());
     instList[new_inst->threadNumber].push_back(new_inst);
 
     --freeEntries;
@@ -777,6 +789,7 @@ InstructionQueue<Impl>::processFUCompletion(const DynInstPtr &inst, int fu_idx)
     // of a cycle, otherwise they could add too many instructions to
     // the queue.
     issueToExecuteQueue->access(-1)->size++;
+    assert(!instsToExecute.full());
     instsToExecute.push_back(inst);
 }
 
@@ -871,6 +884,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
         if (idx != FUPool::NoFreeFU) {
             if (op_latency == Cycles(1)) {
                 i2e_info->size++;
+                assert(!instsToExecute.full());
                 instsToExecute.push_back(issuing_inst);
 
                 Cycles cpo = fuPool->getCyclesPerOps(op_class);
@@ -930,9 +944,9 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
             issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
+            if (idx >= 0)
+                issuing_inst->fuIdx = idx;
 
             if (!issuing_inst->isMemRef()) {
                 // Memory instructions can not be freed from the IQ until they
@@ -1002,11 +1016,9 @@ InstructionQueue<Impl>::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i]: Committing instructions older than [sn:%i]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
+        instList[tid].front() = NULL;
         instList[tid].pop_front();
     }
 
@@ -1252,19 +1264,17 @@ template <class Impl>
 void
 InstructionQueue<Impl>::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i]: Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given.  These are always the youngest entries in the list, so the
+    // squash simply truncates it from the tail.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = std::move(instList[tid].back());
+        instList[tid].pop_back();
         if (squashed_inst->isFloating()) {
             fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1277,7 +1287,6 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
         // hasn't already been squashed in the IQ.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
             continue;
         }
 
@@ -1368,7 +1377,6 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             ++freeEntries;
         }
 
-        instList[tid].erase(squash_it--);
         ++iqSquashedInstsExamined;
     }
 }
@@ -1509,7 +1517,7 @@ InstructionQueue<Impl>::countInsts()
     int total_insts = 0;
 
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
-        ListIt count_it = instList[tid].begin();
+        RingIt count_it = instList[tid].begin();
 
         while (count_it != instList[tid].end()) {
             if (!(*count_it)->isSquashed() && !(*count_it)->isSquashedInIQ()) {
@@ -1583,7 +1591,7 @@ InstructionQueue<Impl>::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        RingIt inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -1623,7 +1631,7 @@ InstructionQueue<Impl>::dumpInsts()
 
     int num = 0;
     int valid_num = 0;
-    ListIt inst_list_it = instsToExecute.begin();
+    RingIt inst_list_it = instsToExecute.begin();
 
     while (inst_list_it != instsToExecute.end())
     {
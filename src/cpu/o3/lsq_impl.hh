@@ -751,6 +751,11 @@ LSQ<Impl>::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
         inst->getFault() = NoFault;
 
         req->initiateTranslation();
+
+        // Count the line requests of a fused gather/scatter once, not
+        // on each replay of the saved request
+        if (inst->isIndexed())
+            thread.at(tid).sampleIndexedLineRequests(req->_requests.size());
     }
 
     /* This is the place were instructions get the effAddr. */
@@ -438,6 +438,25 @@ class LSQUnit {
         WritebackEvent(const DynInstPtr &_inst, PacketPtr pkt,
                 LSQUnit *lsq_ptr);
 
+        /** Writeback events are allocated from a pool of the CPU. */
+        static void *
+        operator new(size_t size, BufferPool &pool)
+        {
+            return pool.allocate(size);
+        }
+
+        static void
+        operator delete(void *p, BufferPool &pool)
+        {
+            BufferPool::release(p);
+        }
+
+        static void
+        operator delete(void *p)
+        {
+            BufferPool::release(p);
+        }
+
         /** Processes the writeback event. */
         void process();
 
@@ -569,7 +588,17 @@ class LSQUnit {
     /** Number of times the LSQ is blocked due to the cache. */
     Stats::Scalar lsqCacheBlocked;
 
+    /** Distribution of cache line requests per fused gather/scatter. */
+    Stats::Distribution lsqIndexedLineRequests;
+
   public:
+    /** Counts the cache line requests of a fused gather/scatter. */
+    void
+    sampleIndexedLineRequests(unsigned requests)
+    {
+        lsqIndexedLineRequests.sample(requests);
+    }
+
     /** Executes the load at the given index. */
     Fault read(LSQRequest *req, int load_idx);
 
@@ -656,8 +685,7 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
 
     /* TODO: Check that split request don't mess with this. */
     if (req->mainRequest()->isMmappedIpr()) {
-        assert(!load_inst->memData);
-        load_inst->memData = new uint8_t[MaxDataBytes];
+        load_inst->allocMemData(MaxDataBytes);
 
         ThreadContext *thread = cpu->tcBase(lsqID);
         Cycles delay(0);
@@ -690,7 +718,8 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
             delete fst_data_pkt;
             delete snd_data_pkt;*/
         }
-        WritebackEvent *wb = new WritebackEvent(load_inst, data_pkt, this);
+        WritebackEvent *wb = new (cpu->wbEventPool)
+            WritebackEvent(load_inst, data_pkt, this);
         cpu->schedule(wb, cpu->clockEdge(delay));
         return NoFault;
     }
@@ -766,8 +795,7 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
 
                 // Allocate memory if this is the first time a load is issued.
                 if (!load_inst->memData) {
-                    load_inst->memData =
-                        new uint8_t[req->mainRequest()->getSize()];
+                    load_inst->allocMemData(req->mainRequest()->getSize());
                 }
                 if (store_it->isAllZeros())
                     memset(load_inst->memData, 0,
@@ -794,8 +822,8 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
                     req->discardSenderState();
                 }
 
-                WritebackEvent *wb = new WritebackEvent(load_inst, data_pkt,
-                        this);
+                WritebackEvent *wb = new (cpu->wbEventPool)
+                    WritebackEvent(load_inst, data_pkt, this);
 
                 // We'll say this has a 1 cycle load-store forwarding latency
                 // for now.
@@ -851,7 +879,7 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
 
     // Allocate memory if this is the first time a load is issued.
     if (!load_inst->memData) {
-        load_inst->memData = new uint8_t[req->mainRequest()->getSize()];
+        load_inst->allocMemData(req->mainRequest()->getSize());
     }
 
     // For now, load throughput is constrained by the number of
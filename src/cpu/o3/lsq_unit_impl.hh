@@ -244,6 +244,12 @@ LSQUnit<Impl>::regStats()
     lsqCacheBlocked
         .name(name() + ".cacheBlocked")
         .desc("Number of times an access to memory failed due to the cache being blocked");
+
+    lsqIndexedLineRequests
+        .init(0, 64, 1)
+        .name(name() + ".indexedLineRequests")
+        .desc("Number of cache line requests per fused gather/scatter")
+        .flags(Stats::nozero);
 }
 
 template<class Impl>
@@ -783,8 +789,7 @@ LSQUnit<Impl>::writebackStores()
         LSQRequest* req = storeWBIt->request();
         storeWBIt->committed() = true;
 
-        assert(!inst->memData);
-        inst->memData = new uint8_t[req->_size];
+        inst->allocMemData(req->_size);
 
         if (storeWBIt->isAllZeros())
             memset(inst->memData, 0, req->_size);
@@ -830,8 +835,8 @@ LSQUnit<Impl>::writebackStores()
                         "Instantly completing it.\n",
                         inst->seqNum);
                 PacketPtr new_pkt = new Packet(*req->packet());
-                WritebackEvent *wb = new WritebackEvent(inst,
-                        new_pkt, this);
+                WritebackEvent *wb = new (cpu->wbEventPool)
+                    WritebackEvent(inst, new_pkt, this);
                 cpu->schedule(wb, curTick() + 1);
                 completeStore(storeWBIt);
                 if (!storeQueue.empty())
@@ -1046,12 +1051,10 @@ LSQUnit<Impl>::completeStore(typename StoreQueue::iterator store_idx)
             "idx:%i\n",
             store_inst->seqNum, store_idx.idx() - 1, storeQueue.head() - 1);
 
-#if TRACING_ON
-    if (DTRACE(O3PipeView)) {
+    if (DTRACE(O3PipeView) || store_inst->pipeTraced) {
         store_inst->storeTick =
             curTick() - store_inst->fetchTick;
     }
-#endif
 
     if (isStalled() &&
         store_inst->seqNum == stallingStoreIsn) {
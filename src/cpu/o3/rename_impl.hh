@@ -805,11 +805,9 @@ DefaultRename<Impl>::sortInsts()
     for (int i = 0; i < insts_from_decode; ++i) {
         const DynInstPtr &inst = fromDecode->insts[i];
         insts[inst->threadNumber].push_back(inst);
-#if TRACING_ON
-        if (DTRACE(O3PipeView)) {
+        if (DTRACE(O3PipeView) || inst->pipeTraced) {
             inst->renameTick = curTick() - inst->fetchTick;
         }
-#endif
     }
 }
 
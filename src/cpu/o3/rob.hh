@@ -49,6 +49,7 @@
 #include <vector>
 
 #include "arch/registers.hh"
+#include "base/circular_queue.hh"
 #include "base/types.hh"
 #include "config/the_isa.hh"
 
@@ -66,7 +67,7 @@ class ROB
     typedef typename Impl::DynInstPtr DynInstPtr;
 
     typedef std::pair<RegIndex, PhysRegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef typename CircularQueue<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status {
@@ -290,8 +291,10 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[Impl::MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[Impl::MaxThreads];
+    /** ROB List of Instructions, one ring of numEntries slots per thread.
+     *  Instructions only ever enter at the tail and leave from the head.
+     */
+    CircularQueue<DynInstPtr> instList[Impl::MaxThreads];
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -313,7 +316,8 @@ class ROB
      *  when squashing, the instructions are marked as squashed but not
      *  immediately removed, meaning the tail iterator remains the same before
      *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  This will always be set to a default-constructed InstIt if it is
+     *  invalid.
      */
     InstIt squashIt[Impl::MaxThreads];
 
@@ -106,6 +106,12 @@ ROB<Impl>::ROB(O3CPU *_cpu, DerivO3CPUParams *params)
         maxEntries[tid] = 0;
     }
 
+    // A thread can hold every ROB entry under the dynamic policy, so
+    // each ring is sized for the whole ROB.
+    for (ThreadID tid = 0; tid < Impl::MaxThreads; tid++) {
+        instList[tid] = CircularQueue<DynInstPtr>(numEntries);
+    }
+
     resetState();
 }
 
@@ -115,7 +121,7 @@ ROB<Impl>::resetState()
 {
     for (ThreadID tid = 0; tid  < Impl::MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
@@ -123,8 +129,8 @@ ROB<Impl>::resetState()
 
     // Initialize the "universal" ROB head & tail point to invalid
     // pointers
-    head = instList[0].end();
-    tail = instList[0].end();
+    head = InstIt();
+    tail = InstIt();
 }
 
 template <class Impl>
@@ -207,7 +213,7 @@ template <class Impl>
 int
 ROB<Impl>::countInsts(ThreadID tid)
 {
-    return instList[tid].size();
+    return instList[tid].num_elements();
 }
 
 template <class Impl>
@@ -256,10 +262,10 @@ ROB<Impl>::retireHead(ThreadID tid)
     assert(numInstsInROB > 0);
 
     // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Moving out of the slot also drops the ring's reference, so the
+    // instruction is not kept alive until the slot is reused.
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -342,13 +348,13 @@ ROB<Impl>::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%u]: Squashing instructions until [sn:%i].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    assert(squashIt[tid] != InstIt());
 
     if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%u]: Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
         return;
@@ -358,7 +364,7 @@ ROB<Impl>::doSquash(ThreadID tid)
 
     for (int numSquashed = 0;
          numSquashed < squashWidth &&
-         squashIt[tid] != instList[tid].end() &&
+         squashIt[tid] != InstIt() &&
          (*squashIt[tid])->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
@@ -378,17 +384,14 @@ ROB<Impl>::doSquash(ThreadID tid)
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
+            squashIt[tid] = InstIt();
 
             doneSquashing[tid] = true;
 
             return;
         }
 
-        InstIt tail_thread = instList[tid].end();
-        tail_thread--;
-
-        if ((*squashIt[tid]) == (*tail_thread))
+        if ((*squashIt[tid]) == instList[tid].back())
             robTailUpdate = true;
 
         squashIt[tid]--;
@@ -400,7 +403,7 @@ ROB<Impl>::doSquash(ThreadID tid)
         DPRINTF(ROB, "[tid:%u]: Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
     }
@@ -448,7 +451,7 @@ ROB<Impl>::updateHead()
     }
 
     if (first_valid) {
-        head = instList[0].end();
+        head = InstIt();
     }
 
 }
@@ -457,7 +460,7 @@ template <class Impl>
 void
 ROB<Impl>::updateTail()
 {
-    tail = instList[0].end();
+    tail = InstIt();
     bool first_valid = true;
 
     list<ThreadID>::iterator threads = activeThreads->begin();
@@ -51,6 +51,7 @@
 #include "cpu/o3/thread_context.hh"
 #include "cpu/quiesce_event.hh"
 #include "debug/O3CPU.hh"
+#include "sim/eventq.hh"
 
 template <class Impl>
 FSTranslatingPortProxy&
@@ -97,8 +98,13 @@ O3ThreadContext<Impl>::activate()
     thread->lastActivate = curTick();
     thread->setStatus(ThreadContext::Active);
 
-    // status() == Suspended
-    cpu->activateContext(thread->threadId());
+    // status() == Suspended. Activations requested from another CPU,
+    // e.g., by clone() on a CPU simulated on another event queue, are
+    // handed over to the event queue of this CPU.
+    ThreadID tid = thread->threadId();
+    runOnEventQueue(cpu->eventQueue(), [this, tid] {
+        cpu->activateContext(tid);
+    });
 }
 
 template <class Impl>
@@ -122,7 +128,10 @@ O3ThreadContext<Impl>::suspend()
     thread->lastSuspend = curTick();
 
     thread->setStatus(ThreadContext::Suspended);
-    cpu->suspendContext(thread->threadId());
+    ThreadID tid = thread->threadId();
+    runOnEventQueue(cpu->eventQueue(), [this, tid] {
+        cpu->suspendContext(tid);
+    });
 }
 
 template <class Impl>
@@ -138,7 +147,10 @@ O3ThreadContext<Impl>::activatefutex()
 
     thread->lastActivate = curTick();
     thread->setStatus(ThreadContext::ActiveFutex);
-    cpu->activateContext(thread->threadId());
+    ThreadID tid = thread->threadId();
+    runOnEventQueue(cpu->eventQueue(), [this, tid] {
+        cpu->activateContext(tid);
+    });
 }
 
 template <class Impl>
@@ -156,7 +168,10 @@ O3ThreadContext<Impl>::suspendfutex()
     thread->lastSuspend = curTick();
 
     thread->setStatus(ThreadContext::SuspendedFutex);
-    cpu->suspendContext(thread->threadId());
+    ThreadID tid = thread->threadId();
+    runOnEventQueue(cpu->eventQueue(), [this, tid] {
+        cpu->suspendContext(tid);
+    });
 }
 
 template <class Impl>
@@ -169,7 +184,10 @@ O3ThreadContext<Impl>::halt()
         return;
 
     thread->setStatus(ThreadContext::Halted);
-    cpu->haltContext(thread->threadId());
+    ThreadID tid = thread->threadId();
+    runOnEventQueue(cpu->eventQueue(), [this, tid] {
+        cpu->haltContext(tid);
+    });
 }
 
 template <class Impl>
@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pipe_trace.hh"
+
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+
+using namespace std;
+
+namespace
+{
+
+const char magic[8] = { 'g', 'e', 'm', '5', 'p', 'i', 'p', 'e' };
+const uint64_t version = 1;
+
+/** Records are written out in blocks of about this many bytes. */
+const size_t flushSize = 64 * 1024;
+
+void
+putVar(string &buf, uint64_t val)
+{
+    while (val >= 0x80) {
+        buf.push_back(char(val | 0x80));
+        val >>= 7;
+    }
+    buf.push_back(char(val));
+}
+
+/** Signed deltas are stored zigzag encoded, so small ones stay short. */
+void
+putDelta(string &buf, uint64_t cur, uint64_t prev)
+{
+    int64_t delta = int64_t(cur - prev);
+    putVar(buf, (uint64_t(delta) << 1) ^ uint64_t(delta >> 63));
+}
+
+uint64_t
+applyDelta(uint64_t prev, uint64_t zigzag)
+{
+    return prev + ((zigzag >> 1) ^ -(zigzag & 1));
+}
+
+void
+putString(string &buf, const string &str)
+{
+    putVar(buf, str.size());
+    buf.append(str);
+}
+
+} // anonymous namespace
+
+PipeTrace::PipeTrace(ostream &_os, Tick clock_period,
+                     const vector<string> &op_classes,
+                     const vector<string> &fus)
+    : os(_os)
+{
+    buf.append(magic, sizeof(magic));
+    putVar(buf, version);
+    putVar(buf, clock_period);
+    putVar(buf, op_classes.size());
+    for (const auto &name : op_classes)
+        putString(buf, name);
+    putVar(buf, fus.size());
+    for (const auto &name : fus)
+        putString(buf, name);
+}
+
+PipeTrace::~PipeTrace()
+{
+    flush();
+}
+
+void
+PipeTrace::setWindow(Tick start, Tick end, Counter start_inst,
+                     Counter end_inst)
+{
+    startTick = start;
+    endTick = end;
+    startInst = start_inst;
+    endInst = end_inst;
+}
+
+void
+PipeTrace::addText(const string &text)
+{
+    buf.push_back('T');
+    putString(buf, text);
+}
+
+void
+PipeTrace::record(const Record &rec)
+{
+    buf.push_back('I');
+    putDelta(buf, rec.seqNum, last.seqNum);
+    putDelta(buf, rec.pc, last.pc);
+    putVar(buf, rec.upc);
+    buf.push_back(char(rec.thread));
+    buf.push_back(char(rec.flags));
+    buf.push_back(char(rec.opClass));
+    putVar(buf, rec.fu + 1);
+    putDelta(buf, rec.text, last.text);
+    putDelta(buf, rec.fetch, last.fetch);
+    for (int s = 0; s < NumStages; ++s)
+        putVar(buf, uint32_t(rec.stage[s] + 1));
+    putVar(buf, uint32_t(rec.end));
+    if (rec.flags & Predicated) {
+        putVar(buf, rec.activeElems);
+        putVar(buf, rec.vecElems);
+    }
+    last = rec;
+
+    if (buf.size() >= flushSize)
+        flush();
+}
+
+void
+PipeTrace::flush()
+{
+    os.write(buf.data(), buf.size());
+    os.flush();
+    buf.clear();
+}
+
+PipeTraceReader::PipeTraceReader(istream &_is)
+    : is(_is), ok(false), period(1)
+{
+    char file_magic[sizeof(magic)];
+    uint64_t file_version, count;
+    if (!is.read(file_magic, sizeof(magic)) ||
+        memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+        !readVar(file_version) || file_version != version ||
+        !readVar(period) || period == 0 || !readVar(count)) {
+        return;
+    }
+    opClasses.resize(count);
+    for (auto &name : opClasses) {
+        if (!readString(name))
+            return;
+    }
+    if (!readVar(count))
+        return;
+    fus.resize(count);
+    for (auto &name : fus) {
+        if (!readString(name))
+            return;
+    }
+    ok = true;
+}
+
+bool
+PipeTraceReader::readVar(uint64_t &val)
+{
+    val = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = is.get();
+        if (c == EOF)
+            return false;
+        val |= uint64_t(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool
+PipeTraceReader::readString(string &str)
+{
+    uint64_t len;
+    if (!readVar(len))
+        return false;
+    str.resize(len);
+    return len == 0 || is.read(&str[0], len);
+}
+
+bool
+PipeTraceReader::next(PipeTrace::Record &rec)
+{
+    if (!ok)
+        return false;
+
+    while (true) {
+        int type = is.get();
+        if (type == EOF)
+            return false;
+
+        // Any failure from here on is a truncated or corrupt trace.
+        ok = false;
+        if (type == 'T') {
+            texts.emplace_back();
+            if (!readString(texts.back()))
+                return false;
+            ok = true;
+            continue;
+        }
+        if (type != 'I')
+            return false;
+
+        uint64_t val;
+        char bytes[3];
+        rec = last;
+        if (!readVar(val))
+            return false;
+        rec.seqNum = applyDelta(last.seqNum, val);
+        if (!readVar(val))
+            return false;
+        rec.pc = applyDelta(last.pc, val);
+        if (!readVar(val))
+            return false;
+        rec.upc = val;
+        if (!is.read(bytes, sizeof(bytes)))
+            return false;
+        rec.thread = bytes[0];
+        rec.flags = bytes[1];
+        rec.opClass = bytes[2];
+        if (!readVar(val))
+            return false;
+        rec.fu = int(val) - 1;
+        if (!readVar(val))
+            return false;
+        rec.text = applyDelta(last.text, val);
+        if (rec.text >= texts.size())
+            return false;
+        if (!readVar(val))
+            return false;
+        rec.fetch = applyDelta(last.fetch, val);
+        for (int s = 0; s < PipeTrace::NumStages; ++s) {
+            if (!readVar(val))
+                return false;
+            rec.stage[s] = int32_t(val) - 1;
+        }
+        if (!readVar(val))
+            return false;
+        rec.end = val;
+        rec.activeElems = rec.vecElems = 0;
+        if (rec.flags & PipeTrace::Predicated) {
+            if (!readVar(val))
+                return false;
+            rec.activeElems = val;
+            if (!readVar(val))
+                return false;
+            rec.vecElems = val;
+        }
+        last = rec;
+        ok = true;
+        return true;
+    }
+}
+
+const string &
+PipeTraceReader::text(uint32_t id) const
+{
+    return texts.at(id);
+}
+
+const string &
+PipeTraceReader::opClassName(unsigned op_class) const
+{
+    static const string unknown("?");
+    return op_class < opClasses.size() ? opClasses[op_class] : unknown;
+}
+
+const string &
+PipeTraceReader::fuName(int fu) const
+{
+    static const string none;
+    return fu >= 0 && fu < int(fus.size()) ? fus[fu] : none;
+}
+
+bool
+pipeTraceToO3PipeView(istream &is, ostream &os)
+{
+    PipeTraceReader reader(is);
+    if (!reader.valid())
+        return false;
+
+    PipeTrace::Record rec;
+    while (reader.next(rec)) {
+        ccprintf(os, "O3PipeView:fetch:%llu:0x%08llx:%d:%llu:%s\n",
+                 rec.fetch, rec.pc, rec.upc, rec.seqNum,
+                 reader.text(rec.text));
+        ccprintf(os, "O3PipeView:decode:%llu\n",
+                 rec.stageTick(PipeTrace::Decode));
+        ccprintf(os, "O3PipeView:rename:%llu\n",
+                 rec.stageTick(PipeTrace::Rename));
+        ccprintf(os, "O3PipeView:dispatch:%llu\n",
+                 rec.stageTick(PipeTrace::Dispatch));
+        ccprintf(os, "O3PipeView:issue:%llu\n",
+                 rec.stageTick(PipeTrace::Issue));
+        ccprintf(os, "O3PipeView:complete:%llu\n",
+                 rec.stageTick(PipeTrace::Complete));
+        ccprintf(os, "O3PipeView:retire:%llu:store:%llu\n",
+                 rec.stageTick(PipeTrace::Retire),
+                 rec.stageTick(PipeTrace::Store));
+    }
+    return !reader.truncated();
+}
+
+namespace
+{
+
+/** Konata stage names, fetch first and then PipeTrace::Stage order. */
+const char *const konataStages[] = {
+    "F", "Dc", "Rn", "Ds", "Is", "Cm", "Rt", "St"
+};
+
+/** Replace the characters that would break a Konata line. */
+string
+konataLabel(string str)
+{
+    for (auto &c : str) {
+        if (c == '\t' || c == '\n')
+            c = ' ';
+    }
+    return str;
+}
+
+/** One line of a Konata log, due at a given cycle. */
+struct KonataEvent
+{
+    enum Kind { Start, StageStart, StageEnd, Retire, Flush };
+
+    uint64_t cycle;
+    uint64_t id;
+    /** Orders the events of one instruction within a cycle. */
+    unsigned step;
+    Kind kind;
+    /** Index into konataStages. */
+    unsigned stage;
+
+    bool
+    operator>(const KonataEvent &other) const
+    {
+        if (cycle != other.cycle)
+            return cycle > other.cycle;
+        if (id != other.id)
+            return id > other.id;
+        return step > other.step;
+    }
+};
+
+class KonataWriter
+{
+  public:
+    KonataWriter(const PipeTraceReader &_reader, ostream &_os)
+        : reader(_reader), os(_os)
+    {
+        os << "Kanata\t0004\n";
+    }
+
+    /** Queue the events of the next instruction in fetch order. */
+    void
+    add(const PipeTrace::Record &rec)
+    {
+        uint64_t id = nextId++;
+        auto tick_cycle = [this](Tick tick) {
+            uint64_t c = tick / reader.clockPeriod();
+            if (started && c < cycle) {
+                ++late;
+                return cycle;
+            }
+            return c;
+        };
+
+        unsigned step = 0;
+        uint64_t start = tick_cycle(rec.fetch);
+        events.push({ start, id, step++, KonataEvent::Start, 0 });
+
+        // Each stage lasts until the next one the instruction entered.
+        unsigned stage = 0;
+        uint64_t stage_cycle = start;
+        for (int s = 0; s < PipeTrace::NumStages; ++s) {
+            if (rec.stage[s] == -1)
+                continue;
+            uint64_t c = max(stage_cycle, tick_cycle(rec.stageTick(s)));
+            events.push({ c, id, step++, KonataEvent::StageEnd, stage });
+            stage = s + 1;
+            stage_cycle = c;
+            events.push({ c, id, step++, KonataEvent::StageStart, stage });
+        }
+
+        bool committed = rec.flags & PipeTrace::Committed;
+        uint64_t end = committed ? stage_cycle :
+            max(stage_cycle, tick_cycle(rec.fetch + rec.end));
+        events.push({ end, id, step++, KonataEvent::StageEnd, stage });
+        events.push({ end, id, step++, committed ? KonataEvent::Retire :
+                      KonataEvent::Flush, 0 });
+        live.emplace(id, rec);
+    }
+
+    /** Write all queued events due up to and including cycle c. */
+    void
+    emit(uint64_t c)
+    {
+        while (!events.empty() && events.top().cycle <= c)
+            write();
+    }
+
+    void
+    emitAll()
+    {
+        while (!events.empty())
+            write();
+    }
+
+    /** Number of events moved to a later cycle to keep the order. */
+    uint64_t lateEvents() const { return late; }
+
+  private:
+    void
+    write()
+    {
+        KonataEvent ev = events.top();
+        events.pop();
+
+        if (!started) {
+            ccprintf(os, "C=\t%d\n", ev.cycle);
+            cycle = ev.cycle;
+            started = true;
+        } else if (ev.cycle > cycle) {
+            ccprintf(os, "C\t%d\n", ev.cycle - cycle);
+            cycle = ev.cycle;
+        }
+
+        switch (ev.kind) {
+          case KonataEvent::Start: {
+            const PipeTrace::Record &rec = live.at(ev.id);
+            ccprintf(os, "I\t%d\t%d\t%d\n", ev.id, rec.seqNum, rec.thread);
+            string label = konataLabel(reader.text(rec.text));
+            if (rec.flags & PipeTrace::IsMicroop)
+                ccprintf(os, "L\t%d\t0\t%#x.%d: %s\n", ev.id, rec.pc,
+                         rec.upc, label);
+            else
+                ccprintf(os, "L\t%d\t0\t%#x: %s\n", ev.id, rec.pc, label);
+            ccprintf(os, "L\t%d\t1\tsn:%d %s", ev.id, rec.seqNum,
+                     reader.opClassName(rec.opClass));
+            if (rec.fu >= 0)
+                ccprintf(os, " fu:%s", konataLabel(reader.fuName(rec.fu)));
+            if (rec.flags & PipeTrace::Predicated)
+                ccprintf(os, " active:%d/%d", rec.activeElems,
+                         rec.vecElems);
+            os << "\n";
+            ccprintf(os, "S\t%d\t0\t%s\n", ev.id, konataStages[0]);
+            break;
+          }
+          case KonataEvent::StageStart:
+            ccprintf(os, "S\t%d\t0\t%s\n", ev.id, konataStages[ev.stage]);
+            break;
+          case KonataEvent::StageEnd:
+            ccprintf(os, "E\t%d\t0\t%s\n", ev.id, konataStages[ev.stage]);
+            break;
+          case KonataEvent::Retire:
+          case KonataEvent::Flush:
+            ccprintf(os, "R\t%d\t%d\t%d\n", ev.id, retired++,
+                     ev.kind == KonataEvent::Flush ? 1 : 0);
+            live.erase(ev.id);
+            break;
+        }
+    }
+
+    const PipeTraceReader &reader;
+    ostream &os;
+
+    priority_queue<KonataEvent, vector<KonataEvent>,
+                   greater<KonataEvent>> events;
+    /** Instructions that have not been retired or flushed yet. */
+    unordered_map<uint64_t, PipeTrace::Record> live;
+
+    uint64_t nextId = 0;
+    uint64_t retired = 0;
+    uint64_t cycle = 0;
+    bool started = false;
+    uint64_t late = 0;
+};
+
+/** Orders records by fetch tick, oldest on top. */
+struct FetchOrder
+{
+    bool
+    operator()(const PipeTrace::Record &a, const PipeTrace::Record &b) const
+    {
+        if (a.fetch != b.fetch)
+            return a.fetch > b.fetch;
+        return a.seqNum > b.seqNum;
+    }
+};
+
+} // anonymous namespace
+
+bool
+pipeTraceToKonata(istream &is, ostream &os, size_t reorder_window)
+{
+    PipeTraceReader reader(is);
+    if (!reader.valid())
+        return false;
+
+    KonataWriter writer(reader, os);
+    priority_queue<PipeTrace::Record, vector<PipeTrace::Record>,
+                   FetchOrder> pending;
+
+    // Later instructions are assumed to be fetched no earlier than the
+    // oldest one that leaves the window, so everything up to its fetch
+    // cycle can be written.
+    auto release = [&]() {
+        PipeTrace::Record rec = pending.top();
+        pending.pop();
+        writer.add(rec);
+        writer.emit(rec.fetch / reader.clockPeriod());
+    };
+
+    PipeTrace::Record rec;
+    while (reader.next(rec)) {
+        pending.push(rec);
+        if (pending.size() > reorder_window)
+            release();
+    }
+    while (!pending.empty())
+        release();
+    writer.emitAll();
+
+    warn_if(writer.lateEvents(), "%d Konata events were further out of "
+            "order than the reorder window and were delayed\n",
+            writer.lateEvents());
+    return !reader.truncated();
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PIPE_TRACE_HH__
+#define __CPU_PIPE_TRACE_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+
+/**
+ * Binary per-instruction pipeline trace of the O3 CPU. It holds the
+ * same information as the O3PipeView debug flag, plus the functional
+ * unit and the SVE predicate activity, in about 25 bytes per
+ * instruction instead of about 300.
+ *
+ * The file starts with the magic "gem5pipe", a version number, the
+ * CPU clock period and the op class and functional unit names. After
+ * that come records, each introduced by one type byte:
+ *  - 'T': a new disassembly string, numbered in order of appearance;
+ *  - 'I': one instruction, with its fields stored as deltas against
+ *    the previous instruction in LEB128 varints.
+ *
+ * Instructions are written when they are destroyed, as the
+ * O3PipeView flag prints them, so squashed instructions are included
+ * and stores carry the tick their data left the store queue.
+ */
+class PipeTrace
+{
+  public:
+    /** Pipeline stages after fetch, in order. */
+    enum Stage {
+        Decode,
+        Rename,
+        Dispatch,
+        Issue,
+        Complete,
+        Retire,
+        Store,
+        NumStages
+    };
+
+    enum Flags : uint8_t {
+        /** The instruction was committed rather than squashed. */
+        Committed = 0x01,
+        IsLoad = 0x02,
+        IsStore = 0x04,
+        IsVector = 0x08,
+        /** activeElems and vecElems are valid. */
+        Predicated = 0x10,
+        IsMicroop = 0x20,
+        IsLastMicroop = 0x40,
+    };
+
+    struct Record
+    {
+        InstSeqNum seqNum = 0;
+        Addr pc = 0;
+        uint16_t upc = 0;
+        uint8_t thread = 0;
+        uint8_t flags = 0;
+        uint8_t opClass = 0;
+        /** Functional unit index, -1 if the instruction used none. */
+        int16_t fu = -1;
+        /** Number of the disassembly string, see PipeTrace::textId. */
+        uint32_t text = 0;
+        Tick fetch = 0;
+        /** Ticks after fetch each stage was entered, -1 if never. */
+        int32_t stage[NumStages];
+        /** Ticks after fetch the record was written. */
+        int32_t end = 0;
+        uint16_t activeElems = 0;
+        uint16_t vecElems = 0;
+
+        Record() { std::fill(stage, stage + NumStages, -1); }
+
+        /** Absolute tick of a stage, 0 if it was never entered. */
+        Tick
+        stageTick(int s) const
+        {
+            return stage[s] == -1 ? 0 : fetch + stage[s];
+        }
+    };
+
+    /**
+     * @param os Stream the trace is written to.
+     * @param clock_period CPU clock period in ticks.
+     * @param op_classes Names of the op classes, by number.
+     * @param fus Names of the functional units, by index.
+     */
+    PipeTrace(std::ostream &os, Tick clock_period,
+              const std::vector<std::string> &op_classes,
+              const std::vector<std::string> &fus);
+    ~PipeTrace();
+
+    /**
+     * Limit the capture to instructions fetched in [start, end) ticks
+     * and while the committed instruction count is in
+     * [start_inst, end_inst). An end_inst of 0 means no limit.
+     */
+    void setWindow(Tick start, Tick end, Counter start_inst,
+                   Counter end_inst);
+
+    /** Whether an instruction fetched now should be traced. */
+    bool
+    capturing(Tick now, Counter insts) const
+    {
+        return now >= startTick && now < endTick &&
+               insts >= startInst && (!endInst || insts < endInst);
+    }
+
+    /**
+     * Number of the disassembly of the static instruction key at pc.
+     * disassemble() is only called the first time the pair is seen,
+     * so key must stay valid as long as the trace is open. The decode
+     * caches keep their static instructions for the whole simulation.
+     */
+    template <class F>
+    uint32_t
+    textId(const void *key, Addr pc, F &&disassemble)
+    {
+        auto it = texts.find(std::make_pair(pc, key));
+        if (it != texts.end())
+            return it->second;
+        uint32_t id = texts.size();
+        texts.emplace(std::make_pair(pc, key), id);
+        addText(disassemble());
+        return id;
+    }
+
+    void record(const Record &rec);
+
+    /** Write buffered records to the stream. */
+    void flush();
+
+  private:
+    void addText(const std::string &text);
+
+    std::ostream &os;
+    std::string buf;
+    std::map<std::pair<Addr, const void *>, uint32_t> texts;
+    Record last;
+
+    Tick startTick = 0;
+    Tick endTick = MaxTick;
+    Counter startInst = 0;
+    Counter endInst = 0;
+};
+
+/** Reads back a trace written by PipeTrace. */
+class PipeTraceReader
+{
+  public:
+    /** Reads the header. Check valid() before reading records. */
+    explicit PipeTraceReader(std::istream &is);
+
+    bool valid() const { return ok; }
+
+    /**
+     * Read the next instruction. Returns false at the end of the
+     * trace; truncated() then tells whether the file ended in the
+     * middle of a record.
+     */
+    bool next(PipeTrace::Record &rec);
+    bool truncated() const { return !ok; }
+
+    Tick clockPeriod() const { return period; }
+    const std::string &text(uint32_t id) const;
+    const std::string &opClassName(unsigned op_class) const;
+    /** Name of a functional unit, empty if fu is -1. */
+    const std::string &fuName(int fu) const;
+
+  private:
+    bool readVar(uint64_t &val);
+    bool readString(std::string &str);
+
+    std::istream &is;
+    bool ok;
+    Tick period;
+    std::vector<std::string> opClasses;
+    std::vector<std::string> fus;
+    std::vector<std::string> texts;
+    PipeTrace::Record last;
+};
+
+/**
+ * Write the instructions of a trace in the format of the O3PipeView
+ * debug flag, for util/o3-pipeview.py.
+ * @return False if the trace is malformed or truncated.
+ */
+bool pipeTraceToO3PipeView(std::istream &is, std::ostream &os);
+
+/**
+ * Write the instructions of a trace as a Konata log. Instructions are
+ * numbered in fetch order. The trace is nearly in fetch order already,
+ * and reorder_window instructions are buffered to sort it; an
+ * instruction further out of order is shown at the earliest cycle
+ * still possible and reported with a warning.
+ * @return False if the trace is malformed or truncated.
+ */
+bool pipeTraceToKonata(std::istream &is, std::ostream &os,
+                       size_t reorder_window = 65536);
+
+#endif // __CPU_PIPE_TRACE_HH__
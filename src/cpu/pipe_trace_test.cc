@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "cpu/pipe_trace.hh"
+
+namespace {
+
+const Tick period = 500;
+
+/**
+ * A made-up O3 run: four instructions fetched per cycle, some of them
+ * squashed, and records written when the instructions would be
+ * destroyed. Stores leave the store queue after commit, so the
+ * records are slightly out of fetch order, as in a real trace.
+ */
+struct FakeRun
+{
+    std::vector<PipeTrace::Record> records;
+    std::vector<std::string> texts;
+
+    explicit FakeRun(int insts, unsigned seed = 1)
+    {
+        std::mt19937 rng(seed);
+        std::multimap<Tick, PipeTrace::Record> by_end;
+        Tick commit = 0;
+        for (int i = 0; i < insts; ++i) {
+            PipeTrace::Record rec;
+            rec.seqNum = i + 1;
+            rec.pc = 0x400000 + (i % 37) * 4;
+            rec.upc = i % 3 == 2 ? 1 : 0;
+            rec.thread = 0;
+            rec.opClass = rng() % 8;
+            rec.text = i % 37;
+            rec.fetch = (1000 + i / 4) * period;
+            int32_t t = 0;
+            bool squashed = rng() % 10 == 0;
+            int reached = squashed ? int(rng() % PipeTrace::Retire) :
+                int(PipeTrace::Retire);
+            for (int s = 0; s <= reached; ++s) {
+                t += (1 + rng() % 3) * period;
+                rec.stage[s] = t;
+            }
+            if (squashed) {
+                rec.end = t + period;
+            } else {
+                // Commit is in order.
+                Tick c = std::max(rec.fetch + t, commit);
+                commit = c;
+                rec.stage[PipeTrace::Retire] = c - rec.fetch;
+                rec.flags |= PipeTrace::Committed;
+                rec.end = c - rec.fetch;
+                if (rng() % 4 == 0) {
+                    rec.flags |= PipeTrace::IsStore;
+                    rec.stage[PipeTrace::Store] =
+                        rec.end + (1 + rng() % 20) * period;
+                    rec.end = rec.stage[PipeTrace::Store];
+                }
+            }
+            if (rng() % 3 == 0) {
+                rec.flags |= PipeTrace::Predicated | PipeTrace::IsVector;
+                rec.vecElems = 8;
+                rec.activeElems = rng() % 9;
+            }
+            rec.fu = rng() % 5 - 1;
+            by_end.emplace(rec.fetch + rec.end, rec);
+        }
+        for (const auto &kv : by_end)
+            records.push_back(kv.second);
+        for (int i = 0; i < 37; ++i)
+            texts.push_back(csprintf("op%d   x%d, x%d", i, i, i + 1));
+    }
+
+    std::string
+    write() const
+    {
+        std::ostringstream os;
+        PipeTrace trace(os, period, {"IntAlu", "FloatAdd", "SimdFloatAdd",
+                        "MemRead", "MemWrite", "SveMemRead", "SveMemWrite",
+                        "IntMult"},
+                        {"FU0(0)", "FU1(0)", "FU2(0)", "FU3(0)"});
+        for (auto rec : records) {
+            const std::string &text = texts[rec.text];
+            rec.text = trace.textId(&texts[rec.text], rec.pc,
+                                    [&text]() { return text; });
+            trace.record(rec);
+        }
+        trace.flush();
+        return os.str();
+    }
+};
+
+/** O3PipeView text as ~BaseO3DynInst prints it. */
+std::string
+o3PipeView(const PipeTrace::Record &rec, const std::string &text)
+{
+    std::ostringstream os;
+    auto val = [&rec](int s) -> Tick {
+        return rec.stage[s] == -1 ? 0 : rec.fetch + rec.stage[s];
+    };
+    ccprintf(os, "O3PipeView:fetch:%llu:0x%08llx:%d:%llu:%s\n",
+             rec.fetch, rec.pc, rec.upc, rec.seqNum, text);
+    ccprintf(os, "O3PipeView:decode:%llu\n", val(PipeTrace::Decode));
+    ccprintf(os, "O3PipeView:rename:%llu\n", val(PipeTrace::Rename));
+    ccprintf(os, "O3PipeView:dispatch:%llu\n", val(PipeTrace::Dispatch));
+    ccprintf(os, "O3PipeView:issue:%llu\n", val(PipeTrace::Issue));
+    ccprintf(os, "O3PipeView:complete:%llu\n", val(PipeTrace::Complete));
+    ccprintf(os, "O3PipeView:retire:%llu:store:%llu\n",
+             val(PipeTrace::Retire), val(PipeTrace::Store));
+    return os.str();
+}
+
+} // anonymous namespace
+
+TEST(PipeTraceTest, RoundTrip)
+{
+    FakeRun run(5000);
+    std::istringstream is(run.write());
+    PipeTraceReader reader(is);
+    ASSERT_TRUE(reader.valid());
+    EXPECT_EQ(period, reader.clockPeriod());
+    EXPECT_EQ("SimdFloatAdd", reader.opClassName(2));
+    EXPECT_EQ("FU3(0)", reader.fuName(3));
+    EXPECT_EQ("", reader.fuName(-1));
+
+    PipeTrace::Record rec;
+    for (const auto &exp : run.records) {
+        ASSERT_TRUE(reader.next(rec));
+        EXPECT_EQ(exp.seqNum, rec.seqNum);
+        EXPECT_EQ(exp.pc, rec.pc);
+        EXPECT_EQ(exp.upc, rec.upc);
+        EXPECT_EQ(exp.thread, rec.thread);
+        EXPECT_EQ(exp.flags, rec.flags);
+        EXPECT_EQ(exp.opClass, rec.opClass);
+        EXPECT_EQ(exp.fu, rec.fu);
+        EXPECT_EQ(run.texts[exp.text], reader.text(rec.text));
+        EXPECT_EQ(exp.fetch, rec.fetch);
+        for (int s = 0; s < PipeTrace::NumStages; ++s)
+            EXPECT_EQ(exp.stage[s], rec.stage[s]);
+        EXPECT_EQ(exp.end, rec.end);
+        EXPECT_EQ(exp.activeElems, rec.activeElems);
+        EXPECT_EQ(exp.vecElems, rec.vecElems);
+        if (::testing::Test::HasFailure())
+            return;
+    }
+    EXPECT_FALSE(reader.next(rec));
+    EXPECT_FALSE(reader.truncated());
+}
+
+TEST(PipeTraceTest, TextInterning)
+{
+    std::ostringstream os;
+    PipeTrace trace(os, period, {}, {});
+    int a, b, calls = 0;
+    auto disassemble = [&calls]() { ++calls; return std::string("nop"); };
+    EXPECT_EQ(0, trace.textId(&a, 0x100, disassemble));
+    EXPECT_EQ(1, trace.textId(&b, 0x100, disassemble));
+    EXPECT_EQ(2, trace.textId(&a, 0x104, disassemble));
+    EXPECT_EQ(0, trace.textId(&a, 0x100, disassemble));
+    EXPECT_EQ(1, trace.textId(&b, 0x100, disassemble));
+    EXPECT_EQ(3, calls);
+}
+
+TEST(PipeTraceTest, Window)
+{
+    std::ostringstream os;
+    PipeTrace trace(os, period, {}, {});
+    EXPECT_TRUE(trace.capturing(0, 0));
+    EXPECT_TRUE(trace.capturing(MaxTick - 1, 1000000));
+
+    trace.setWindow(1000, 2000, 0, 0);
+    EXPECT_FALSE(trace.capturing(999, 0));
+    EXPECT_TRUE(trace.capturing(1000, 0));
+    EXPECT_TRUE(trace.capturing(1999, 50));
+    EXPECT_FALSE(trace.capturing(2000, 0));
+
+    trace.setWindow(0, MaxTick, 100, 200);
+    EXPECT_FALSE(trace.capturing(5000, 99));
+    EXPECT_TRUE(trace.capturing(5000, 100));
+    EXPECT_TRUE(trace.capturing(5000, 199));
+    EXPECT_FALSE(trace.capturing(5000, 200));
+}
+
+TEST(PipeTraceTest, Truncated)
+{
+    FakeRun run(100);
+    std::string bin = run.write();
+
+    std::istringstream bad_magic("gem5pipX" + bin.substr(8));
+    EXPECT_FALSE(PipeTraceReader(bad_magic).valid());
+
+    std::istringstream is(bin.substr(0, bin.size() - 3));
+    PipeTraceReader reader(is);
+    ASSERT_TRUE(reader.valid());
+    PipeTrace::Record rec;
+    int n = 0;
+    while (reader.next(rec))
+        ++n;
+    EXPECT_EQ(99, n);
+    EXPECT_TRUE(reader.truncated());
+
+    std::istringstream in(bin.substr(0, bin.size() - 3));
+    std::ostringstream out;
+    EXPECT_FALSE(pipeTraceToO3PipeView(in, out));
+}
+
+TEST(PipeTraceTest, O3PipeView)
+{
+    FakeRun run(2000);
+    std::string expected;
+    for (const auto &rec : run.records)
+        expected += o3PipeView(rec, run.texts[rec.text]);
+
+    std::istringstream is(run.write());
+    std::ostringstream os;
+    ASSERT_TRUE(pipeTraceToO3PipeView(is, os));
+    EXPECT_EQ(expected, os.str());
+}
+
+TEST(PipeTraceTest, KonataSmall)
+{
+    std::ostringstream bin;
+    {
+        PipeTrace trace(bin, period, {"IntAlu", "SimdFloatAdd"},
+                        {"IntALU(0)", "FLA(0)"});
+        std::string add("add   x1, x2, x3"), fadd("fadd  z0.s, p0/m, z0.s");
+
+        // A squashed instruction, destroyed before the older one.
+        PipeTrace::Record sq;
+        sq.seqNum = 11;
+        sq.pc = 0x1004;
+        sq.fetch = 10 * period;
+        sq.stage[PipeTrace::Decode] = period;
+        sq.end = 3 * period;
+        sq.text = trace.textId(&add, sq.pc, [&add]() { return add; });
+
+        PipeTrace::Record rec;
+        rec.seqNum = 10;
+        rec.pc = 0x1000;
+        rec.flags = PipeTrace::Committed | PipeTrace::Predicated;
+        rec.opClass = 1;
+        rec.fu = 1;
+        rec.activeElems = 3;
+        rec.vecElems = 16;
+        rec.fetch = 10 * period;
+        rec.stage[PipeTrace::Decode] = period;
+        rec.stage[PipeTrace::Rename] = 2 * period;
+        rec.stage[PipeTrace::Dispatch] = 3 * period;
+        rec.stage[PipeTrace::Issue] = 5 * period;
+        rec.stage[PipeTrace::Complete] = 9 * period;
+        rec.stage[PipeTrace::Retire] = 10 * period;
+        rec.end = 10 * period;
+        rec.text = trace.textId(&fadd, rec.pc, [&fadd]() { return fadd; });
+
+        trace.record(sq);
+        trace.record(rec);
+    }
+
+    std::istringstream is(bin.str());
+    std::ostringstream os;
+    ASSERT_TRUE(pipeTraceToKonata(is, os));
+    EXPECT_EQ("Kanata\t0004\n"
+              "C=\t10\n"
+              "I\t0\t10\t0\n"
+              "L\t0\t0\t0x1000: fadd  z0.s, p0/m, z0.s\n"
+              "L\t0\t1\tsn:10 SimdFloatAdd fu:FLA(0) active:3/16\n"
+              "S\t0\t0\tF\n"
+              "I\t1\t11\t0\n"
+              "L\t1\t0\t0x1004: add   x1, x2, x3\n"
+              "L\t1\t1\tsn:11 IntAlu\n"
+              "S\t1\t0\tF\n"
+              "C\t1\n"
+              "E\t0\t0\tF\n"
+              "S\t0\t0\tDc\n"
+              "E\t1\t0\tF\n"
+              "S\t1\t0\tDc\n"
+              "C\t1\n"
+              "E\t0\t0\tDc\n"
+              "S\t0\t0\tRn\n"
+              "C\t1\n"
+              "E\t0\t0\tRn\n"
+              "S\t0\t0\tDs\n"
+              "E\t1\t0\tDc\n"
+              "R\t1\t0\t1\n"
+              "C\t2\n"
+              "E\t0\t0\tDs\n"
+              "S\t0\t0\tIs\n"
+              "C\t4\n"
+              "E\t0\t0\tIs\n"
+              "S\t0\t0\tCm\n"
+              "C\t1\n"
+              "E\t0\t0\tCm\n"
+              "S\t0\t0\tRt\n"
+              "E\t0\t0\tRt\n"
+              "R\t0\t1\t0\n", os.str());
+}
+
+/**
+ * Check that a Konata log is well formed and that every instruction
+ * went through the stages of its record.
+ */
+TEST(PipeTraceTest, KonataLarge)
+{
+    FakeRun run(20000, 7);
+    std::vector<PipeTrace::Record> by_fetch(run.records);
+    std::stable_sort(by_fetch.begin(), by_fetch.end(),
+        [](const PipeTrace::Record &a, const PipeTrace::Record &b) {
+            return a.fetch != b.fetch ? a.fetch < b.fetch :
+                a.seqNum < b.seqNum;
+        });
+
+    std::istringstream is(run.write());
+    std::ostringstream os;
+    ASSERT_TRUE(pipeTraceToKonata(is, os, 256));
+
+    std::istringstream log(os.str());
+    std::string line;
+    ASSERT_TRUE(std::getline(log, line));
+    EXPECT_EQ("Kanata\t0004", line);
+
+    struct Seen
+    {
+        Tick start = 0;
+        std::string stages;
+        bool open = false;
+        int retire = -1;
+    };
+    std::vector<Seen> seen(by_fetch.size());
+    Tick cycle = 0;
+    uint64_t next_id = 0;
+    int retired = 0;
+    while (std::getline(log, line)) {
+        std::istringstream fields(line);
+        std::string cmd;
+        uint64_t id, a;
+        std::string stage;
+        fields >> cmd;
+        if (cmd == "C=") {
+            fields >> cycle;
+            continue;
+        }
+        if (cmd == "C") {
+            fields >> a;
+            ASSERT_GT(a, 0);
+            cycle += a;
+            continue;
+        }
+        fields >> id;
+        ASSERT_LT(id, seen.size());
+        Seen &s = seen[id];
+        if (cmd == "I") {
+            ASSERT_EQ(next_id++, id);
+            fields >> a;
+            EXPECT_EQ(by_fetch[id].seqNum, a);
+            s.start = cycle;
+            continue;
+        }
+        ASSERT_EQ(-1, s.retire) << line;
+        if (cmd == "S") {
+            ASSERT_FALSE(s.open) << line;
+            fields >> a >> stage;
+            s.stages += stage + " ";
+            s.open = true;
+        } else if (cmd == "E") {
+            ASSERT_TRUE(s.open) << line;
+            s.open = false;
+        } else if (cmd == "R") {
+            ASSERT_FALSE(s.open) << line;
+            fields >> a;
+            EXPECT_EQ(retired++, a);
+            fields >> s.retire;
+        } else {
+            ASSERT_EQ("L", cmd);
+        }
+    }
+
+    const char *names[] = { "Dc", "Rn", "Ds", "Is", "Cm", "Rt", "St" };
+    for (size_t id = 0; id < by_fetch.size(); ++id) {
+        const PipeTrace::Record &rec = by_fetch[id];
+        std::string stages = "F ";
+        for (int s = 0; s < PipeTrace::NumStages; ++s) {
+            if (rec.stage[s] != -1)
+                stages += std::string(names[s]) + " ";
+        }
+        EXPECT_EQ(rec.fetch / period, seen[id].start);
+        EXPECT_EQ(stages, seen[id].stages);
+        EXPECT_EQ(rec.flags & PipeTrace::Committed ? 0 : 1,
+                  seen[id].retire);
+        if (::testing::Test::HasFailure())
+            return;
+    }
+}
+
+TEST(PipeTraceTest, SmallerThanText)
+{
+    FakeRun run(20000);
+
+    std::ostringstream bin;
+    {
+        PipeTrace trace(bin, period, {}, {});
+        for (auto rec : run.records) {
+            const std::string &text = run.texts[rec.text];
+            rec.text = trace.textId(&run.texts[rec.text], rec.pc,
+                                    [&text]() { return text; });
+            trace.record(rec);
+        }
+    }
+
+    // What the O3PipeView flag writes for the same instructions.
+    std::ostringstream text;
+    for (const auto &rec : run.records)
+        text << o3PipeView(rec, run.texts[rec.text]);
+
+    ASSERT_LT(bin.str().size() * 5, text.str().size());
+}
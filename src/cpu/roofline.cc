@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/roofline.hh"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/loader/symtab.hh"
+
+using namespace std;
+
+RooflineProfile::Counts &
+RooflineProfile::Counts::operator+=(const Counts &other)
+{
+    insts += other.insts;
+    cycles += other.cycles;
+    flops += other.flops;
+    bytes += other.bytes;
+    activeElems += other.activeElems;
+    vecElems += other.vecElems;
+    return *this;
+}
+
+void
+RooflineProfile::sample(Addr pc, Counter insts, Counter cycles,
+                        Counter flops, Counter bytes, Counter active_elems,
+                        Counter vec_elems)
+{
+    Counts &counts = pcCounts[pc];
+    counts.insts += insts;
+    counts.cycles += cycles;
+    counts.flops += flops;
+    counts.bytes += bytes;
+    counts.activeElems += active_elems;
+    counts.vecElems += vec_elems;
+}
+
+namespace
+{
+
+template <class Key>
+vector<pair<Key, RooflineProfile::Counts>>
+sortByCycles(const vector<pair<Key, RooflineProfile::Counts>> &rows)
+{
+    auto sorted = rows;
+    stable_sort(sorted.begin(), sorted.end(),
+                [](const pair<Key, RooflineProfile::Counts> &a,
+                   const pair<Key, RooflineProfile::Counts> &b)
+                { return a.second.cycles > b.second.cycles; });
+    return sorted;
+}
+
+void
+printRow(ostream &os, const string &label, const RooflineProfile::Counts &c,
+         double cycle_time)
+{
+    double seconds = c.cycles * cycle_time;
+    double ai = c.bytes ? double(c.flops) / c.bytes : 0.0;
+    double gflops = seconds > 0 ? c.flops / seconds * 1e-9 : 0.0;
+    double gbps = seconds > 0 ? c.bytes / seconds * 1e-9 : 0.0;
+    double ipc = c.cycles ? double(c.insts) / c.cycles : 0.0;
+    double lanes = c.vecElems ? 100.0 * c.activeElems / c.vecElems : 0.0;
+
+    ccprintf(os, "%-40s %12d %12d %6.3f %14d %14d %8.3f %10.3f %10.3f",
+             label, c.insts, c.cycles, ipc, c.flops, c.bytes, ai,
+             gflops, gbps);
+    if (c.vecElems)
+        ccprintf(os, " %7.2f\n", lanes);
+    else
+        ccprintf(os, " %7s\n", "-");
+}
+
+void
+printHeader(ostream &os, const char *label)
+{
+    ccprintf(os, "%-40s %12s %12s %6s %14s %14s %8s %10s %10s %7s\n",
+             label, "insts", "cycles", "ipc", "flops", "bytes",
+             "ai", "gflops", "gb/s", "lanes%");
+}
+
+} // anonymous namespace
+
+void
+RooflineProfile::dump(ostream &os, const SymbolTable *symtab,
+                      double cycle_time) const
+{
+    vector<pair<Addr, Counts>> pcs(pcCounts.begin(), pcCounts.end());
+    sort(pcs.begin(), pcs.end(),
+         [](const pair<Addr, Counts> &a, const pair<Addr, Counts> &b)
+         { return a.first < b.first; });
+
+    // PCs are visited in address order, so each symbol lookup can be
+    // skipped while the PC stays below the next symbol.
+    map<string, Counts> funcs;
+    Counts total;
+    string symbol;
+    Addr sym_addr = 0, next_addr = 0;
+    bool have_symbol = false;
+    for (const auto &pc : pcs) {
+        if (!have_symbol || pc.first >= next_addr) {
+            have_symbol = symtab &&
+                symtab->findNearestSymbol(pc.first, symbol, sym_addr,
+                                          next_addr);
+            if (!have_symbol)
+                symbol = "<unknown>";
+        }
+        funcs[symbol] += pc.second;
+        total += pc.second;
+    }
+
+    printHeader(os, "function");
+    vector<pair<string, Counts>> func_rows(funcs.begin(), funcs.end());
+    for (const auto &row : sortByCycles(func_rows))
+        printRow(os, row.first, row.second, cycle_time);
+    printRow(os, "total", total, cycle_time);
+
+    ccprintf(os, "\n");
+    printHeader(os, "pc");
+    for (const auto &row : sortByCycles(pcs)) {
+        string label = csprintf("%#x", row.first);
+        if (symtab && symtab->findNearestSymbol(row.first, symbol,
+                                                sym_addr)) {
+            label += csprintf(" <%s+%#x>", symbol, row.first - sym_addr);
+        }
+        printRow(os, label, row.second, cycle_time);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_ROOFLINE_HH__
+#define __CPU_ROOFLINE_HH__
+
+#include <ostream>
+#include <unordered_map>
+
+#include "base/types.hh"
+
+class SymbolTable;
+
+/**
+ * Per-PC counters for a roofline analysis of the committed instruction
+ * stream. Each committed instruction adds its flops, bytes and
+ * predicate-element counts to its PC. It is also charged the cycles
+ * that passed since the previous commit, so the cycles of a region
+ * are split among the instructions that held up the commit stage.
+ *
+ * dump() rolls the PCs up to the enclosing ELF symbol and prints one
+ * table per function and one per PC, both sorted by cycles.
+ */
+class RooflineProfile
+{
+  public:
+    struct Counts
+    {
+        Counter insts = 0;
+        Counter cycles = 0;
+        Counter flops = 0;
+        Counter bytes = 0;
+        /** Active and total elements of predicated SVE operations. */
+        Counter activeElems = 0;
+        Counter vecElems = 0;
+
+        Counts &operator+=(const Counts &other);
+    };
+
+    /**
+     * Record one committed operation. Micro-ops of one macro-op share
+     * its PC, so only the last one should pass an insts count of 1.
+     */
+    void sample(Addr pc, Counter insts, Counter cycles, Counter flops,
+                Counter bytes, Counter active_elems, Counter vec_elems);
+
+    bool empty() const { return pcCounts.empty(); }
+    void clear() { pcCounts.clear(); }
+
+    /**
+     * Print the per-function and per-PC tables.
+     * @param symtab Symbols used for the roll-up, may be null.
+     * @param cycle_time Length of one CPU cycle in seconds.
+     */
+    void dump(std::ostream &os, const SymbolTable *symtab,
+              double cycle_time) const;
+
+  private:
+    std::unordered_map<Addr, Counts> pcCounts;
+};
+
+#endif // __CPU_ROOFLINE_HH__
@@ -62,6 +62,11 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
     fastmem = Param.Bool(False, "Access memory directly")
+    fast_forward = Param.Bool(False, "Functional fast-forward mode: run " \
+        "batches of instructions per tick and access SE-mode memory " \
+        "through host pointers, bypassing the TLBs and caches")
+    fast_forward_batch = Param.Unsigned(10000, "Maximum number of " \
+        "instructions per tick in fast-forward mode")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
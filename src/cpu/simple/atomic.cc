@@ -43,6 +43,8 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <limits>
+
 #include "arch/locked_mem.hh"
 #include "arch/mmapped_ipr.hh"
 #include "arch/utility.hh"
@@ -55,6 +57,7 @@
 #include "debug/SimpleCPU.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
+#include "mem/page_table.hh"
 #include "mem/physical.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/faults.hh"
@@ -78,17 +81,24 @@ AtomicSimpleCPU::init()
 
 AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
     : BaseSimpleCPU(p),
-      tickEvent([this]{ tick(); }, "AtomicSimpleCPU tick",
-                false, Event::CPU_Tick_Pri),
+      tickEvent([this]{ fastForward ? fastForwardTick() : tick(); },
+                "AtomicSimpleCPU tick", false, Event::CPU_Tick_Pri),
       width(p->width), locked(false),
       simulate_data_stalls(p->simulate_data_stalls),
       simulate_inst_stalls(p->simulate_inst_stalls),
+      fastForward(p->fast_forward),
+      fastForwardBatch(std::max(p->fast_forward_batch, 1u)),
+      hostPagesRemapCount(EmulationPageTable::remapCount()),
+      hostPagesThread(0),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       fastmem(p->fastmem), dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
+
+    fatal_if(fastForward && FullSystem,
+             "%s: fast-forward mode is only supported in SE mode\n", name());
 }
 
 
@@ -149,6 +159,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // memory may have been remapped while we were not running
+    flushHostPages();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -207,6 +220,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *oldCPU)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    flushHostPages();
 }
 
 void
@@ -367,6 +382,15 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
     SimpleExecContext& t_info = *threadInfo[curThread];
     SimpleThread* thread = t_info.thread;
 
+    const bool host_page_access =
+        isHostPageAccess(addr, size, flags, byteEnable) && !traceData;
+    if (host_page_access) {
+        if (const uint8_t *host = hostReadPages.lookup(addr)) {
+            memcpy(data, host, size);
+            return NoFault;
+        }
+    }
+
     // use the CPU's statically allocated read request and packet objects
     Request *req = &data_read_req;
 
@@ -401,7 +425,8 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
             if (req->isMmappedIpr())
                 dcache_latency += TheISA::handleIprRead(thread->getTC(), &pkt);
             else {
-                if (fastmem && system->isMemAddr(pkt.getAddr()))
+                if ((fastmem || fastForward) &&
+                    system->isMemAddr(pkt.getAddr()))
                     system->getPhysMem().access(&pkt);
                 else
                     dcache_latency += dcachePort.sendAtomic(&pkt);
@@ -430,6 +455,8 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t * data, unsigned size,
                 assert(!locked);
                 locked = true;
             }
+            if (host_page_access && fault == NoFault)
+                cacheHostPage(hostReadPages, req);
             return fault;
         }
 
@@ -468,6 +495,19 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
         data = zero_array;
     }
 
+    // direct stores would bypass other threads' monitors and the
+    // memories' load-locked addresses
+    const bool host_page_access =
+        isHostPageAccess(addr, size, flags, byteEnable) && !traceData &&
+        numThreads == 1;
+    if (host_page_access) {
+        uint8_t *host = hostWritePages.lookup(addr);
+        if (host && !system->getPhysMem().hasLockedAddrs()) {
+            memcpy(host, data, size);
+            return NoFault;
+        }
+    }
+
     // use the CPU's statically allocated write request and packet objects
     Request *req = &data_write_req;
 
@@ -519,7 +559,8 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                     dcache_latency +=
                         TheISA::handleIprWrite(thread->getTC(), &pkt);
                 } else {
-                    if (fastmem && system->isMemAddr(pkt.getAddr()))
+                    if ((fastmem || fastForward) &&
+                        system->isMemAddr(pkt.getAddr()))
                         system->getPhysMem().access(&pkt);
                     else
                         dcache_latency += dcachePort.sendAtomic(&pkt);
@@ -551,6 +592,9 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 locked = false;
             }
 
+            if (host_page_access && fault == NoFault)
+                cacheHostPage(hostWritePages, req);
+
             if (fault != NoFault && req->isPrefetch()) {
                 return NoFault;
             } else {
@@ -617,6 +661,8 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
 
         if (req->isMmappedIpr())
             dcache_latency += TheISA::handleIprRead(thread->getTC(), &pkt);
+        else if (fastForward && system->isMemAddr(pkt.getAddr()))
+            system->getPhysMem().access(&pkt);
         else {
             dcache_latency += dcachePort.sendAtomic(&pkt);
         }
@@ -777,6 +823,187 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+void
+AtomicSimpleCPU::flushHostPages()
+{
+    hostReadPages.flush();
+    hostWritePages.flush();
+    hostPagesRemapCount = EmulationPageTable::remapCount();
+    hostPagesThread = curThread;
+}
+
+void
+AtomicSimpleCPU::cacheHostPage(HostPageCache &cache, const Request *req)
+{
+    // the translation may have turned this into a device access
+    if (req->getFlags().isSet(Request::UNCACHEABLE |
+                              Request::STRICT_ORDER |
+                              Request::MMAPPED_IPR))
+        return;
+
+    Addr page = roundDown(req->getPaddr(), TheISA::PageBytes);
+    uint8_t *host = system->getPhysMem().hostAddr(page, TheISA::PageBytes);
+    if (host)
+        cache.insert(req->getVaddr(), host);
+}
+
+Fault
+AtomicSimpleCPU::fastForwardFetch()
+{
+    SimpleExecContext& t_info = *threadInfo[curThread];
+    SimpleThread* thread = t_info.thread;
+
+    Addr fetch_pc = (thread->instAddr() & PCMask) + t_info.fetchOffset;
+    if (const uint8_t *host = hostReadPages.lookup(fetch_pc)) {
+        memcpy(&inst, host, sizeof(inst));
+        return NoFault;
+    }
+
+    ifetch_req.taskId(taskId());
+    setupFetchRequest(&ifetch_req);
+    Fault fault = thread->itb->translateAtomic(&ifetch_req, thread->getTC(),
+                                               BaseTLB::Execute);
+    if (fault != NoFault)
+        return fault;
+
+    Packet ifetch_pkt = Packet(&ifetch_req, MemCmd::ReadReq);
+    ifetch_pkt.dataStatic(&inst);
+
+    if (system->isMemAddr(ifetch_pkt.getAddr())) {
+        system->getPhysMem().access(&ifetch_pkt);
+        cacheHostPage(hostReadPages, &ifetch_req);
+    } else {
+        icachePort.sendAtomic(&ifetch_pkt);
+    }
+
+    assert(!ifetch_pkt.isError());
+    return NoFault;
+}
+
+void
+AtomicSimpleCPU::fastForwardTick()
+{
+    DPRINTF(SimpleCPU, "Fast-forward tick\n");
+
+    // Change thread if multi-threaded
+    swapActiveThread();
+
+    // Set memroy request ids to current thread
+    if (numThreads > 1) {
+        ContextID cid = threadContexts[curThread]->contextId();
+
+        ifetch_req.setContext(cid);
+        data_read_req.setContext(cid);
+        data_write_req.setContext(cid);
+        data_amo_req.setContext(cid);
+    }
+
+    SimpleExecContext& t_info = *threadInfo[curThread];
+    SimpleThread* thread = t_info.thread;
+
+    if (hostPagesRemapCount != EmulationPageTable::remapCount() ||
+        hostPagesThread != curThread)
+        flushHostPages();
+
+    // End the batch when the next instruction or load count event is
+    // due. If one is due now, it is serviced before the first
+    // instruction and the batch ends after that instruction, exactly
+    // as in normal mode.
+    auto batch_end = [](EventQueue *queue, Counter count, Counter end) {
+        if (queue->empty())
+            return end;
+        Counter when = queue->nextTick();
+        return when > count ? std::min(when, end) : count + 1;
+    };
+    const Counter no_end = std::numeric_limits<Counter>::max();
+    const Counter inst_end = batch_end(comInstEventQueue[curThread],
+                                       t_info.numInst,
+                                       t_info.numInst + fastForwardBatch);
+    const Counter sys_end = batch_end(&system->instEventQueue,
+                                      system->totalNumInsts, no_end);
+    const Counter load_end = batch_end(comLoadEventQueue[curThread],
+                                       t_info.numLoad, no_end);
+
+    // interrupts are only taken between batches
+    checkForInterrupts();
+
+    uint64_t iterations = 0;
+    Tick stall_ticks = 0;
+    while ((t_info.numInst < inst_end && system->totalNumInsts < sys_end &&
+            t_info.numLoad < load_end) || locked) {
+        if (drainState() == DrainState::Draining && isDrained())
+            break;
+
+        ++iterations;
+
+        if (!curStaticInst || !curStaticInst->isDelayedCommit())
+            checkPcEventQueue();
+
+        // We must have just got suspended by a PC event
+        if (_status == Idle)
+            break;
+
+        Fault fault = NoFault;
+
+        TheISA::PCState pcState = thread->pcState();
+        if (!isRomMicroPC(pcState.microPC()) && !curMacroStaticInst)
+            fault = fastForwardFetch();
+
+        if (fault == NoFault) {
+            preExecute();
+
+            if (curStaticInst) {
+                fault = curStaticInst->execute(&t_info, traceData);
+
+                if (fault == NoFault) {
+                    countInst();
+                    ppCommit->notify(std::make_pair(thread, curStaticInst));
+                } else if (traceData && !DTRACE(ExecFaulting)) {
+                    delete traceData;
+                    traceData = NULL;
+                }
+
+                if (dynamic_pointer_cast<SyscallRetryFault>(fault))
+                    stall_ticks += clockEdge(syscallRetryLatency) - curTick();
+
+                postExecute();
+            }
+
+            if (curStaticInst && (!curStaticInst->isMicroop() ||
+                        curStaticInst->isFirstMicroop()))
+                instCnt++;
+        }
+
+        // Faults (including system calls) and non-speculative
+        // instructions (e.g. m5ops) may exit the simulation loop or
+        // change the memory mappings, so give the event queue a chance
+        // to react before going on.
+        bool end_batch = fault != NoFault ||
+            (curStaticInst && curStaticInst->isNonSpeculative());
+
+        if (fault != NoFault || !t_info.stayAtPC)
+            advancePC(fault);
+
+        if (end_batch || _status == Idle)
+            break;
+    }
+
+    // time still advances by one cycle per width instructions
+    const Cycles cycles(std::max<uint64_t>(divCeil(iterations, width), 1));
+    numCycles += cycles;
+    updateCycleCounters(BaseCPU::CPU_STATE_ON);
+
+    if (tryCompleteDrain())
+        return;
+
+    Tick latency = clockPeriod() * cycles;
+    if (stall_ticks)
+        latency += divCeil(stall_ticks, clockPeriod()) * clockPeriod();
+
+    if (_status != Idle)
+        reschedule(tickEvent, curTick() + latency, true);
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
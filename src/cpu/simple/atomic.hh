@@ -43,6 +43,8 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include "arch/isa_traits.hh"
+#include "base/intmath.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -70,6 +72,109 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     // main simulation loop (one cycle)
     void tick();
 
+    /** Functional fast-forward mode, see fastForwardTick(). */
+    const bool fastForward;
+
+    /** Maximum number of instructions per tick when fast-forwarding. */
+    const Counter fastForwardBatch;
+
+    /**
+     * Execute a batch of instructions in fast-forward mode. Time still
+     * advances by one cycle per instruction, but the CPU only runs
+     * once per batch. A batch ends early at instruction-count events,
+     * faults, and instructions that may exit the simulation loop, so
+     * that these happen at the same instruction as in normal mode.
+     */
+    void fastForwardTick();
+
+    /** Fetch the next instruction word in fast-forward mode. */
+    Fault fastForwardFetch();
+
+    /**
+     * Direct-mapped cache of host pointers to recently accessed
+     * SE-mode pages, used in fast-forward mode to bypass the TLBs and
+     * the memory system. Pages are only inserted after an access to
+     * them went the normal way, and the cache is flushed whenever an
+     * existing page table mapping changes.
+     */
+    class HostPageCache
+    {
+      private:
+        struct Entry
+        {
+            Addr vpn;
+            uint8_t *host;
+        };
+
+        static const unsigned numEntries = 256;
+        Entry entries[numEntries];
+
+      public:
+        HostPageCache() { flush(); }
+
+        /** @return The host pointer to a virtual address, or nullptr. */
+        uint8_t *
+        lookup(Addr vaddr) const
+        {
+            const Addr vpn = vaddr >> TheISA::PageShift;
+            const Entry &e = entries[vpn % numEntries];
+            if (e.vpn != vpn)
+                return nullptr;
+            return e.host + (vaddr & (TheISA::PageBytes - 1));
+        }
+
+        void
+        insert(Addr vaddr, uint8_t *host_page)
+        {
+            const Addr vpn = vaddr >> TheISA::PageShift;
+            entries[vpn % numEntries] = Entry{vpn, host_page};
+        }
+
+        void
+        flush()
+        {
+            for (auto &e : entries)
+                e = Entry{MaxAddr, nullptr};
+        }
+    };
+
+    /** Pages that can be read (and fetched from) directly. */
+    HostPageCache hostReadPages;
+
+    /** Pages that can be written directly. */
+    HostPageCache hostWritePages;
+
+    /** Page table remap count the host page caches are valid for. */
+    uint64_t hostPagesRemapCount;
+
+    /** Thread the host page caches are valid for. */
+    ThreadID hostPagesThread;
+
+    /** Drop all cached host pages. */
+    void flushHostPages();
+
+    /**
+     * Check if a data access can use a host page: it must be a plain,
+     * naturally aligned access with no special request flags.
+     */
+    bool
+    isHostPageAccess(Addr addr, unsigned size, Request::Flags flags,
+                     const std::vector<bool> &byte_enable) const
+    {
+        return fastForward && byte_enable.empty() &&
+            flags.noneSet(~Request::FlagsType(Request::ARCH_BITS)) &&
+            isPowerOf2(size) && (addr & (size - 1)) == 0 &&
+            size <= TheISA::PageBytes;
+    }
+
+    /**
+     * Remember the page of a completed access in a host page cache.
+     *
+     * @param cache Cache to insert the page into
+     * @param req Translated request of the access
+     */
+    void cacheHostPage(HostPageCache &cache, const Request *req);
+
     /**
      * Check if a system is in a drained state.
      *
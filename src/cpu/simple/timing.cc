@@ -440,7 +440,9 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     req->taskId(taskId());
 
     Addr split_addr = roundDown(addr + size - 1, block_size);
-    assert(split_addr <= addr || split_addr - addr < block_size);
+    fatal_if(split_addr > addr && split_addr - addr >= block_size,
+             "%s: %d-byte access at %#x spans more than two cache lines\n",
+             name(), size, addr);
 
     _status = DTBWaitResponse;
     if (split_addr > addr) {
@@ -525,7 +527,9 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     req->taskId(taskId());
 
     Addr split_addr = roundDown(addr + size - 1, block_size);
-    assert(split_addr <= addr || split_addr - addr < block_size);
+    fatal_if(split_addr > addr && split_addr - addr >= block_size,
+             "%s: %d-byte access at %#x spans more than two cache lines\n",
+             name(), size, addr);
 
     _status = DTBWaitResponse;
 
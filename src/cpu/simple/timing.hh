@@ -57,6 +57,9 @@ class TimingSimpleCPU : public BaseSimpleCPU
 
     void init() override;
 
+    /** Accesses are split in at most two, see SplitMainSenderState. */
+    unsigned maxMemAccessSpan() const override { return cacheLineSize(); }
+
   private:
 
     /*
@@ -174,9 +174,12 @@ serialize(ThreadContext &tc, CheckpointOut &cp)
     // compatibility.
     arrayParamOut(cp, "floatRegs.i", floatRegs, NumFloatRegs);
 
-    std::vector<TheISA::VecRegContainer> vecRegs(NumVecRegs);
+    // Copy construct so that the whole register is written out, not only
+    // the bytes assignments move at the current vector length.
+    std::vector<TheISA::VecRegContainer> vecRegs;
+    vecRegs.reserve(NumVecRegs);
     for (int i = 0; i < NumVecRegs; ++i) {
-        vecRegs[i] = tc.readVecRegFlat(i);
+        vecRegs.push_back(tc.readVecRegFlat(i));
     }
     SERIALIZE_CONTAINER(vecRegs);
 
@@ -0,0 +1,48 @@
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import *
+from m5.params import *
+from m5.proxy import *
+from MemObject import MemObject
+
+# Connects a CPU simulated on one event queue to its L1 cache simulated
+# on another. The bridge itself, and thus its master port, lives on
+# eventq_index; its slave port is served on cpu_side_eventq_index.
+class CrossQueueBridge(MemObject):
+    type = 'CrossQueueBridge'
+    cxx_header = "mem/cross_queue_bridge.hh"
+
+    cxx_exports = [
+        PyBindMethod("digest"),
+    ]
+
+    slave = SlavePort('Slave port, connected to the CPU side')
+    master = MasterPort('Master port, connected to the memory side')
+    cpu_side_eventq_index = Param.UInt32(Parent.eventq_index,
+        "Event queue of the objects connected to the slave port")
+    delay = Param.Latency('1ns', "Latency of the bridge in both "
+                          "directions, must exceed the simulation quantum")
@@ -39,6 +39,7 @@
 # Authors: Nathan Binkert
 #          Andreas Hansson
 
+from m5.SimObject import cxxMethod
 from m5.params import *
 from m5.proxy import *
 from MemObject import MemObject
@@ -57,6 +58,11 @@ class BaseCache(MemObject):
     data_latency = Param.Cycles("Data access latency")
     response_latency = Param.Cycles("Latency for the return path on a miss");
 
+    @cxxMethod
+    def setLatencies(self, tag_latency, data_latency, response_latency):
+        """Change the cache latencies (in cycles) when drained"""
+        pass
+
     warmup_percentage = Param.Percent(0,
         "Percentage of tags to be touched to warm up the cache")
 
@@ -73,6 +79,9 @@ class BaseCache(MemObject):
     prefetcher = Param.BasePrefetcher(NULL,"Prefetcher attached to cache")
     prefetch_on_access = Param.Bool(False,
          "Notify the hardware prefetcher on every access (not just misses)")
+    warm_prefetcher = Param.Bool(False,
+         "Train the prefetcher on atomic accesses (functional warming); "
+         "the prefetches it generates are dropped")
 
     tags = Param.BaseTags(LRU(), "Tag store (replacement policy)")
     sequential_access = Param.Bool(False,
@@ -146,6 +146,21 @@ BaseCache::init()
     forwardSnoops = cpuSidePort->isSnooping();
 }
 
+void
+BaseCache::setLatencies(unsigned tag_latency, unsigned data_latency,
+                        unsigned response_latency)
+{
+    panic_if(drainState() != DrainState::Drained,
+             "%s: latencies can only be changed when drained\n", name());
+
+    lookupLatency = Cycles(tag_latency);
+    dataLatency = Cycles(data_latency);
+    forwardLatency = Cycles(tag_latency);
+    fillLatency = Cycles(data_latency);
+    responseLatency = Cycles(response_latency);
+    tags->setLatencies(lookupLatency, dataLatency);
+}
+
 BaseMasterPort &
 BaseCache::getMasterPort(const std::string &if_name, PortID idx)
 {
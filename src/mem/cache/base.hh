@@ -262,30 +262,30 @@ class BaseCache : public MemObject
      * The latency of tag lookup of a cache. It occurs when there is
      * an access to the cache.
      */
-    const Cycles lookupLatency;
+    Cycles lookupLatency;
 
     /**
      * The latency of data access of a cache. It occurs when there is
      * an access to the cache.
      */
-    const Cycles dataLatency;
+    Cycles dataLatency;
 
     /**
      * This is the forward latency of the cache. It occurs when there
      * is a cache miss and a request is forwarded downstream, in
      * particular an outbound miss.
      */
-    const Cycles forwardLatency;
+    Cycles forwardLatency;
 
     /** The latency to fill a cache block */
-    const Cycles fillLatency;
+    Cycles fillLatency;
 
     /**
      * The latency of sending reponse to its upper level cache/core on
      * a linefill. The responseLatency parameter captures this
      * latency.
      */
-    const Cycles responseLatency;
+    Cycles responseLatency;
 
     /** The number of targets for each MSHR. */
     const int numTarget;
@@ -469,6 +469,15 @@ class BaseCache : public MemObject
 
     virtual void init() override;
 
+    /**
+     * Change the tag, data and response latencies. The forward and
+     * fill latencies follow the tag and data latencies, as they do
+     * when the cache is built. The cache must be drained, since
+     * responses already scheduled were timed with the old values.
+     */
+    void setLatencies(unsigned tag_latency, unsigned data_latency,
+                      unsigned response_latency);
+
     virtual BaseMasterPort &getMasterPort(const std::string &if_name,
                                           PortID idx = InvalidPortID) override;
     virtual BaseSlavePort &getSlavePort(const std::string &if_name,
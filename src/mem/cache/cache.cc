@@ -71,6 +71,7 @@ Cache::Cache(const CacheParams *p)
       prefetcher(p->prefetcher),
       doFastWrites(true),
       prefetchOnAccess(p->prefetch_on_access),
+      warmPrefetcher(p->warm_prefetcher),
       clusivity(p->clusivity),
       writebackClean(p->writeback_clean),
       tempBlockWriteback(nullptr),
@@ -1116,6 +1117,16 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
 }
 
 
+void
+Cache::warmPrefetcherAtomic(PacketPtr pkt)
+{
+    if (warmPrefetcher && prefetcher && !pkt->cmd.isSWPrefetch() &&
+        !pkt->req->isUncacheable() && !pkt->req->isCacheMaintenance()) {
+        prefetcher->notify(pkt);
+        prefetcher->dropPrefetches();
+    }
+}
+
 Tick
 Cache::recvAtomic(PacketPtr pkt)
 {
@@ -1168,6 +1179,9 @@ Cache::recvAtomic(PacketPtr pkt)
     // logically proceed anything happening below
     doWritebacksAtomic(writebacks);
 
+    if (satisfied && prefetchOnAccess)
+        warmPrefetcherAtomic(pkt);
+
     if (!satisfied) {
         // MISS
 
@@ -1180,6 +1194,11 @@ Cache::recvAtomic(PacketPtr pkt)
         }
         // only misses left
 
+        // Train the prefetcher before the fill, as timingAccess()
+        // notifies it before the miss is serviced, so that it sees
+        // the line as missing.
+        warmPrefetcherAtomic(pkt);
+
         PacketPtr bus_pkt = createMissPacket(pkt, blk, pkt->needsWritable());
 
         bool is_forward = (bus_pkt == nullptr);
@@ -1259,7 +1278,8 @@ Cache::recvAtomic(PacketPtr pkt)
     // mode, though, this is the place to do it... see timingAccess()
     // for an example (though we'd want to issue the prefetch(es)
     // immediately rather than calling requestMemSideBus() as we do
-    // there).
+    // there). The prefetcher may still be trained, see
+    // warmPrefetcherAtomic().
 
     // do any writebacks resulting from the response handling
     doWritebacksAtomic(writebacks);
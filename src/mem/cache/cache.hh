@@ -211,6 +211,11 @@ class Cache : public BaseCache
      */
     const bool prefetchOnAccess;
 
+    /**
+     * Train the prefetcher in atomic mode, without issuing prefetches.
+     */
+    const bool warmPrefetcher;
+
      /**
      * Clusivity with respect to the upstream cache, determining if we
      * fill into both this cache and the cache above on a miss. Note
@@ -392,6 +397,16 @@ class Cache : public BaseCache
      */
     void recvTimingSnoopResp(PacketPtr pkt);
 
+    /**
+     * Train the prefetcher on an atomic access when warming
+     * functionally, e.g. between the detailed samples of a sampled
+     * simulation, so that its tables are warm when switching back to
+     * timing mode. The candidates it generates are dropped, see
+     * recvAtomic().
+     * @param pkt The demand access, before it is serviced.
+     */
+    void warmPrefetcherAtomic(PacketPtr pkt);
+
     /**
      * Performs the access specified by the request.
      * @param pkt The request to perform.
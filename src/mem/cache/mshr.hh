@@ -49,6 +49,7 @@
 #define __MEM_CACHE_MSHR_HH__
 
 #include <list>
+#include <set>
 
 #include "base/printable.hh"
 #include "mem/cache/queue_entry.hh"
@@ -226,6 +227,8 @@ class MSHR : public QueueEntry, public Printable
     typedef std::list<MSHR *> List;
     /** MSHR list iterator. */
     typedef List::iterator Iterator;
+    /** A ready list, kept in issue order. */
+    typedef std::set<MSHR *, ReadyOrder> ReadyList;
 
     /** The pending* and post* flags are only valid if inService is
      *  true.  Using the accessor functions lets us detect if these
@@ -258,7 +261,7 @@ class MSHR : public QueueEntry, public Printable
      * Pointer to this MSHR on the ready list.
      * @sa MissQueue, MSHRQueue::readyList
      */
-    Iterator readyIter;
+    ReadyList::iterator readyIter;
 
     /**
      * Pointer to this MSHR on the allocated list.
@@ -66,7 +66,7 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
     freeList.pop_front();
 
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
-    mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    addToAllocatedList(mshr);
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
@@ -77,9 +77,8 @@ void
 MSHRQueue::moveToFront(MSHR *mshr)
 {
     if (!mshr->inService) {
-        assert(mshr == *(mshr->readyIter));
-        readyList.erase(mshr->readyIter);
-        mshr->readyIter = readyList.insert(readyList.begin(), mshr);
+        removeFromReadyList(mshr);
+        mshr->readyIter = addToReadyList(mshr, true);
     }
 }
 
@@ -87,7 +86,7 @@ void
 MSHRQueue::markInService(MSHR *mshr, bool pending_modified_resp)
 {
     mshr->markInService(pending_modified_resp);
-    readyList.erase(mshr->readyIter);
+    removeFromReadyList(mshr);
     _numInService += 1;
 }
 
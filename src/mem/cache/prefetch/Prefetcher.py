@@ -40,6 +40,7 @@
 #          Mitch Hayenga
 
 from ClockedObject import ClockedObject
+from m5.SimObject import cxxMethod
 from m5.params import *
 from m5.proxy import *
 
@@ -105,3 +106,8 @@ class KPrefetcher(QueuedPrefetcher):
     l2maxprfofs = Param.Int(2048, "Max L2 prefetchOffset.")
     writeprefetch = Param.Bool(True, "Exclusive request on write")
     hpctag = Param.Bool(True, "HPC tag support for prefetch")
+
+    @cxxMethod
+    def setStreamParams(self, l1degree, l1maxprfofs, l2degree, l2maxprfofs):
+        """Change prefetch degree and max offset of both stream tables"""
+        pass
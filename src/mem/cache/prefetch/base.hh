@@ -138,6 +138,11 @@ class BasePrefetcher : public ClockedObject
 
     virtual Tick nextPrefetchReadyTime() const = 0;
 
+    /**
+     * Drop all prefetches that have not been issued yet.
+     */
+    virtual void dropPrefetches() {}
+
     virtual void regStats();
 };
 #endif //__MEM_CACHE_PREFETCH_BASE_HH__
@@ -43,26 +43,33 @@
 #include "debug/HWPrefetch.hh"
 
 KPrefetcher::KPrefetcher(const KPrefetcherParams *p)
-    : QueuedPrefetcher(p),writeprefetch(p->writeprefetch),
-      hpctag(p->hpctag)
+    : QueuedPrefetcher(p),
+      entriesl1(p->l1prftablesize, true, blkSize, pageBytes),
+      entriesl2(p->l2prftablesize, false, blkSize, pageBytes),
+      writeprefetch(p->writeprefetch), hpctag(p->hpctag)
 {
-    l1param.prftablesize = p->l1prftablesize;
-    l1param.maxprfofs = p->l1maxprfofs;
-    l1param.degree = p->l1degree;
-    l1param.slowstart = 1;
+    entriesl1.setDegree(p->l1degree, p->l1maxprfofs);
     l1param.flags = Request::PF_L1;
     l1param.prio = 1;
 
-    l2param.prftablesize = p->l2prftablesize;
-    l2param.maxprfofs = p->l2maxprfofs;
-    l2param.degree = p->l2degree;
-    l2param.slowstart = 0;
+    entriesl2.setDegree(p->l2degree, p->l2maxprfofs);
     l2param.flags= Request::PF_L2;
     l2param.prio = 0;
 
     // Don't consult stride prefetcher on instruction accesses
     DPRINTF(HWPrefetch, "KPrefetcher installed\n");
 }
+
+void
+KPrefetcher::setStreamParams(int l1degree, int l1maxprfofs,
+                             int l2degree, int l2maxprfofs)
+{
+    entriesl1.setDegree(l1degree, l1maxprfofs);
+    entriesl2.setDegree(l2degree, l2maxprfofs);
+    DPRINTF(HWPrefetch, "stream params: l1 %d/%d l2 %d/%d\n",
+            l1degree, l1maxprfofs, l2degree, l2maxprfofs);
+}
+
 void
 KPrefetcher::calculatePrefetch(const PacketPtr &pkt,
                                     std::vector<AddrPriority> &addresses)
@@ -82,109 +89,43 @@ KPrefetcher::calculatePrefetch(const PacketPtr &pkt,
         calculateTable(entriesl1, pkt, addresses, l1param);
     }
     if (!noL2 &&
-        (l2param.prftablesize != 0)){
+        (entriesl2.tableSize() != 0)){
         calculateTable(entriesl2, pkt, addresses, l2param);
     }
 }
 void
-KPrefetcher::calculateTable(Kpftable &entries, const PacketPtr &pkt,
+KPrefetcher::calculateTable(KStreamTable &entries, const PacketPtr &pkt,
                             std::vector<AddrPriority> &addresses,
                             const TableParameters &prm)
 
 {
-    Addr pkt_addr = pkt->getAddr()&(~static_cast<Addr>(blkSize -1));
-
-    auto el = std::find_if(entries.begin(), entries.end(), [&](KEntry &e){
-            return (pkt_addr == e.pktAddr);
-        }
-        );
-
-    if (el != entries.end()){
-        Addr prf_addr = el->prfAddr;
-        int64_t stride = blkSize;
-        bool isStore = el->isStore;
-        if (pkt->isWrite()){
-            isStore = true;
-        }
-
-        //Need to cast blkSize if this line is done above.
-        stride = (el->incr) ? stride: -stride;
-
-        int effdegree = (std::abs((int64_t)(prf_addr - pkt_addr))
-                         >= prm.maxprfofs)? 1 : prm.degree;
-        if (prf_addr){
-            for (int i = 0; i < effdegree; i++){
-                Addr addr = prf_addr + stride*i;
-                if (samePage(pkt_addr, addr)){
-                    Request::Flags flg;
-                    flg = prm.flags
-                        |((isStore && writeprefetch) ?
-                          Request::PF_EXCLUSIVE :
-                          Request::PREFETCH)
-                        ;
-                    addresses.push_back(
-                        AddrPriority(addr, prm.prio , flg));
-                }else{
-                    DPRINTF(HWPrefetch, "Ignoring page crossing prefetch.\n");
-                    break;
-                }
-            }
-        }else {
-            DPRINTF(HWPrefetch, "Slowstart match\n");
-            prf_addr = pkt_addr;
-            effdegree = 1;
-        }
-        KEntry en;
-
-        en.pktAddr = pkt_addr + stride;
-        en.prfAddr = prf_addr + stride*effdegree;
-        en.incr = el->incr;
-        en.isStore = isStore;
-
-        DPRINTF(HWPrefetch, "Replace Prefetch %x-%x %s(%d)\n",
-                en.pktAddr, en.prfAddr, effdegree,
-                en.isStore ? "Store": "Load" );
-        entries.erase(el);
-        if (samePage(pkt_addr, en.pktAddr)){
-            entries.push_front(en);
-        }
-    } else if (!inCache(pkt->getAddr(), pkt->isSecure())
-               && !inMissQueue(pkt->getAddr(), pkt->isSecure()))
-      {
-        KEntry en0;
-        en0.pktAddr = pkt_addr + blkSize;
-        if (!prm.slowstart)
-            en0.prfAddr = pkt_addr + blkSize*2;
-        if (pkt->isWrite()){
-            en0.isStore = true;
-        }
-        if (samePage(pkt_addr, en0.pktAddr)){
-            DPRINTF(HWPrefetch, "Add Prefetch forward %x-%x %s\n",
-                    en0.pktAddr, en0.prfAddr,
-                    (en0.isStore)? "Store": "Load");
-            entries.push_front(en0);
-        }
-
-        KEntry en1;
-        en1.pktAddr = pkt_addr - blkSize;
-        if (!prm.slowstart)
-            en1.prfAddr = pkt_addr - blkSize*2;
-        en1.incr = false;
-        if (pkt->isWrite()){
-            en1.isStore = true;
-        }
-        if (samePage(pkt_addr, en1.pktAddr)){
-            DPRINTF(HWPrefetch, "Add Prefetch back %x-%x %s\n",
-                    en1.pktAddr, en1.prfAddr,
-                    en1.isStore?"Store":"Load");
-            entries.push_front(en1);
-        }
-
-        if (entries.size() > prm.prftablesize){
-            entries.resize(prm.prftablesize);
-        }
+    std::vector<Addr> prefetches;
+    bool isStore = false;
+    auto outcome = entries.access(pkt->getAddr(), pkt->isWrite(),
+        [this, &pkt]() {
+            return inCache(pkt->getAddr(), pkt->isSecure()) ||
+                inMissQueue(pkt->getAddr(), pkt->isSecure());
+        }, prefetches, isStore);
+
+    for (Addr addr : prefetches) {
+        Request::Flags flg;
+        flg = prm.flags
+            |((isStore && writeprefetch) ?
+              Request::PF_EXCLUSIVE :
+              Request::PREFETCH)
+            ;
+        addresses.push_back(
+            AddrPriority(addr, prm.prio , flg));
     }
 
+    if (outcome == KStreamTable::Advanced) {
+        DPRINTF(HWPrefetch, "Advance stream at %x, %d prefetches %s\n",
+                pkt->getAddr(), prefetches.size(),
+                isStore ? "Store" : "Load");
+    } else if (outcome == KStreamTable::Started) {
+        DPRINTF(HWPrefetch, "Add Prefetch streams around %x %s\n",
+                pkt->getAddr(), pkt->isWrite() ? "Store" : "Load");
+    }
 }
 
 KPrefetcher *
@@ -48,8 +48,7 @@
 #ifndef __MEM_CACHE_PREFETCH_KPREFETCHER_HH__
 #define __MEM_CACHE_PREFETCH_KPREFETCHER_HH__
 
-#include <deque>
-
+#include "mem/cache/prefetch/kstream_table.hh"
 #include "mem/cache/prefetch/queued.hh"
 #include "params/KPrefetcher.hh"
 
@@ -58,35 +57,28 @@ class KPrefetcher : public QueuedPrefetcher
   protected:
     struct TableParameters{
         Request::Flags flags;
-        int prftablesize;
-        int maxprfofs;
-        int degree;
-        int slowstart;
         int prio;
     };
-    struct KEntry
-    {
-        KEntry() : pktAddr(0), prfAddr(0), incr(true), isStore(false)
-        { }
-
-        Addr pktAddr;
-        Addr prfAddr;
-        bool incr;
-        bool isStore;
-    };
-    using Kpftable = std::deque<KEntry>;
-    Kpftable entriesl1;
-    Kpftable entriesl2;
+    KStreamTable entriesl1;
+    KStreamTable entriesl2;
     TableParameters l1param, l2param;
     bool writeprefetch;
     bool hpctag;
     void
-    calculateTable(Kpftable &entries, const PacketPtr &pkt,
-                                std::vector<AddrPriority> &addresses,
-                                const TableParameters &prm);
+    calculateTable(KStreamTable &entries, const PacketPtr &pkt,
+                   std::vector<AddrPriority> &addresses,
+                   const TableParameters &prm);
   public:
 
     KPrefetcher(const KPrefetcherParams *p);
+
+    /**
+     * Change the prefetch degree and maximum prefetch offset of both
+     * stream tables. Table sizes are structural and stay fixed.
+     */
+    void setStreamParams(int l1degree, int l1maxprfofs,
+                         int l2degree, int l2maxprfofs);
+
     void calculatePrefetch(const PacketPtr &pkt,
                            std::vector<AddrPriority> &addresses);
 };
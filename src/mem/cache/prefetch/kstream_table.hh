@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * The sequential streams tracked by one level of the KPrefetcher.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_KSTREAM_TABLE_HH__
+#define __MEM_CACHE_PREFETCH_KSTREAM_TABLE_HH__
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "base/types.hh"
+#include "mem/cache/prefetch/stream_table.hh"
+
+/**
+ * The streams of one KPrefetcher level. An access to a line that is
+ * neither cached nor being fetched starts a forward and a backward
+ * stream next to it. An access to the line a stream expects next
+ * advances the stream and prefetches up to degree lines ahead of it,
+ * or one line once the stream runs maxprfofs bytes ahead of the
+ * accesses. Streams stop at page boundaries.
+ */
+class KStreamTable
+{
+  public:
+    struct Entry
+    {
+        Entry() : pktAddr(0), prfAddr(0), incr(true), isStore(false)
+        { }
+
+        /** The line the stream expects to be accessed next. */
+        Addr pktAddr;
+        /** The next line to prefetch, 0 before the first prefetch. */
+        Addr prfAddr;
+        bool incr;
+        bool isStore;
+    };
+
+    /** What an access did to the table. */
+    enum Outcome
+    {
+        /** The access matched a stream and advanced it. */
+        Advanced,
+        /** The access missed and started new streams. */
+        Started,
+        /** The access neither matched a stream nor missed. */
+        Ignored,
+    };
+
+    /**
+     * @param table_size The number of streams kept.
+     * @param slow_start Whether a new stream waits for its first match
+     *                   before prefetching.
+     * @param blk_size The cache line size in bytes.
+     * @param page_bytes The page size streams are confined to.
+     */
+    KStreamTable(int table_size, bool slow_start, unsigned blk_size,
+                 Addr page_bytes)
+        : entries(table_size + 2), _tableSize(table_size), degree(1),
+          maxPrfOfs(0), slowStart(slow_start), blkSize(blk_size),
+          pageBytes(page_bytes)
+    {}
+
+    /** Change how far ahead of the accesses the streams prefetch. */
+    void
+    setDegree(int _degree, int max_prf_ofs)
+    {
+        degree = _degree;
+        maxPrfOfs = max_prf_ofs;
+    }
+
+    /** The number of streams kept. */
+    int tableSize() const { return _tableSize; }
+
+    /** The number of streams in the table. */
+    size_t size() const { return entries.size(); }
+
+    /** The stream expecting the given line next, or nullptr. */
+    const Entry *
+    find(Addr line_addr) const
+    {
+        auto h = entries.find(line_addr);
+        return h == Table::Invalid ? nullptr : &entries[h];
+    }
+
+    /**
+     * Train the table on a demand access.
+     *
+     * @param addr The accessed address.
+     * @param is_write Whether the access is a write.
+     * @param present Returns whether the accessed line is cached or
+     *                being fetched. Only called if no stream matches.
+     * @param prefetches The lines to prefetch are appended here.
+     * @param is_store Set to whether the matched stream is written.
+     */
+    template <class Present>
+    Outcome
+    access(Addr addr, bool is_write, const Present &present,
+           std::vector<Addr> &prefetches, bool &is_store)
+    {
+        const Addr pkt_addr = addr & ~Addr(blkSize - 1);
+
+        auto hit = entries.find(pkt_addr);
+        if (hit != Table::Invalid) {
+            const Entry &el = entries[hit];
+            Addr prf_addr = el.prfAddr;
+            const int64_t stride = el.incr ? blkSize : -int64_t(blkSize);
+            is_store = el.isStore || is_write;
+
+            int effdegree =
+                std::abs(int64_t(prf_addr - pkt_addr)) >= maxPrfOfs ?
+                1 : degree;
+            if (prf_addr) {
+                for (int i = 0; i < effdegree; i++) {
+                    Addr pf_addr = prf_addr + stride * i;
+                    if (!samePage(pkt_addr, pf_addr))
+                        break;
+                    prefetches.push_back(pf_addr);
+                }
+            } else {
+                // slow start, the first match only arms the stream
+                prf_addr = pkt_addr;
+                effdegree = 1;
+            }
+
+            Entry en;
+            en.pktAddr = pkt_addr + stride;
+            en.prfAddr = prf_addr + stride * effdegree;
+            en.incr = el.incr;
+            en.isStore = is_store;
+
+            entries.erase(hit);
+            if (samePage(pkt_addr, en.pktAddr))
+                entries.pushFront(en.pktAddr, en);
+            return Advanced;
+        }
+
+        if (present())
+            return Ignored;
+
+        Entry en0;
+        en0.pktAddr = pkt_addr + blkSize;
+        if (!slowStart)
+            en0.prfAddr = pkt_addr + blkSize * 2;
+        en0.isStore = is_write;
+        if (samePage(pkt_addr, en0.pktAddr))
+            entries.pushFront(en0.pktAddr, en0);
+
+        Entry en1;
+        en1.pktAddr = pkt_addr - blkSize;
+        if (!slowStart)
+            en1.prfAddr = pkt_addr - blkSize * 2;
+        en1.incr = false;
+        en1.isStore = is_write;
+        if (samePage(pkt_addr, en1.pktAddr))
+            entries.pushFront(en1.pktAddr, en1);
+
+        entries.truncate(_tableSize);
+        return Started;
+    }
+
+  private:
+    typedef StreamTable<Entry> Table;
+
+    bool
+    samePage(Addr a, Addr b) const
+    {
+        return a / pageBytes == b / pageBytes;
+    }
+
+    Table entries;
+    const int _tableSize;
+    int degree;
+    int maxPrfOfs;
+    const bool slowStart;
+    const unsigned blkSize;
+    const Addr pageBytes;
+};
+
+#endif // __MEM_CACHE_PREFETCH_KSTREAM_TABLE_HH__
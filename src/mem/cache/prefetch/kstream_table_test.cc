@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "mem/cache/prefetch/kstream_table.hh"
+
+namespace {
+
+const unsigned blkSize = 64;
+const Addr pageBytes = 4096;
+
+/**
+ * Stand-in for the atomic cache: the lines are filled on a miss, and
+ * the table is trained either before the fill, as recvAtomic() does,
+ * or after it.
+ */
+struct AtomicCache
+{
+    std::set<Addr> lines;
+
+    KStreamTable::Outcome
+    access(KStreamTable &table, Addr addr, bool train_before_fill,
+           std::vector<Addr> &prefetches)
+    {
+        const Addr line = addr & ~Addr(blkSize - 1);
+        auto present = [&]() { return lines.count(line) != 0; };
+        bool is_store;
+
+        if (!train_before_fill)
+            lines.insert(line);
+        auto outcome = table.access(addr, false, present, prefetches,
+                                    is_store);
+        lines.insert(line);
+        return outcome;
+    }
+};
+
+} // anonymous namespace
+
+TEST(KStreamTableTest, WarmSequentialStream)
+{
+    // The L1 table of the KPrefetcher, with slow start
+    KStreamTable table(16, true, blkSize, pageBytes);
+    table.setDegree(4, 16 * blkSize);
+    AtomicCache cache;
+    std::vector<Addr> prefetches;
+
+    const Addr base = 0x10400;
+    EXPECT_EQ(KStreamTable::Started,
+              cache.access(table, base, true, prefetches));
+    EXPECT_EQ(2, table.size());
+    EXPECT_NE(nullptr, table.find(base + blkSize));
+    EXPECT_NE(nullptr, table.find(base - blkSize));
+
+    for (int i = 1; i < 8; i++) {
+        EXPECT_EQ(KStreamTable::Advanced,
+                  cache.access(table, base + i * blkSize, true,
+                               prefetches));
+    }
+
+    const KStreamTable::Entry *e = table.find(base + 8 * blkSize);
+    ASSERT_NE(nullptr, e);
+    EXPECT_TRUE(e->incr);
+    EXPECT_FALSE(prefetches.empty());
+    for (Addr a : prefetches)
+        EXPECT_GT(a, base + blkSize);
+}
+
+TEST(KStreamTableTest, TrainAfterFillStartsNoStream)
+{
+    KStreamTable table(16, true, blkSize, pageBytes);
+    table.setDegree(4, 16 * blkSize);
+    AtomicCache cache;
+    std::vector<Addr> prefetches;
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(KStreamTable::Ignored,
+                  cache.access(table, 0x10000 + i * blkSize, false,
+                               prefetches));
+    }
+    EXPECT_EQ(0, table.size());
+    EXPECT_TRUE(prefetches.empty());
+}
+
+TEST(KStreamTableTest, StreamsStopAtPageBoundary)
+{
+    KStreamTable table(16, false, blkSize, pageBytes);
+    table.setDegree(4, 16 * blkSize);
+    AtomicCache cache;
+    std::vector<Addr> prefetches;
+
+    const Addr last = 0x10000 + pageBytes - blkSize;
+    cache.access(table, last, true, prefetches);
+    EXPECT_EQ(nullptr, table.find(last + blkSize));
+    EXPECT_NE(nullptr, table.find(last - blkSize));
+}
@@ -130,6 +130,16 @@ QueuedPrefetcher::getPacket()
     return pkt;
 }
 
+void
+QueuedPrefetcher::dropPrefetches()
+{
+    for (DeferredPacket &dp : pfq) {
+        delete dp.pkt->req;
+        delete dp.pkt;
+    }
+    pfq.clear();
+}
+
 std::list<QueuedPrefetcher::DeferredPacket>::const_iterator
 QueuedPrefetcher::inPrefetch(Addr address, bool is_secure) const
 {
@@ -128,6 +128,8 @@ class QueuedPrefetcher : public BasePrefetcher
                                    std::vector<AddrPriority> &addresses) = 0;
     PacketPtr getPacket();
 
+    void dropPrefetches();
+
     Tick nextPrefetchReadyTime() const
     {
         return pfq.empty() ? MaxTick : pfq.front().tick;
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Hash-indexed, LRU-ordered table of prefetch streams.
+ */
+
+#ifndef __MEM_CACHE_PREFETCH_STREAM_TABLE_HH__
+#define __MEM_CACHE_PREFETCH_STREAM_TABLE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+/**
+ * A table of prefetch streams keyed by the address each stream expects
+ * to be accessed next.
+ *
+ * The table behaves like a list where new entries are always inserted
+ * at the front and the oldest entries are dropped from the back, but
+ * lookups go through a hash index instead of a linear search. Several
+ * entries may share a key; lookups then return the one closest to the
+ * front, i.e., the most recently inserted one.
+ *
+ * Entries live in a pool that is allocated up front, and both the LRU
+ * list and the hash chains are intrusive, so no memory is allocated
+ * after construction as long as the table does not grow beyond the
+ * initial pool size.
+ */
+template <class Entry>
+class StreamTable
+{
+  public:
+    /** Index of an entry in the table, or Invalid. */
+    typedef int Handle;
+    static const Handle Invalid = -1;
+
+  private:
+    struct Node
+    {
+        Entry entry;
+        Addr key;
+        /** Insertion order, larger is closer to the front. */
+        uint64_t stamp;
+        /** LRU list links; the free list reuses next. */
+        Handle prev;
+        Handle next;
+        /** Next node in the same hash bucket. */
+        Handle chain;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Handle> buckets;
+    unsigned bucketBits;
+
+    Handle head;
+    Handle tail;
+    Handle freeList;
+    size_t numEntries;
+    uint64_t nextStamp;
+
+    unsigned
+    bucketOf(Addr key) const
+    {
+        return (key * 0x9e3779b97f4a7c15ULL) >> (64 - bucketBits);
+    }
+
+    Handle
+    allocNode()
+    {
+        if (freeList == Invalid) {
+            nodes.emplace_back();
+            return nodes.size() - 1;
+        }
+        Handle h = freeList;
+        freeList = nodes[h].next;
+        return h;
+    }
+
+    void
+    unlinkChain(Handle h)
+    {
+        Handle *link = &buckets[bucketOf(nodes[h].key)];
+        while (*link != h) {
+            assert(*link != Invalid);
+            link = &nodes[*link].chain;
+        }
+        *link = nodes[h].chain;
+    }
+
+  public:
+    /**
+     * @param capacity Expected maximum number of live entries. The
+     * table may hold more, but then it allocates.
+     */
+    explicit StreamTable(size_t capacity)
+        : bucketBits(4), head(Invalid), tail(Invalid), freeList(Invalid),
+          numEntries(0), nextStamp(0)
+    {
+        while ((1ULL << bucketBits) < 2 * capacity)
+            bucketBits++;
+        buckets.assign(1ULL << bucketBits, Invalid);
+        nodes.reserve(capacity);
+    }
+
+    size_t size() const { return numEntries; }
+
+    Entry &operator[](Handle h) { return nodes[h].entry; }
+    const Entry &operator[](Handle h) const { return nodes[h].entry; }
+
+    /** Most recently inserted entry with the given key, or Invalid. */
+    Handle
+    find(Addr key) const
+    {
+        Handle found = Invalid;
+        for (Handle h = buckets[bucketOf(key)]; h != Invalid;
+             h = nodes[h].chain) {
+            if (nodes[h].key == key &&
+                (found == Invalid || nodes[h].stamp > nodes[found].stamp)) {
+                found = h;
+            }
+        }
+        return found;
+    }
+
+    /** Insert an entry at the front of the table. */
+    void
+    pushFront(Addr key, const Entry &entry)
+    {
+        Handle h = allocNode();
+        Node &n = nodes[h];
+        n.entry = entry;
+        n.key = key;
+        n.stamp = nextStamp++;
+
+        n.prev = Invalid;
+        n.next = head;
+        if (head != Invalid)
+            nodes[head].prev = h;
+        head = h;
+        if (tail == Invalid)
+            tail = h;
+
+        Handle &bucket = buckets[bucketOf(key)];
+        n.chain = bucket;
+        bucket = h;
+
+        numEntries++;
+    }
+
+    /** Remove an entry from the table. */
+    void
+    erase(Handle h)
+    {
+        Node &n = nodes[h];
+        unlinkChain(h);
+
+        if (n.prev != Invalid)
+            nodes[n.prev].next = n.next;
+        else
+            head = n.next;
+        if (n.next != Invalid)
+            nodes[n.next].prev = n.prev;
+        else
+            tail = n.prev;
+
+        n.next = freeList;
+        freeList = h;
+        numEntries--;
+    }
+
+    /** Drop the entries at the back until at most n are left. */
+    void
+    truncate(size_t n)
+    {
+        while (numEntries > n)
+            erase(tail);
+    }
+
+    /** Visit the entries from the front to the back. */
+    template <class F>
+    void
+    forEach(F f) const
+    {
+        for (Handle h = head; h != Invalid; h = nodes[h].next)
+            f(nodes[h].key, nodes[h].entry);
+    }
+};
+
+template <class Entry>
+const typename StreamTable<Entry>::Handle StreamTable<Entry>::Invalid;
+
+#endif // __MEM_CACHE_PREFETCH_STREAM_TABLE_HH__
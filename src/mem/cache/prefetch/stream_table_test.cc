@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "mem/cache/prefetch/stream_table.hh"
+
+namespace {
+
+struct TestEntry
+{
+    Addr key;
+    int value;
+};
+
+typedef StreamTable<TestEntry> Table;
+
+/**
+ * Reference model: the deque and linear search the KPrefetcher used
+ * before the stream table was introduced.
+ */
+struct DequeTable
+{
+    std::deque<TestEntry> entries;
+
+    std::deque<TestEntry>::iterator
+    find(Addr key)
+    {
+        return std::find_if(entries.begin(), entries.end(),
+                            [&](TestEntry &e) { return e.key == key; });
+    }
+};
+
+std::vector<TestEntry>
+contents(const Table &table)
+{
+    std::vector<TestEntry> v;
+    table.forEach([&](Addr key, const TestEntry &e) { v.push_back(e); });
+    return v;
+}
+
+/**
+ * Access pattern of a few interleaved streams plus random lines, which
+ * produces both hits and duplicate keys.
+ */
+Addr
+nextKey(std::mt19937 &rng, std::vector<Addr> &streams)
+{
+    std::uniform_int_distribution<int> pick(0, streams.size());
+    int s = pick(rng);
+    if (s == streams.size())
+        return (rng() % 4096) * 64;
+    streams[s] += 64;
+    return streams[s];
+}
+
+} // anonymous namespace
+
+TEST(StreamTableTest, Empty)
+{
+    Table table(8);
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_EQ(table.find(0x40), Table::Invalid);
+}
+
+TEST(StreamTableTest, PushFindErase)
+{
+    Table table(8);
+    table.pushFront(0x40, {0x40, 1});
+    table.pushFront(0x80, {0x80, 2});
+    ASSERT_EQ(table.size(), 2);
+
+    Table::Handle h = table.find(0x40);
+    ASSERT_NE(h, Table::Invalid);
+    ASSERT_EQ(table[h].value, 1);
+
+    table.erase(h);
+    ASSERT_EQ(table.size(), 1);
+    ASSERT_EQ(table.find(0x40), Table::Invalid);
+    ASSERT_NE(table.find(0x80), Table::Invalid);
+}
+
+/** Duplicate keys resolve to the most recently inserted entry */
+TEST(StreamTableTest, DuplicateKeys)
+{
+    Table table(8);
+    table.pushFront(0x40, {0x40, 1});
+    table.pushFront(0x40, {0x40, 2});
+    table.pushFront(0x80, {0x80, 3});
+
+    Table::Handle h = table.find(0x40);
+    ASSERT_EQ(table[h].value, 2);
+    table.erase(h);
+    h = table.find(0x40);
+    ASSERT_EQ(table[h].value, 1);
+}
+
+/** Truncation drops the oldest entries */
+TEST(StreamTableTest, Truncate)
+{
+    Table table(4);
+    for (int i = 0; i < 6; i++)
+        table.pushFront(i * 64, {Addr(i * 64), i});
+    table.truncate(4);
+
+    ASSERT_EQ(table.size(), 4);
+    ASSERT_EQ(table.find(0), Table::Invalid);
+    ASSERT_EQ(table.find(64), Table::Invalid);
+
+    std::vector<TestEntry> v = contents(table);
+    ASSERT_EQ(v.size(), 4);
+    for (int i = 0; i < 4; i++)
+        ASSERT_EQ(v[i].value, 5 - i);
+}
+
+/**
+ * Replays the KPrefetcher table updates on both the stream table and
+ * the deque it replaced, and checks that they stay identical.
+ */
+TEST(StreamTableTest, MatchesDeque)
+{
+    const size_t capacity = 20;
+    Table table(capacity + 2);
+    DequeTable ref;
+    std::mt19937 rng(1);
+    std::vector<Addr> streams = {0x10000, 0x20000, 0x30000, 0x40000};
+
+    for (int i = 0; i < 100000; i++) {
+        Addr key = nextKey(rng, streams);
+        Table::Handle h = table.find(key);
+        auto it = ref.find(key);
+
+        ASSERT_EQ(h == Table::Invalid, it == ref.entries.end());
+        if (h != Table::Invalid) {
+            ASSERT_EQ(table[h].value, it->value);
+            TestEntry e = {key + 64, i};
+            table.erase(h);
+            ref.entries.erase(it);
+            table.pushFront(e.key, e);
+            ref.entries.push_front(e);
+        } else {
+            TestEntry fwd = {key + 64, i};
+            TestEntry back = {key - 64, -i};
+            table.pushFront(fwd.key, fwd);
+            ref.entries.push_front(fwd);
+            table.pushFront(back.key, back);
+            ref.entries.push_front(back);
+            table.truncate(capacity);
+            if (ref.entries.size() > capacity)
+                ref.entries.resize(capacity);
+        }
+
+        ASSERT_EQ(table.size(), ref.entries.size());
+    }
+
+    std::vector<TestEntry> v = contents(table);
+    for (int i = 0; i < v.size(); i++) {
+        ASSERT_EQ(v[i].key, ref.entries[i].key);
+        ASSERT_EQ(v[i].value, ref.entries[i].value);
+    }
+}
+
+/**
+ * Compares the lookup and update cost of both tables for a large
+ * table. Disabled by default; run with
+ * --gtest_also_run_disabled_tests --gtest_output=xml to get the times
+ * as properties of the test.
+ */
+TEST(StreamTableTest, DISABLED_Benchmark)
+{
+    const size_t capacity = 1024;
+    const int accesses = 1000000;
+    std::vector<Addr> streams;
+    for (int i = 0; i < 256; i++)
+        streams.push_back(0x100000 * (i + 1));
+
+    std::mt19937 rng(1);
+    std::vector<Addr> keys;
+    for (int i = 0; i < accesses; i++)
+        keys.push_back(nextKey(rng, streams));
+
+    typedef std::chrono::steady_clock Clock;
+
+    Table table(capacity + 2);
+    auto start = Clock::now();
+    for (Addr key : keys) {
+        Table::Handle h = table.find(key);
+        if (h != Table::Invalid) {
+            table.erase(h);
+            table.pushFront(key + 64, {key + 64, 0});
+        } else {
+            table.pushFront(key + 64, {key + 64, 0});
+            table.pushFront(key - 64, {key - 64, 0});
+            table.truncate(capacity);
+        }
+    }
+    auto table_time = Clock::now() - start;
+
+    DequeTable ref;
+    start = Clock::now();
+    for (Addr key : keys) {
+        auto it = ref.find(key);
+        if (it != ref.entries.end()) {
+            ref.entries.erase(it);
+            ref.entries.push_front({key + 64, 0});
+        } else {
+            ref.entries.push_front({key + 64, 0});
+            ref.entries.push_front({key - 64, 0});
+            if (ref.entries.size() > capacity)
+                ref.entries.resize(capacity);
+        }
+    }
+    auto deque_time = Clock::now() - start;
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    RecordProperty("table_us",
+                   duration_cast<microseconds>(table_time).count());
+    RecordProperty("deque_us",
+                   duration_cast<microseconds>(deque_time).count());
+    ASSERT_LT(table_time, deque_time);
+}
@@ -50,6 +50,8 @@
 #define __MEM_CACHE_QUEUE_HH__
 
 #include <cassert>
+#include <unordered_map>
+#include <vector>
 
 #include "base/trace.hh"
 #include "debug/Cache.hh"
@@ -88,32 +90,86 @@ class Queue : public Drainable
     std::vector<Entry> entries;
     /** Holds pointers to all allocated entries. */
     typename Entry::List allocatedList;
-    /** Holds pointers to entries that haven't been sent downstream. */
-    typename Entry::List readyList;
+    /**
+     * Holds pointers to entries that haven't been sent downstream,
+     * sorted by ready time. Entries with the same ready time are kept
+     * in the order they were added.
+     */
+    typename Entry::ReadyList readyList;
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
-    typename Entry::Iterator addToReadyList(Entry* entry)
+    /** All allocated entries, indexed by block address. */
+    std::unordered_multimap<Addr, Entry*> addrIndex;
+
+    /**
+     * The entries of the ready list per master, in the same order,
+     * used by the round-robin policy.
+     */
+    std::unordered_map<MasterID, typename Entry::ReadyList> masterReadyLists;
+
+    /** Next allocation sequence number. */
+    uint64_t nextAllocSeq;
+    /** Next sequence number for the back and front of the ready list. */
+    int64_t nextReadySeq;
+    int64_t nextFrontSeq;
+
+    void addToAllocatedList(Entry* entry)
+    {
+        entry->allocSeq = nextAllocSeq++;
+        entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+        addrIndex.emplace(entry->blkAddr, entry);
+    }
+
+    void removeFromAllocatedList(Entry* entry)
+    {
+        allocatedList.erase(entry->allocIter);
+        auto range = addrIndex.equal_range(entry->blkAddr);
+        for (auto i = range.first; i != range.second; ++i) {
+            if (i->second == entry) {
+                addrIndex.erase(i);
+                return;
+            }
+        }
+        assert(false);
+    }
+
+    /**
+     * Adds an entry to the ready list, after all entries that are
+     * ready at the same time or earlier, or before all entries if
+     * front is true.
+     */
+    typename Entry::ReadyList::iterator addToReadyList(Entry* entry,
+                                                       bool front = false)
     {
-        std::vector<MasterID>::iterator exist;
-        exist = std::find(masterIDs.begin(), masterIDs.end(), entry->masterId);
-        if (exist == masterIDs.end()){
+        auto master = masterReadyLists.find(entry->masterId);
+        if (master == masterReadyLists.end()){
             DPRINTF(Cache, "New Master %d\n", entry->masterId);
+            master = masterReadyLists.emplace(
+                entry->masterId, typename Entry::ReadyList()).first;
             masterIDs.push_back(entry->masterId);
             curMaster = masterIDs.begin();
         }
 
-        if (readyList.empty() ||
-            readyList.back()->readyTime <= entry->readyTime) {
-            return readyList.insert(readyList.end(), entry);
-        }
-        for (auto i = readyList.begin(); i != readyList.end(); ++i) {
-            if ((*i)->readyTime > entry->readyTime) {
-                return readyList.insert(i, entry);
-            }
+        if (front) {
+            entry->readyRank = 0;
+            entry->readySeq = nextFrontSeq--;
+        } else {
+            entry->readyRank = entry->readyTime;
+            entry->readySeq = nextReadySeq++;
         }
-        assert(false);
-        return readyList.end();  // keep stupid compilers happy
+
+        if (useMasterIDs)
+            master->second.insert(entry);
+        return readyList.insert(entry).first;
+    }
+
+    void removeFromReadyList(Entry* entry)
+    {
+        assert(entry == *(entry->readyIter));
+        readyList.erase(entry->readyIter);
+        if (useMasterIDs)
+            masterReadyLists[entry->masterId].erase(entry);
     }
 
     /** The number of entries that are in service. */
@@ -135,7 +191,8 @@ class Queue : public Drainable
     Queue(const std::string &_label, int num_entries, int reserve,
           bool use_master_id) :
         label(_label), numEntries(num_entries + reserve),
-        numReserve(reserve), entries(numEntries), _numInService(0),
+        numReserve(reserve), entries(numEntries),
+        nextAllocSeq(0), nextReadySeq(0), nextFrontSeq(-1), _numInService(0),
         allocated(0),useMasterIDs(use_master_id)
     {
         for (int i = 0; i < numEntries; ++i) {
@@ -167,19 +224,22 @@ class Queue : public Drainable
      */
     Entry* findMatch(Addr blk_addr, bool is_secure) const
     {
-        for (const auto& entry : allocatedList) {
+        Entry *match = nullptr;
+        auto range = addrIndex.equal_range(blk_addr);
+        for (auto i = range.first; i != range.second; ++i) {
+            Entry *entry = i->second;
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
             // uncacheable entries, and we do not want normal
             // cacheable accesses being added to an WriteQueueEntry
             // serving an uncacheable access
-            if (!entry->isUncacheable() && entry->blkAddr == blk_addr &&
-                entry->isSecure == is_secure) {
-                return entry;
+            if (!entry->isUncacheable() && entry->isSecure == is_secure &&
+                (!match || entry->allocSeq < match->allocSeq)) {
+                match = entry;
             }
         }
-        return nullptr;
+        return match;
     }
 
     bool checkFunctional(PacketPtr pkt, Addr blk_addr)
@@ -203,12 +263,16 @@ class Queue : public Drainable
      */
     Entry* findPending(Addr blk_addr, bool is_secure) const
     {
-        for (const auto& entry : readyList) {
-            if (entry->blkAddr == blk_addr && entry->isSecure == is_secure) {
-                return entry;
+        Entry *match = nullptr;
+        auto range = addrIndex.equal_range(blk_addr);
+        for (auto i = range.first; i != range.second; ++i) {
+            Entry *entry = i->second;
+            if (!entry->inService && entry->isSecure == is_secure &&
+                (!match || QueueEntry::ReadyOrder()(entry, match))) {
+                match = entry;
             }
         }
-        return nullptr;
+        return match;
     }
 
     /**
@@ -217,7 +281,8 @@ class Queue : public Drainable
      */
     Entry* getNext()
     {
-        if (readyList.empty() || readyList.front()->readyTime > curTick()) {
+        if (readyList.empty() ||
+            (*readyList.begin())->readyTime > curTick()) {
             return nullptr;
         }
 
@@ -236,25 +301,29 @@ class Queue : public Drainable
         }
 #endif
         if (!useMasterIDs)
-            return readyList.front();
+            return *readyList.begin();
 
         assert(curMaster != masterIDs.end());
 
         auto origMaster = curMaster;
         Entry * res = nullptr;
         do{
-            auto it = std::find_if(readyList.begin(), readyList.end(),
-                                 [&](Entry *e){
-                                     return ((e->readyTime <= curTick())&&
-                                             (e->masterId == *curMaster));
-                                 });
+            for (Entry *e : masterReadyLists[*curMaster]) {
+                if (e->readyTime <= curTick()) {
+                    res = e;
+                    break;
+                }
+                // past the entries moved to the front, the list is
+                // sorted by ready time
+                if (e->readyRank == e->readyTime)
+                    break;
+            }
             ++curMaster;
             if (curMaster == masterIDs.end()){
                 curMaster = masterIDs.begin();
             }
 
-            if (it != readyList.end()){
-                res = *it;
+            if (res){
                 break;
             }
         }while (curMaster != origMaster);
@@ -264,7 +333,7 @@ class Queue : public Drainable
 
     Tick nextReadyTime() const
     {
-        return readyList.empty() ? MaxTick : readyList.front()->readyTime;
+        return readyList.empty() ? MaxTick : (*readyList.begin())->readyTime;
     }
 
     /**
@@ -275,13 +344,13 @@ class Queue : public Drainable
      */
     void deallocate(Entry *entry)
     {
-        allocatedList.erase(entry->allocIter);
+        removeFromAllocatedList(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
             _numInService--;
         } else {
-            readyList.erase(entry->readyIter);
+            removeFromReadyList(entry);
         }
         entry->deallocate();
         if (drainState() == DrainState::Draining && allocated == 0) {
@@ -75,8 +75,30 @@ class QueueEntry : public Packet::SenderState
     bool _isUncacheable;
 
     MasterID masterId;
+
+    /** Allocation sequence number, used to find the oldest match. */
+    uint64_t allocSeq;
+
+    /**
+     * Position on the ready list. Entries are ordered by rank, which
+     * is the ready time unless the entry was moved to the front, and
+     * then by sequence number.
+     */
+    Tick readyRank;
+    int64_t readySeq;
+
   public:
 
+    /** Orders the entries of a ready list. */
+    struct ReadyOrder
+    {
+        bool operator()(const QueueEntry *a, const QueueEntry *b) const
+        {
+            return a->readyRank != b->readyRank ?
+                a->readyRank < b->readyRank : a->readySeq < b->readySeq;
+        }
+    };
+
     /** True if the entry has been sent downstream. */
     bool inService;
 
@@ -92,7 +114,8 @@ class QueueEntry : public Packet::SenderState
     /** True if the entry targets the secure memory space. */
     bool isSecure;
 
-    QueueEntry() : readyTime(0), _isUncacheable(false),
+    QueueEntry() : readyTime(0), _isUncacheable(false), allocSeq(0),
+                   readyRank(0), readySeq(0),
                    inService(false), order(0), blkAddr(0), blkSize(0),
                    isSecure(false)
     {}
@@ -58,6 +58,7 @@ BaseTags::BaseTags(const Params *p)
     : ClockedObject(p), blkSize(p->block_size), blkMask(blkSize - 1),
       size(p->size),
       lookupLatency(p->tag_latency),
+      sequentialAccess(p->sequential_access),
       accessLatency(p->sequential_access ?
                     p->tag_latency + p->data_latency :
                     std::max(p->tag_latency, p->data_latency)),
@@ -67,6 +68,14 @@ BaseTags::BaseTags(const Params *p)
 {
 }
 
+void
+BaseTags::setLatencies(Cycles tag_latency, Cycles data_latency)
+{
+    lookupLatency = tag_latency;
+    accessLatency = sequentialAccess ? tag_latency + data_latency :
+                                       std::max(tag_latency, data_latency);
+}
+
 void
 BaseTags::setCache(BaseCache *_cache)
 {
@@ -72,13 +72,15 @@ class BaseTags : public ClockedObject
     /** The size of the cache. */
     const unsigned size;
     /** The tag lookup latency of the cache. */
-    const Cycles lookupLatency;
+    Cycles lookupLatency;
+    /** Whether the data array is accessed after the tags. */
+    const bool sequentialAccess;
     /**
      * The total access latency of the cache. This latency
      * is different depending on the cache access mode
      * (parallel or sequential)
      */
-    const Cycles accessLatency;
+    Cycles accessLatency;
     /** Pointer to the parent cache. */
     BaseCache *cache;
 
@@ -163,6 +165,14 @@ class BaseTags : public ClockedObject
      */
     void setCache(BaseCache *_cache);
 
+    /**
+     * Change the tag and data array latencies. The access latency is
+     * recomputed from them for parallel or sequential access.
+     * @param tag_latency New tag lookup latency.
+     * @param data_latency New data array latency.
+     */
+    void setLatencies(Cycles tag_latency, Cycles data_latency);
+
     /**
      * Register local statistics.
      */
@@ -77,11 +77,15 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
     setMask = numSets - 1;
     tagShift = setShift + floorLog2(numSets);
 
+    blkTags.resize(numSets * assoc);
+
     unsigned blkIndex = 0;       // index into blks array
     for (unsigned i = 0; i < numSets; ++i) {
         sets[i].assoc = assoc;
 
         sets[i].blks.resize(assoc);
+        sets[i].wayBlks = &blks[blkIndex];
+        sets[i].wayTags = &blkTags[blkIndex];
 
         // link in the data blocks
         for (unsigned j = 0; j < assoc; ++j) {
@@ -97,6 +101,7 @@ BaseSetAssoc::BaseSetAssoc(const Params *p)
             // Setting the tag to j is just to prevent long chains in the
             // hash table; won't matter because the block is invalid
             blk->tag = j;
+            blkTags[blkIndex] = j;
 
             // Set its set and way
             blk->set = i;
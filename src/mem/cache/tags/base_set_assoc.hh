@@ -90,6 +90,8 @@ class BaseSetAssoc : public BaseTags
 
     /** The cache blocks. */
     std::vector<BlkType> blks;
+    /** The tags of the blocks, packed per set, see CacheSet. */
+    std::vector<Addr> blkTags;
     /** The data blocks, 1 per cache block. */
     std::unique_ptr<uint8_t[]> dataBlks;
 
@@ -248,6 +250,7 @@ public:
 
          // Set tag for new block.  Caller is responsible for setting status.
          blk->tag = extractTag(addr);
+         sets[blk->set].wayTags[blk->way] = blk->tag;
 
          // deal with what we are bringing in
          assert(master_id < cache->system->maxMasters());
@@ -48,10 +48,23 @@
 #ifndef __MEM_CACHE_TAGS_CACHESET_HH__
 #define __MEM_CACHE_TAGS_CACHESET_HH__
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
 
 /**
  * An associative set of cache blocks.
+ *
+ * Besides the blocks in LRU order, the set sees its blocks in way order
+ * together with a packed array of their tags. Lookups compare the whole
+ * tag array first, which stays within one or two host cache lines and
+ * vectorises, and only look at the blocks whose tag matches. The array
+ * is a filter: the owner writes a block's tag there whenever it gives
+ * the block a new tag, and a match is confirmed against the block
+ * itself, so tags left behind by invalidated blocks are harmless.
  */
 template <class Blktype>
 class CacheSet
@@ -63,6 +76,12 @@ class CacheSet
     /** Cache blocks in this set, maintained in LRU order 0 = MRU. */
     std::vector<Blktype*> blks;
 
+    /** The blocks of this set indexed by way, assoc of them. */
+    Blktype *wayBlks;
+
+    /** The last tag given to the block in each way, assoc of them. */
+    Addr *wayTags;
+
     /**
      * Find a block matching the tag in this set.
      * @param way_id The id of the way that matches the tag.
@@ -95,23 +114,35 @@ CacheSet<Blktype>::findBlk(Addr tag, bool is_secure, int& way_id) const
      * Way_id returns the id of the way that matches the block
      * If no block is found way_id is set to assoc.
      */
-    way_id = assoc;
-    for (int i = 0; i < assoc; ++i) {
-        if (blks[i]->tag == tag && blks[i]->isValid() &&
-            blks[i]->isSecure() == is_secure) {
-            way_id = i;
-            return blks[i];
-        }
-    }
-    return nullptr;
+    Blktype *blk = findBlk(tag, is_secure);
+    way_id = blk ? std::find(blks.begin(), blks.end(), blk) - blks.begin()
+                 : assoc;
+    return blk;
 }
 
 template <class Blktype>
 Blktype*
 CacheSet<Blktype>::findBlk(Addr tag, bool is_secure) const
 {
-    int ignored_way_id;
-    return findBlk(tag, is_secure, ignored_way_id);
+    for (int base = 0; base < assoc; base += 64) {
+        const int ways = std::min(assoc - base, 64);
+        const Addr *tags = wayTags + base;
+
+        // Branch-free so that the compiler compares several tags at once
+        uint64_t matches = 0;
+        for (int i = 0; i < ways; ++i)
+            matches |= uint64_t(tags[i] == tag) << i;
+
+        while (matches) {
+            Blktype *blk = &wayBlks[base + __builtin_ctzll(matches)];
+            if (blk->tag == tag && blk->isValid() &&
+                blk->isSecure() == is_secure) {
+                return blk;
+            }
+            matches &= matches - 1;
+        }
+    }
+    return nullptr;
 }
 
 template <class Blktype>
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/cacheset.hh"
+
+namespace
+{
+
+/** The parts of CacheBlk a set looks at, padded to a similar size. */
+struct Blk
+{
+    Addr tag;
+    bool valid;
+    bool secure;
+    uint8_t pad[112];
+
+    bool isValid() const { return valid; }
+    bool isSecure() const { return secure; }
+};
+
+/** Sets over one array of blocks and tags, laid out like BaseSetAssoc. */
+struct Sets
+{
+    std::vector<Blk> blks;
+    std::vector<Addr> tags;
+    std::vector<CacheSet<Blk>> sets;
+
+    Sets(int num_sets, int assoc)
+        : blks(num_sets * assoc), tags(num_sets * assoc), sets(num_sets)
+    {
+        for (int i = 0; i < num_sets; ++i) {
+            CacheSet<Blk> &set = sets[i];
+            set.assoc = assoc;
+            set.wayBlks = &blks[i * assoc];
+            set.wayTags = &tags[i * assoc];
+            for (int j = 0; j < assoc; ++j) {
+                set.blks.push_back(&set.wayBlks[j]);
+                set.wayBlks[j].tag = j;
+                set.wayBlks[j].valid = false;
+                set.wayBlks[j].secure = false;
+                set.wayTags[j] = j;
+            }
+        }
+    }
+
+    /** Give a block a new tag, as BaseSetAssoc::insertBlock does. */
+    void
+    insert(int set, int way, Addr tag, bool secure)
+    {
+        Blk &blk = sets[set].wayBlks[way];
+        blk.tag = tag;
+        blk.valid = true;
+        blk.secure = secure;
+        sets[set].wayTags[way] = tag;
+    }
+
+    /** Invalidate a block, as CacheBlk::invalidate does. */
+    void
+    invalidate(int set, int way)
+    {
+        Blk &blk = sets[set].wayBlks[way];
+        blk.tag = MaxAddr;
+        blk.valid = false;
+        blk.secure = false;
+    }
+};
+
+/** The lookup as it was, walking the blocks in LRU order. */
+Blk *
+refFindBlk(const CacheSet<Blk> &set, Addr tag, bool is_secure, int &way_id)
+{
+    way_id = set.assoc;
+    for (int i = 0; i < set.assoc; ++i) {
+        if (set.blks[i]->tag == tag && set.blks[i]->isValid() &&
+            set.blks[i]->isSecure() == is_secure) {
+            way_id = i;
+            return set.blks[i];
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+TEST(CacheSetTest, FindBlk)
+{
+    Sets s(1, 4);
+    CacheSet<Blk> &set = s.sets[0];
+    int way_id;
+
+    // Invalid blocks never match, even though their tags do.
+    EXPECT_EQ(nullptr, set.findBlk(2, false, way_id));
+    EXPECT_EQ(4, way_id);
+
+    s.insert(0, 2, 0x40, false);
+    s.insert(0, 3, 0x40, true);
+    EXPECT_EQ(&set.wayBlks[2], set.findBlk(0x40, false, way_id));
+    EXPECT_EQ(2, way_id);
+    EXPECT_EQ(&set.wayBlks[3], set.findBlk(0x40, true, way_id));
+    EXPECT_EQ(3, way_id);
+    EXPECT_EQ(nullptr, set.findBlk(0x80, false));
+
+    // way_id is the position in LRU order.
+    set.moveToHead(&set.wayBlks[3]);
+    EXPECT_EQ(&set.wayBlks[3], set.findBlk(0x40, true, way_id));
+    EXPECT_EQ(0, way_id);
+    EXPECT_EQ(&set.wayBlks[2], set.findBlk(0x40, false, way_id));
+    EXPECT_EQ(3, way_id);
+}
+
+TEST(CacheSetTest, StaleTags)
+{
+    Sets s(1, 16);
+    CacheSet<Blk> &set = s.sets[0];
+
+    // The tag array keeps the tag of an invalidated block.
+    s.insert(0, 5, 0x1000, false);
+    s.invalidate(0, 5);
+    EXPECT_EQ(0x1000, set.wayTags[5]);
+    EXPECT_EQ(nullptr, set.findBlk(0x1000, false));
+
+    // Another way taking the tag is still found behind the stale entry.
+    s.insert(0, 9, 0x1000, false);
+    EXPECT_EQ(&set.wayBlks[9], set.findBlk(0x1000, false));
+}
+
+TEST(CacheSetTest, MatchesLinearSearch)
+{
+    std::mt19937 rng(1);
+    for (int assoc : {1, 2, 4, 8, 16, 20, 64, 70, 130}) {
+        Sets s(4, assoc);
+        for (int i = 0; i < 20000; ++i) {
+            const int set = rng() % 4;
+            const int way = rng() % assoc;
+            // Few tags so that lookups hit and tags repeat within a set
+            const Addr tag = rng() % (2 * assoc);
+            const bool secure = rng() % 8 == 0;
+            switch (rng() % 4) {
+              case 0:
+                s.insert(set, way, tag, secure);
+                break;
+              case 1:
+                s.invalidate(set, way);
+                break;
+              case 2:
+                s.sets[set].moveToHead(&s.sets[set].wayBlks[way]);
+                break;
+              default:
+                break;
+            }
+
+            int way_id, ref_way_id;
+            Blk *ref = refFindBlk(s.sets[set], tag, secure, ref_way_id);
+            Blk *blk = s.sets[set].findBlk(tag, secure, way_id);
+            // Duplicate valid tags cannot happen in a cache, but can here
+            if (ref && blk != ref) {
+                ASSERT_NE(nullptr, blk) << assoc << " " << i;
+                EXPECT_EQ(tag, blk->tag);
+                EXPECT_TRUE(blk->isValid());
+                EXPECT_EQ(secure, blk->isSecure());
+                EXPECT_EQ(blk, s.sets[set].blks[way_id]);
+            } else {
+                ASSERT_EQ(ref, blk) << assoc << " " << i;
+                ASSERT_EQ(ref_way_id, way_id) << assoc << " " << i;
+            }
+        }
+    }
+}
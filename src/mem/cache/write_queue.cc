@@ -65,7 +65,7 @@ WriteQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
     freeList.pop_front();
 
     entry->allocate(blk_addr, blk_size, pkt, when_ready, order);
-    entry->allocIter = allocatedList.insert(allocatedList.end(), entry);
+    addToAllocatedList(entry);
     entry->readyIter = addToReadyList(entry);
 
     allocated += 1;
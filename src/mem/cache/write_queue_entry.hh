@@ -50,6 +50,7 @@
 #define __MEM_CACHE_WRITE_QUEUE_ENTRY_HH__
 
 #include <list>
+#include <set>
 
 #include "base/printable.hh"
 #include "mem/cache/queue_entry.hh"
@@ -100,6 +101,8 @@ class WriteQueueEntry : public QueueEntry, public Printable
     typedef std::list<WriteQueueEntry *> List;
     /** WriteQueueEntry list iterator. */
     typedef List::iterator Iterator;
+    /** A ready list, kept in issue order. */
+    typedef std::set<WriteQueueEntry *, ReadyOrder> ReadyList;
 
     bool sendPacket(Cache &cache);
 
@@ -109,7 +112,7 @@ class WriteQueueEntry : public QueueEntry, public Printable
      * Pointer to this entry on the ready list.
      * @sa MissQueue, WriteQueue::readyList
      */
-    Iterator readyIter;
+    ReadyList::iterator readyIter;
 
     /**
      * Pointer to this entry on the allocated list.
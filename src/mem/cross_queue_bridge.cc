@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Implementation of a bridge between ports simulated on different
+ * event queues.
+ */
+
+#include "mem/cross_queue_bridge.hh"
+
+#include <algorithm>
+#include <initializer_list>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/CrossQueueBridge.hh"
+#include "sim/eventq_impl.hh"
+
+CrossQueueBridge::Channel::Channel(CrossQueueBridge &_bridge,
+                                   const std::string &_name)
+    : digest(0xcbf29ce484222325ULL), bridge(_bridge), _name(_name),
+      eventq(nullptr), lastWhen(0), waitingRetry(false),
+      pollEvent([this]{ poll(); }, _name + ".poll"),
+      sendEvent([this]{ trySend(); }, _name + ".send")
+{
+}
+
+void
+CrossQueueBridge::Channel::push(PacketPtr pkt, bool snoop)
+{
+    // the bridge has no notion of header and payload delays, add them
+    // to the delivery time like the crossbars do
+    Tick when = curTick() + bridge.delay + pkt->headerDelay +
+        pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    // keep the packets in order, the receiver relies on the inbox
+    // being sorted by delivery time
+    when = std::max(when, lastWhen);
+    lastWhen = when;
+
+    ++bridge.inFlight;
+
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    inbox.push_back(InFlight{when, pkt, snoop});
+}
+
+void
+CrossQueueBridge::Channel::start(EventQueue *eq)
+{
+    eventq = eq;
+    eventq->schedule(&pollEvent, curTick());
+}
+
+void
+CrossQueueBridge::Channel::poll()
+{
+    // The sending side is at most one quantum behind us and sends
+    // packets at least the bridge delay into the future. Packets
+    // delivered before the horizon can thus no longer be preceded by
+    // a packet that has not been pushed yet.
+    const Tick horizon = curTick() + bridge.delay - simQuantum;
+
+    {
+        std::lock_guard<std::mutex> lock(inboxMutex);
+        while (!inbox.empty() && inbox.front().when < horizon) {
+            ready.push_back(inbox.front());
+            inbox.pop_front();
+        }
+    }
+
+    if (!ready.empty() && !waitingRetry && !sendEvent.scheduled())
+        eventq->schedule(&sendEvent, std::max(ready.front().when,
+                                              curTick()));
+
+    // packets not picked up now are due no earlier than the next poll
+    eventq->schedule(&pollEvent, curTick() + bridge.delay - simQuantum);
+}
+
+void
+CrossQueueBridge::Channel::trySend()
+{
+    assert(!ready.empty());
+
+    const InFlight &head = ready.front();
+
+    DPRINTF(CrossQueueBridge, "%s: delivering %s addr %#x\n", _name,
+            head.pkt->cmdString(), head.pkt->getAddr());
+
+    // the receiver may delete the packet, so fold it into the digest
+    // before delivering it
+    uint64_t d = digest;
+    for (uint64_t v : { (uint64_t)curTick(),
+                        (uint64_t)head.pkt->cmdToIndex(),
+                        (uint64_t)head.pkt->getAddr(),
+                        (uint64_t)head.pkt->getSize() }) {
+        d ^= v;
+        d *= 0x100000001b3ULL;
+    }
+
+    if (!deliver(head.pkt, head.snoop)) {
+        DPRINTF(CrossQueueBridge, "%s: receiver busy\n", _name);
+        waitingRetry = true;
+        return;
+    }
+
+    digest = d;
+    ++packets;
+    ready.pop_front();
+
+    if (!ready.empty())
+        eventq->schedule(&sendEvent, std::max(ready.front().when,
+                                              curTick()));
+
+    if (--bridge.inFlight == 0 &&
+        bridge.drainState() == DrainState::Draining) {
+        bridge.signalDrainDone();
+    }
+}
+
+void
+CrossQueueBridge::Channel::retry()
+{
+    assert(waitingRetry);
+    waitingRetry = false;
+    trySend();
+}
+
+bool
+CrossQueueBridge::Channel::checkFunctional(PacketPtr pkt)
+{
+    auto check = [pkt](const InFlight &f) {
+        return !f.snoop && pkt->checkFunctional(f.pkt);
+    };
+
+    std::lock_guard<std::mutex> lock(inboxMutex);
+    if (std::any_of(ready.begin(), ready.end(), check) ||
+        std::any_of(inbox.begin(), inbox.end(), check)) {
+        pkt->makeResponse();
+        return true;
+    }
+    return false;
+}
+
+CrossQueueBridge::BridgeSlavePort::BridgeSlavePort(
+        const std::string &_name, CrossQueueBridge &_bridge)
+    : SlavePort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+bool
+CrossQueueBridge::BridgeSlavePort::recvTimingReq(PacketPtr pkt)
+{
+    DPRINTF(CrossQueueBridge, "recvTimingReq: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    bridge.reqChannel.push(pkt, false);
+    return true;
+}
+
+void
+CrossQueueBridge::BridgeSlavePort::recvRespRetry()
+{
+    bridge.respChannel.retry();
+}
+
+Tick
+CrossQueueBridge::BridgeSlavePort::recvAtomic(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(bridge.eventQueue(),
+                                        inParallelMode);
+    return bridge.delay + bridge.masterPort.sendAtomic(pkt);
+}
+
+void
+CrossQueueBridge::BridgeSlavePort::recvFunctional(PacketPtr pkt)
+{
+    // functional accesses, e.g., from syscall emulation, are made by
+    // the CPU side; move over to the memory side before touching it
+    EventQueue::ScopedMigration migrate(bridge.eventQueue(),
+                                        inParallelMode);
+
+    pkt->pushLabel(name());
+
+    // the packets in flight are the most recent ones, check the
+    // responses first as they are younger than the requests
+    bool done = bridge.respChannel.checkFunctional(pkt) ||
+        bridge.reqChannel.checkFunctional(pkt);
+
+    pkt->popLabel();
+
+    if (!done)
+        bridge.masterPort.sendFunctional(pkt);
+}
+
+AddrRangeList
+CrossQueueBridge::BridgeSlavePort::getAddrRanges() const
+{
+    return bridge.masterPort.getAddrRanges();
+}
+
+CrossQueueBridge::BridgeMasterPort::BridgeMasterPort(
+        const std::string &_name, CrossQueueBridge &_bridge)
+    : MasterPort(_name, &_bridge), bridge(_bridge)
+{
+}
+
+bool
+CrossQueueBridge::BridgeMasterPort::recvTimingResp(PacketPtr pkt)
+{
+    DPRINTF(CrossQueueBridge, "recvTimingResp: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    bridge.respChannel.push(pkt, false);
+    return true;
+}
+
+void
+CrossQueueBridge::BridgeMasterPort::recvReqRetry()
+{
+    bridge.reqChannel.retry();
+}
+
+void
+CrossQueueBridge::BridgeMasterPort::recvTimingSnoopReq(PacketPtr pkt)
+{
+    DPRINTF(CrossQueueBridge, "recvTimingSnoopReq: %s addr %#x\n",
+            pkt->cmdString(), pkt->getAddr());
+
+    // The snooping cache is done with the packet once we return, and
+    // the requestor may free the request before the snoop reaches
+    // the CPU. Forward a copy of both; the CPU never responds to a
+    // snoop, so nothing has to be passed back.
+    RequestPtr req = new Request(*pkt->req);
+    req->setPaddr(pkt->getAddr());
+    bridge.respChannel.push(new Packet(req, pkt->cmd), true);
+}
+
+Tick
+CrossQueueBridge::BridgeMasterPort::recvAtomicSnoop(PacketPtr pkt)
+{
+    return bridge.delay + bridge.slavePort.sendAtomicSnoop(pkt);
+}
+
+void
+CrossQueueBridge::BridgeMasterPort::recvFunctionalSnoop(PacketPtr pkt)
+{
+    // the CPU side runs on another host thread in parallel mode and
+    // does not hold any data, so only forward snoops when serial
+    if (!inParallelMode)
+        bridge.slavePort.sendFunctionalSnoop(pkt);
+}
+
+bool
+CrossQueueBridge::BridgeMasterPort::isSnooping() const
+{
+    return bridge.slavePort.isSnooping();
+}
+
+void
+CrossQueueBridge::BridgeMasterPort::recvRangeChange()
+{
+    bridge.slavePort.sendRangeChange();
+}
+
+CrossQueueBridge::CrossQueueBridge(Params *p)
+    : MemObject(p),
+      slavePort(p->name + ".slave", *this),
+      masterPort(p->name + ".master", *this),
+      delay(p->delay),
+      cpuSideEventQueue(getEventQueue(p->cpu_side_eventq_index)),
+      reqChannel(*this, p->name + ".req"),
+      respChannel(*this, p->name + ".resp"),
+      inFlight(0)
+{
+    reqChannel.deliver = [this](PacketPtr pkt, bool snoop) {
+        return masterPort.sendTimingReq(pkt);
+    };
+
+    respChannel.deliver = [this](PacketPtr pkt, bool snoop) {
+        if (!snoop)
+            return slavePort.sendTimingResp(pkt);
+
+        slavePort.sendTimingSnoopReq(pkt);
+        delete pkt->req;
+        delete pkt;
+        return true;
+    };
+}
+
+BaseMasterPort&
+CrossQueueBridge::getMasterPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "master")
+        return masterPort;
+    else
+        return MemObject::getMasterPort(if_name, idx);
+}
+
+BaseSlavePort&
+CrossQueueBridge::getSlavePort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "slave")
+        return slavePort;
+    else
+        return MemObject::getSlavePort(if_name, idx);
+}
+
+void
+CrossQueueBridge::init()
+{
+    if (!slavePort.isConnected() || !masterPort.isConnected())
+        fatal("Both ports of %s must be connected.\n", name());
+
+    fatal_if(delay <= simQuantum,
+             "%s: delay (%d) must exceed the simulation quantum (%d) to "
+             "keep the simulation deterministic.\n",
+             name(), delay, simQuantum);
+}
+
+void
+CrossQueueBridge::startup()
+{
+    reqChannel.start(eventQueue());
+    respChannel.start(cpuSideEventQueue);
+}
+
+void
+CrossQueueBridge::regStats()
+{
+    MemObject::regStats();
+
+    reqChannel.packets
+        .name(name() + ".reqPackets")
+        .desc("Number of requests delivered to the memory side")
+        ;
+
+    respChannel.packets
+        .name(name() + ".respPackets")
+        .desc("Number of responses and snoops delivered to the CPU side")
+        ;
+}
+
+DrainState
+CrossQueueBridge::drain()
+{
+    return inFlight == 0 ? DrainState::Drained : DrainState::Draining;
+}
+
+uint64_t
+CrossQueueBridge::digest() const
+{
+    return reqChannel.digest * 0x100000001b3ULL ^ respChannel.digest;
+}
+
+CrossQueueBridge *
+CrossQueueBridgeParams::create()
+{
+    return new CrossQueueBridge(this);
+}
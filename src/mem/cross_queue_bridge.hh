@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a bridge between ports simulated on different event
+ * queues.
+ */
+
+#ifndef __MEM_CROSS_QUEUE_BRIDGE_HH__
+#define __MEM_CROSS_QUEUE_BRIDGE_HH__
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/mem_object.hh"
+#include "params/CrossQueueBridge.hh"
+
+/**
+ * A bridge between a master, e.g., a CPU, simulated on one event
+ * queue and a slave, e.g., its L1 cache, simulated on another event
+ * queue. The bridge makes it possible to simulate groups of CPUs on
+ * their own host threads while sharing the memory system.
+ *
+ * Timing requests cross the bridge from the slave port to the master
+ * port, responses and snoops in the opposite direction. Every packet
+ * is delivered a fixed delay after it was sent. The receiving side
+ * only picks up packets once the sending event queue is guaranteed to
+ * have passed their send time, so the delivery order does not depend
+ * on how far the host threads are apart within a simulation quantum
+ * and parallel simulations are deterministic. This requires the delay
+ * to exceed the simulation quantum.
+ *
+ * The bridge accepts all timing packets and buffers them until the
+ * receiver accepts them; flow control is left to the CPU and cache.
+ * Functional and atomic accesses are forwarded right away after
+ * migrating to the event queue of the memory side.
+ */
+class CrossQueueBridge : public MemObject
+{
+  protected:
+
+    /** A packet crossing the bridge along with its delivery time. */
+    struct InFlight
+    {
+        Tick when;
+        PacketPtr pkt;
+        bool snoop;
+    };
+
+    /**
+     * One direction of the bridge. Packets are pushed by the host
+     * thread simulating the sending event queue and delivered by
+     * events on the receiving event queue.
+     */
+    class Channel
+    {
+      public:
+
+        /**
+         * @param _bridge the bridge owning this channel
+         * @param _name the name used for the channel events
+         */
+        Channel(CrossQueueBridge &_bridge, const std::string &_name);
+
+        /**
+         * Queue a packet for delivery. Called on the sending side.
+         *
+         * @param pkt the packet to deliver
+         * @param snoop true if the packet is a snoop request
+         */
+        void push(PacketPtr pkt, bool snoop);
+
+        /**
+         * Start picking up packets on the receiving side.
+         *
+         * @param eq the event queue of the receiving side
+         */
+        void start(EventQueue *eq);
+
+        /** Resume delivery once the receiver sent a retry. */
+        void retry();
+
+        /**
+         * Check the packets in flight for a functional access.
+         *
+         * @return true if the access was satisfied
+         */
+        bool checkFunctional(PacketPtr pkt);
+
+        /**
+         * Deliver a packet to the receiver.
+         *
+         * @return false if the receiver is busy and will send a retry
+         */
+        std::function<bool(PacketPtr, bool)> deliver;
+
+        /** Number of packets delivered. */
+        Stats::Scalar packets;
+
+        /** FNV-1a digest of the delivered packets and their timing. */
+        uint64_t digest;
+
+      private:
+
+        /** Move packets that can no longer be overtaken to ready. */
+        void poll();
+
+        /** Deliver the packet at the head of ready. */
+        void trySend();
+
+        CrossQueueBridge &bridge;
+
+        const std::string _name;
+
+        /** Event queue of the receiving side. */
+        EventQueue *eventq;
+
+        /** Protects inbox, shared with the sending side. */
+        std::mutex inboxMutex;
+
+        /** Packets pushed but not yet picked up by the receiver. */
+        std::deque<InFlight> inbox;
+
+        /** Delivery time of the last packet pushed. */
+        Tick lastWhen;
+
+        /** Packets picked up and waiting for their delivery time. */
+        std::deque<InFlight> ready;
+
+        /** If the receiver refused a packet and owes us a retry. */
+        bool waitingRetry;
+
+        EventFunctionWrapper pollEvent;
+
+        EventFunctionWrapper sendEvent;
+    };
+
+    /** The port on the CPU side, receiving requests. */
+    class BridgeSlavePort : public SlavePort
+    {
+      public:
+
+        BridgeSlavePort(const std::string &_name, CrossQueueBridge &_bridge);
+
+      protected:
+
+        bool recvTimingReq(PacketPtr pkt) override;
+
+        void recvRespRetry() override;
+
+        Tick recvAtomic(PacketPtr pkt) override;
+
+        void recvFunctional(PacketPtr pkt) override;
+
+        AddrRangeList getAddrRanges() const override;
+
+      private:
+
+        CrossQueueBridge &bridge;
+    };
+
+    /** The port on the memory side, receiving responses and snoops. */
+    class BridgeMasterPort : public MasterPort
+    {
+      public:
+
+        BridgeMasterPort(const std::string &_name, CrossQueueBridge &_bridge);
+
+      protected:
+
+        bool recvTimingResp(PacketPtr pkt) override;
+
+        void recvReqRetry() override;
+
+        void recvTimingSnoopReq(PacketPtr pkt) override;
+
+        Tick recvAtomicSnoop(PacketPtr pkt) override;
+
+        void recvFunctionalSnoop(PacketPtr pkt) override;
+
+        bool isSnooping() const override;
+
+        void recvRangeChange() override;
+
+      private:
+
+        CrossQueueBridge &bridge;
+    };
+
+    BridgeSlavePort slavePort;
+
+    BridgeMasterPort masterPort;
+
+    /** Delay from sending to delivering a packet. */
+    const Tick delay;
+
+    /** Event queue of the objects connected to the slave port. */
+    EventQueue *const cpuSideEventQueue;
+
+    /** Requests travelling to the memory side. */
+    Channel reqChannel;
+
+    /** Responses and snoops travelling to the CPU side. */
+    Channel respChannel;
+
+    /** Packets pushed to either channel and not yet delivered. */
+    std::atomic<unsigned> inFlight;
+
+  public:
+
+    BaseMasterPort& getMasterPort(const std::string& if_name,
+                                  PortID idx = InvalidPortID) override;
+    BaseSlavePort& getSlavePort(const std::string& if_name,
+                                PortID idx = InvalidPortID) override;
+
+    void init() override;
+
+    void startup() override;
+
+    void regStats() override;
+
+    DrainState drain() override;
+
+    /**
+     * Digest of the packets delivered in both directions and of their
+     * delivery times. Two simulations of the same configuration are
+     * deterministic if all bridges report the same digest.
+     */
+    uint64_t digest() const;
+
+    typedef CrossQueueBridgeParams Params;
+
+    CrossQueueBridge(Params *p);
+};
+
+#endif //__MEM_CROSS_QUEUE_BRIDGE_HH__
@@ -66,6 +66,8 @@ DRAMCtrl::DRAMCtrl(const DRAMCtrlParams* p) :
     busStateNext(READ),
     nextReqEvent([this]{ processNextReqEvent(); }, name()),
     respondEvent([this]{ processRespondEvent(); }, name()),
+    readQueue(p->ranks_per_channel * p->banks_per_rank),
+    writeQueue(p->ranks_per_channel * p->banks_per_rank),
     deviceSize(p->device_size),
     deviceBusWidth(p->device_bus_width), burstLength(p->burst_length),
     deviceRowBufferSize(p->device_rowbuffer_size),
@@ -429,18 +431,17 @@ DRAMCtrl::addToReadQueue(PacketPtr pkt, unsigned int pktCount)
         // if the burst address is not present then there is no need
         // looking any further
         if (isInWriteQueue.find(burst_addr) != isInWriteQueue.end()) {
-            for (const auto& p : writeQueue) {
-                // check if the read is subsumed in the write queue
-                // packet we are looking at
-                if (p->addr <= addr && (addr + size) <= (p->addr + p->size)) {
-                    foundInWrQ = true;
-                    servicedByWrQ++;
-                    pktsServicedByWrQ++;
-                    DPRINTF(DRAM, "Read to addr %lld with size %d serviced by "
-                            "write queue\n", addr, size);
-                    bytesReadWrQ += burstSize;
-                    break;
-                }
+            // check if the read is subsumed in a write queue packet
+            auto subsumes = [addr, size](const DRAMPacket* p) {
+                return p->addr <= addr && (addr + size) <= (p->addr + p->size);
+            };
+            if (writeQueue.find(subsumes)) {
+                foundInWrQ = true;
+                servicedByWrQ++;
+                pktsServicedByWrQ++;
+                DPRINTF(DRAM, "Read to addr %lld with size %d serviced by "
+                        "write queue\n", addr, size);
+                bytesReadWrQ += burstSize;
             }
         }
 
@@ -564,17 +565,17 @@ DRAMCtrl::addToWriteQueue(PacketPtr pkt, unsigned int pktCount)
 void
 DRAMCtrl::printQs() const {
     DPRINTF(DRAM, "===READ QUEUE===\n\n");
-    for (auto i = readQueue.begin() ;  i != readQueue.end() ; ++i) {
-        DPRINTF(DRAM, "Read %lu\n", (*i)->addr);
-    }
+    readQueue.forEach([this](const DRAMPacket* p) {
+            DPRINTF(DRAM, "Read %lu\n", p->addr);
+        });
     DPRINTF(DRAM, "\n===RESP QUEUE===\n\n");
     for (auto i = respQueue.begin() ;  i != respQueue.end() ; ++i) {
         DPRINTF(DRAM, "Response %lu\n", (*i)->addr);
     }
     DPRINTF(DRAM, "\n===WRITE QUEUE===\n\n");
-    for (auto i = writeQueue.begin() ;  i != writeQueue.end() ; ++i) {
-        DPRINTF(DRAM, "Write %lu\n", (*i)->addr);
-    }
+    writeQueue.forEach([this](const DRAMPacket* p) {
+            DPRINTF(DRAM, "Write %lu\n", p->addr);
+        });
 }
 
 bool
@@ -732,142 +733,34 @@ DRAMCtrl::processRespondEvent()
     }
 }
 
-bool
-DRAMCtrl::chooseNext(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
+DRAMCtrl::DRAMPacket*
+DRAMCtrl::chooseNext(const DRAMPacketQueue& queue, Tick extra_col_delay) const
 {
-    // This method does the arbitration between requests. The chosen
-    // packet is simply moved to the head of the queue. The other
-    // methods know that this is the place to look. For example, with
-    // FCFS, this method does nothing
+    // This method does the arbitration between requests. The queue is
+    // split per bank, so the policies only look at the oldest packets
+    // of each bank instead of walking the whole queue
     assert(!queue.empty());
 
-    // bool to indicate if a packet to an available rank is found
-    bool found_packet = false;
-    if (queue.size() == 1) {
-        DRAMPacket* dram_pkt = queue.front();
-        // available rank corresponds to state refresh idle
-        if (ranks[dram_pkt->rank]->inRefIdleState()) {
-            found_packet = true;
-            DPRINTF(DRAM, "Single request, going to a free rank\n");
-        } else {
-            DPRINTF(DRAM, "Single request, going to a busy rank\n");
-        }
-        return found_packet;
-    }
-
+    DRAMPacket* dram_pkt = nullptr;
     if (memSchedPolicy == Enums::fcfs) {
-        // check if there is a packet going to a free rank
-        for (auto i = queue.begin(); i != queue.end() ; ++i) {
-            DRAMPacket* dram_pkt = *i;
-            if (ranks[dram_pkt->rank]->inRefIdleState()) {
-                queue.erase(i);
-                queue.push_front(dram_pkt);
-                found_packet = true;
-                break;
-            }
-        }
+        // the oldest packet going to a free rank
+        dram_pkt = queue.chooseFCFS();
     } else if (memSchedPolicy == Enums::frfcfs) {
-        found_packet = reorderQueue(queue, extra_col_delay);
+        // time we need to issue a column command to be seamless
+        const Tick min_col_at = std::max(busBusyUntil - tCL + extra_col_delay,
+                                         curTick());
+        dram_pkt = queue.chooseFRFCFS(min_col_at, curTick(), tRCD, tRP);
     } else
         panic("No scheduling policy chosen\n");
-    return found_packet;
-}
-
-bool
-DRAMCtrl::reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay)
-{
-    // Only determine this if needed
-    uint64_t earliest_banks = 0;
-    bool hidden_bank_prep = false;
-
-    // search for seamless row hits first, if no seamless row hit is
-    // found then determine if there are other packets that can be issued
-    // without incurring additional bus delay due to bank timing
-    // Will select closed rows first to enable more open row possibilies
-    // in future selections
-    bool found_hidden_bank = false;
-
-    // remember if we found a row hit, not seamless, but bank prepped
-    // and ready
-    bool found_prepped_pkt = false;
-
-    // if we have no row hit, prepped or not, and no seamless packet,
-    // just go for the earliest possible
-    bool found_earliest_pkt = false;
-
-    auto selected_pkt_it = queue.end();
-
-    // time we need to issue a column command to be seamless
-    const Tick min_col_at = std::max(busBusyUntil - tCL + extra_col_delay,
-                                     curTick());
-
-    for (auto i = queue.begin(); i != queue.end() ; ++i) {
-        DRAMPacket* dram_pkt = *i;
-        const Bank& bank = dram_pkt->bankRef;
-
-        // check if rank is not doing a refresh and thus is available, if not,
-        // jump to the next packet
-        if (dram_pkt->rankRef.inRefIdleState()) {
-            // check if it is a row hit
-            if (bank.openRow == dram_pkt->row) {
-                // no additional rank-to-rank or same bank-group
-                // delays, or we switched read/write and might as well
-                // go for the row hit
-                if (bank.colAllowedAt <= min_col_at) {
-                    // FCFS within the hits, giving priority to
-                    // commands that can issue seamlessly, without
-                    // additional delay, such as same rank accesses
-                    // and/or different bank-group accesses
-                    DPRINTF(DRAM, "Seamless row buffer hit\n");
-                    selected_pkt_it = i;
-                    // no need to look through the remaining queue entries
-                    break;
-                } else if (!found_hidden_bank && !found_prepped_pkt) {
-                    // if we did not find a packet to a closed row that can
-                    // issue the bank commands without incurring delay, and
-                    // did not yet find a packet to a prepped row, remember
-                    // the current one
-                    selected_pkt_it = i;
-                    found_prepped_pkt = true;
-                    DPRINTF(DRAM, "Prepped row buffer hit\n");
-                }
-            } else if (!found_earliest_pkt) {
-                // if we have not initialised the bank status, do it
-                // now, and only once per scheduling decisions
-                if (earliest_banks == 0) {
-                    // determine entries with earliest bank delay
-                    pair<uint64_t, bool> bankStatus =
-                        minBankPrep(queue, min_col_at);
-                    earliest_banks = bankStatus.first;
-                    hidden_bank_prep = bankStatus.second;
-                }
 
-                // bank is amongst first available banks
-                // minBankPrep will give priority to packets that can
-                // issue seamlessly
-                if (bits(earliest_banks, dram_pkt->bankId, dram_pkt->bankId)) {
-                    found_earliest_pkt = true;
-                    found_hidden_bank = hidden_bank_prep;
-
-                    // give priority to packets that can issue
-                    // bank commands 'behind the scenes'
-                    // any additional delay if any will be due to
-                    // col-to-col command requirements
-                    if (hidden_bank_prep || !found_prepped_pkt)
-                        selected_pkt_it = i;
-                }
-            }
+    if (queue.size() == 1) {
+        if (dram_pkt) {
+            DPRINTF(DRAM, "Single request, going to a free rank\n");
+        } else {
+            DPRINTF(DRAM, "Single request, going to a busy rank\n");
         }
     }
-
-    if (selected_pkt_it != queue.end()) {
-        DRAMPacket* selected_pkt = *selected_pkt_it;
-        queue.erase(selected_pkt_it);
-        queue.push_front(selected_pkt);
-        return true;
-    }
-
-    return false;
+    return dram_pkt;
 }
 
 void
@@ -1180,30 +1073,17 @@ DRAMCtrl::doDRAMAccess(DRAMPacket* dram_pkt)
         // page, but closes it only if there are no row hits in the queue.
         // In this case, only force an auto precharge when there
         // are no same page hits in the queue
-        bool got_more_hits = false;
-        bool got_bank_conflict = false;
-
-        // either look at the read queue or write queue
-        const deque<DRAMPacket*>& queue = dram_pkt->isRead ? readQueue :
-            writeQueue;
-        auto p = queue.begin();
-        // make sure we are not considering the packet that we are
-        // currently dealing with (which is the head of the queue)
-        ++p;
-
-        // keep on looking until we find a hit or reach the end of the queue
+        // either look at the read queue or write queue, at the other
+        // packets to the same bank as the one we are dealing with
         // 1) if a hit is found, then both open and close adaptive policies keep
         // the page open
         // 2) if no hit is found, got_bank_conflict is set to true if a bank
         // conflict request is waiting in the queue
-        while (!got_more_hits && p != queue.end()) {
-            bool same_rank_bank = (dram_pkt->rank == (*p)->rank) &&
-                (dram_pkt->bank == (*p)->bank);
-            bool same_row = dram_pkt->row == (*p)->row;
-            got_more_hits |= same_rank_bank && same_row;
-            got_bank_conflict |= same_rank_bank && !same_row;
-            ++p;
-        }
+        const DRAMPacketQueue& queue = dram_pkt->isRead ? readQueue :
+            writeQueue;
+        pair<unsigned, unsigned> same_bank = queue.sameBank(dram_pkt);
+        bool got_more_hits = same_bank.first > 0;
+        bool got_bank_conflict = same_bank.second > 0;
 
         // auto pre-charge when either
         // 1) open_adaptive policy, we have not got any more hits, and
@@ -1377,25 +1257,20 @@ DRAMCtrl::processNextReqEvent()
                 return;
             }
         } else {
-            // bool to check if there is a read to a free rank
-            bool found_read = false;
-
-            // Figure out which read request goes next, and move it to the
-            // front of the read queue
+            // Figure out which read request to a free rank goes next
             // If we are changing command type, incorporate the minimum
             // bus turnaround delay which will be tCS (different rank) case
-            found_read = chooseNext(readQueue,
-                             switched_cmd_type ? tCS : 0);
+            DRAMPacket* dram_pkt = chooseNext(readQueue,
+                                              switched_cmd_type ? tCS : 0);
 
             // if no read to an available rank is found then return
             // at this point. There could be writes to the available ranks
             // which are above the required threshold. However, to
             // avoid adding more complexity to the code, return and wait
             // for a refresh event to kick things into action again.
-            if (!found_read)
+            if (!dram_pkt)
                 return;
 
-            DRAMPacket* dram_pkt = readQueue.front();
             assert(dram_pkt->rankRef.inRefIdleState());
 
             // here we get a bit creative and shift the bus busy time not
@@ -1410,7 +1285,7 @@ DRAMCtrl::processNextReqEvent()
             doDRAMAccess(dram_pkt);
 
             // At this point we're done dealing with the request
-            readQueue.pop_front();
+            readQueue.erase(dram_pkt);
 
             // Every respQueue which will generate an event, increment count
             ++dram_pkt->rankRef.outstandingEvents;
@@ -1445,12 +1320,10 @@ DRAMCtrl::processNextReqEvent()
             busStateNext = WRITE;
         }
     } else {
-        // bool to check if write to free rank is found
-        bool found_write = false;
-
+        // Figure out which write request to a free rank goes next
         // If we are changing command type, incorporate the minimum
         // bus turnaround delay
-        found_write = chooseNext(writeQueue,
+        DRAMPacket* dram_pkt = chooseNext(writeQueue,
                                  switched_cmd_type ? std::min(tRTW, tCS) : 0);
 
         // if there are no writes to a rank that is available to service
@@ -1458,10 +1331,9 @@ DRAMCtrl::processNextReqEvent()
         // return. There could be reads to the available ranks. However, to
         // avoid adding more complexity to the code, return at this point and
         // wait for a refresh event to kick things into action again.
-        if (!found_write)
+        if (!dram_pkt)
             return;
 
-        DRAMPacket* dram_pkt = writeQueue.front();
         assert(dram_pkt->rankRef.inRefIdleState());
         // sanity check
         assert(dram_pkt->size <= burstSize);
@@ -1476,7 +1348,7 @@ DRAMCtrl::processNextReqEvent()
 
         doDRAMAccess(dram_pkt);
 
-        writeQueue.pop_front();
+        writeQueue.erase(dram_pkt);
 
         // removed write from queue, decrement count
         --dram_pkt->rankRef.writeEntries;
@@ -1532,89 +1404,6 @@ DRAMCtrl::processNextReqEvent()
     }
 }
 
-pair<uint64_t, bool>
-DRAMCtrl::minBankPrep(const deque<DRAMPacket*>& queue,
-                      Tick min_col_at) const
-{
-    uint64_t bank_mask = 0;
-    Tick min_act_at = MaxTick;
-
-    // latest Tick for which ACT can occur without incurring additoinal
-    // delay on the data bus
-    const Tick hidden_act_max = std::max(min_col_at - tRCD, curTick());
-
-    // Flag condition when burst can issue back-to-back with previous burst
-    bool found_seamless_bank = false;
-
-    // Flag condition when bank can be opened without incurring additional
-    // delay on the data bus
-    bool hidden_bank_prep = false;
-
-    // determine if we have queued transactions targetting the
-    // bank in question
-    vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->rankRef.inRefIdleState())
-            got_waiting[p->bankId] = true;
-    }
-
-    // Find command with optimal bank timing
-    // Will prioritize commands that can issue seamlessly.
-    for (int i = 0; i < ranksPerChannel; i++) {
-        for (int j = 0; j < banksPerRank; j++) {
-            uint16_t bank_id = i * banksPerRank + j;
-
-            // if we have waiting requests for the bank, and it is
-            // amongst the first available, update the mask
-            if (got_waiting[bank_id]) {
-                // make sure this rank is not currently refreshing.
-                assert(ranks[i]->inRefIdleState());
-                // simplistic approximation of when the bank can issue
-                // an activate, ignoring any rank-to-rank switching
-                // cost in this calculation
-                Tick act_at = ranks[i]->banks[j].openRow == Bank::NO_ROW ?
-                    std::max(ranks[i]->banks[j].actAllowedAt, curTick()) :
-                    std::max(ranks[i]->banks[j].preAllowedAt, curTick()) + tRP;
-
-                // When is the earliest the R/W burst can issue?
-                Tick col_at = std::max(ranks[i]->banks[j].colAllowedAt,
-                                       act_at + tRCD);
-
-                // bank can issue burst back-to-back (seamlessly) with
-                // previous burst
-                bool new_seamless_bank = col_at <= min_col_at;
-
-                // if we found a new seamless bank or we have no
-                // seamless banks, and got a bank with an earlier
-                // activate time, it should be added to the bit mask
-                if (new_seamless_bank ||
-                    (!found_seamless_bank && act_at <= min_act_at)) {
-                    // if we did not have a seamless bank before, and
-                    // we do now, reset the bank mask, also reset it
-                    // if we have not yet found a seamless bank and
-                    // the activate time is smaller than what we have
-                    // seen so far
-                    if (!found_seamless_bank &&
-                        (new_seamless_bank || act_at < min_act_at)) {
-                        bank_mask = 0;
-                    }
-
-                    found_seamless_bank |= new_seamless_bank;
-
-                    // ACT can occur 'behind the scenes'
-                    hidden_bank_prep = act_at <= hidden_act_max;
-
-                    // set the bit corresponding to the available bank
-                    replaceBits(bank_mask, bank_id, bank_id, 1);
-                    min_act_at = act_at;
-                }
-            }
-        }
-    }
-
-    return make_pair(bank_mask, hidden_bank_prep);
-}
-
 DRAMCtrl::Rank::Rank(DRAMCtrl& _memory, const DRAMCtrlParams* _p, int rank)
     : EventManager(&_memory), memory(_memory),
       pwrStateTrans(PWR_IDLE), pwrStatePostRefresh(PWR_IDLE),
@@ -64,6 +64,7 @@
 #include "enums/MemSched.hh"
 #include "enums/PageManage.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/dram_queue.hh"
 #include "mem/qport.hh"
 #include "params/DRAMCtrl.hh"
 #include "sim/eventq.hh"
@@ -701,6 +702,9 @@ class DRAMCtrl : public AbstractMemory
 
     };
 
+    /** Read or write queue, indexed by bank. */
+    typedef DRAMQueue<DRAMPacket, Bank> DRAMPacketQueue;
+
     /**
      * Bunch of things requires to setup "events" in gem5
      * When event "respondEvent" occurs for example, the method
@@ -798,41 +802,17 @@ class DRAMCtrl : public AbstractMemory
 
     /**
      * The memory schduler/arbiter - picks which request needs to
-     * go next, based on the specified policy such as FCFS or FR-FCFS
-     * and moves it to the head of the queue.
-     * Prioritizes accesses to the same rank as previous burst unless
-     * controller is switching command type.
-     *
-     * @param queue Queued requests to consider
-     * @param extra_col_delay Any extra delay due to a read/write switch
-     * @return true if a packet is scheduled to a rank which is available else
-     * false
-     */
-    bool chooseNext(std::deque<DRAMPacket*>& queue, Tick extra_col_delay);
-
-    /**
-     * For FR-FCFS policy reorder the read/write queue depending on row buffer
-     * hits and earliest bursts available in DRAM
+     * go next, based on the specified policy such as FCFS or FR-FCFS.
+     * FR-FCFS prioritizes row hits and the earliest bursts available
+     * in DRAM, see DRAMQueue::chooseFRFCFS.
      *
      * @param queue Queued requests to consider
      * @param extra_col_delay Any extra delay due to a read/write switch
-     * @return true if a packet is scheduled to a rank which is available else
-     * false
-     */
-    bool reorderQueue(std::deque<DRAMPacket*>& queue, Tick extra_col_delay);
-
-    /**
-     * Find which are the earliest banks ready to issue an activate
-     * for the enqueued requests. Assumes maximum of 64 banks per DIMM
-     * Also checks if the bank is already prepped.
-     *
-     * @param queue Queued requests to consider
-     * @param time of seamless burst command
-     * @return One-hot encoded mask of bank indices
-     * @return boolean indicating burst can issue seamlessly, with no gaps
+     * @return The packet to a rank which is available, or nullptr if
+     * there is none
      */
-    std::pair<uint64_t, bool> minBankPrep(const std::deque<DRAMPacket*>& queue,
-                                          Tick min_col_at) const;
+    DRAMPacket* chooseNext(const DRAMPacketQueue& queue,
+                           Tick extra_col_delay) const;
 
     /**
      * Keep track of when row activations happen, in order to enforce
@@ -878,8 +858,8 @@ class DRAMCtrl : public AbstractMemory
     /**
      * The controller's main read and write queues
      */
-    std::deque<DRAMPacket*> readQueue;
-    std::deque<DRAMPacket*> writeQueue;
+    DRAMPacketQueue readQueue;
+    DRAMPacketQueue writeQueue;
 
     /**
      * To avoid iterating over the write queue to check for
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Read and write queues of the DRAM controller, split per bank.
+ *
+ * Packets are kept in arrival order within the list of their bank, and
+ * carry a sequence number that orders them across banks. The scheduling
+ * policies then look at the head of each bank list instead of walking
+ * the whole queue, and pick the same packet as a walk of the queue in
+ * arrival order would.
+ */
+
+#ifndef __MEM_DRAM_QUEUE_HH__
+#define __MEM_DRAM_QUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+/**
+ * A queue of DRAM packets indexed by bank. Pkt must provide the bankId,
+ * row, bankRef and rankRef members of DRAMCtrl::DRAMPacket, and Bank
+ * the row and timing members of DRAMCtrl::Bank.
+ */
+template <class Pkt, class Bank>
+class DRAMQueue
+{
+  private:
+    struct Entry
+    {
+        uint64_t seq;
+        Pkt *pkt;
+    };
+
+    typedef std::vector<Entry> BankList;
+
+    /** Packets of each bank, in arrival order. */
+    std::vector<BankList> banks;
+    size_t count;
+    uint64_t nextSeq;
+
+    /** Keep the earliest of the candidate packets found so far. */
+    static void
+    earliest(const Entry &e, const Entry *&best)
+    {
+        if (!best || e.seq < best->seq)
+            best = &e;
+    }
+
+  public:
+    /** @param num_banks Number of banks of all ranks of the channel. */
+    explicit DRAMQueue(unsigned num_banks)
+        : banks(num_banks), count(0), nextSeq(0)
+    { }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /** Add a packet behind all packets queued so far. */
+    void
+    push_back(Pkt *pkt)
+    {
+        assert(pkt->bankId < banks.size());
+        banks[pkt->bankId].push_back(Entry{nextSeq++, pkt});
+        ++count;
+    }
+
+    /** Remove a queued packet. */
+    void
+    erase(const Pkt *pkt)
+    {
+        BankList &list = banks[pkt->bankId];
+        auto it = std::find_if(list.begin(), list.end(),
+                               [pkt](const Entry &e) { return e.pkt == pkt; });
+        assert(it != list.end());
+        list.erase(it);
+        --count;
+    }
+
+    /**
+     * Find a packet, looking bank by bank and in arrival order within
+     * each bank.
+     * @return The first packet pred returns true for, or nullptr.
+     */
+    template <class Pred>
+    Pkt *
+    find(Pred pred) const
+    {
+        for (const BankList &list : banks) {
+            for (const Entry &e : list) {
+                if (pred(e.pkt))
+                    return e.pkt;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Call func on every packet, bank by bank and in arrival order
+     * within each bank.
+     */
+    template <class Func>
+    void
+    forEach(Func func) const
+    {
+        for (const BankList &list : banks) {
+            for (const Entry &e : list)
+                func(e.pkt);
+        }
+    }
+
+    /**
+     * Count the other packets to the bank of pkt.
+     * @return The number of them to the row of pkt and to other rows.
+     */
+    std::pair<unsigned, unsigned>
+    sameBank(const Pkt *pkt) const
+    {
+        unsigned hits = 0;
+        unsigned conflicts = 0;
+        for (const Entry &e : banks[pkt->bankId]) {
+            if (e.pkt != pkt) {
+                if (e.pkt->row == pkt->row)
+                    ++hits;
+                else
+                    ++conflicts;
+            }
+        }
+        return std::make_pair(hits, conflicts);
+    }
+
+    /**
+     * First come, first served: the oldest packet to a rank that is
+     * not refreshing.
+     * @return The packet, or nullptr if all are to refreshing ranks.
+     */
+    Pkt *
+    chooseFCFS() const
+    {
+        const Entry *best = nullptr;
+        for (const BankList &list : banks) {
+            if (!list.empty() && list.front().pkt->rankRef.inRefIdleState())
+                earliest(list.front(), best);
+        }
+        return best ? best->pkt : nullptr;
+    }
+
+    /**
+     * First ready, first come, first served. Picks, in this order of
+     * preference, the oldest row hit that can issue seamlessly, then
+     * either the oldest other row hit or the oldest row miss to one of
+     * the banks that can be prepared the earliest (see minBankPrep),
+     * the latter first if its bank can be prepared without delaying
+     * the data bus.
+     *
+     * @param min_col_at Time a column command must issue at to be
+     *                   seamless.
+     * @param now The current tick.
+     * @param tRCD Activate to column command delay.
+     * @param tRP Precharge to activate delay.
+     * @return The packet, or nullptr if all are to refreshing ranks.
+     */
+    Pkt *
+    chooseFRFCFS(Tick min_col_at, Tick now, Tick tRCD, Tick tRP) const
+    {
+        const Entry *seamless = nullptr;
+        const Entry *prepped = nullptr;
+
+        for (const BankList &list : banks) {
+            if (list.empty() || !list.front().pkt->rankRef.inRefIdleState())
+                continue;
+
+            const Bank &bank = list.front().pkt->bankRef;
+            for (const Entry &e : list) {
+                if (e.pkt->row == bank.openRow) {
+                    earliest(e, bank.colAllowedAt <= min_col_at ?
+                             seamless : prepped);
+                    break;
+                }
+            }
+        }
+
+        if (seamless)
+            return seamless->pkt;
+
+        std::pair<uint64_t, bool> prep = minBankPrep(min_col_at, now,
+                                                     tRCD, tRP);
+        const Entry *miss = nullptr;
+        for (unsigned bank_id = 0; bank_id < banks.size(); ++bank_id) {
+            if (!bits(prep.first, bank_id, bank_id))
+                continue;
+            const BankList &list = banks[bank_id];
+            const Bank &bank = list.front().pkt->bankRef;
+            for (const Entry &e : list) {
+                if (e.pkt->row != bank.openRow) {
+                    earliest(e, miss);
+                    break;
+                }
+            }
+        }
+
+        // give priority to packets that can issue bank commands
+        // 'behind the scenes'
+        const Entry *first = prep.second ? miss : prepped;
+        const Entry *second = prep.second ? prepped : miss;
+        if (first)
+            return first->pkt;
+        return second ? second->pkt : nullptr;
+    }
+
+    /**
+     * Find which banks with packets to ranks that are not refreshing
+     * can issue their next column command the earliest. Assumes at
+     * most 64 banks per channel.
+     *
+     * @param min_col_at Time a column command must issue at to be
+     *                   seamless.
+     * @param now The current tick.
+     * @param tRCD Activate to column command delay.
+     * @param tRP Precharge to activate delay.
+     * @return A mask of the banks, and whether the activate of the
+     *         last one found can be hidden behind the data bus.
+     */
+    std::pair<uint64_t, bool>
+    minBankPrep(Tick min_col_at, Tick now, Tick tRCD, Tick tRP) const
+    {
+        uint64_t bank_mask = 0;
+        Tick min_act_at = MaxTick;
+
+        // latest Tick for which ACT can occur without incurring
+        // additional delay on the data bus
+        const Tick hidden_act_max = std::max(min_col_at - tRCD, now);
+
+        // Flag condition when burst can issue back-to-back with
+        // previous burst
+        bool found_seamless_bank = false;
+
+        // Flag condition when bank can be opened without incurring
+        // additional delay on the data bus
+        bool hidden_bank_prep = false;
+
+        // Find command with optimal bank timing
+        // Will prioritize commands that can issue seamlessly.
+        for (unsigned bank_id = 0; bank_id < banks.size(); ++bank_id) {
+            const BankList &list = banks[bank_id];
+            if (list.empty() || !list.front().pkt->rankRef.inRefIdleState())
+                continue;
+
+            const Bank &bank = list.front().pkt->bankRef;
+            // simplistic approximation of when the bank can issue an
+            // activate, ignoring any rank-to-rank switching cost
+            Tick act_at = bank.openRow == Bank::NO_ROW ?
+                std::max(bank.actAllowedAt, now) :
+                std::max(bank.preAllowedAt, now) + tRP;
+
+            // When is the earliest the R/W burst can issue?
+            Tick col_at = std::max(bank.colAllowedAt, act_at + tRCD);
+
+            // bank can issue burst back-to-back (seamlessly) with
+            // previous burst
+            bool new_seamless_bank = col_at <= min_col_at;
+
+            // if we found a new seamless bank or we have no seamless
+            // banks, and got a bank with an earlier activate time, it
+            // should be added to the bit mask
+            if (new_seamless_bank ||
+                (!found_seamless_bank && act_at <= min_act_at)) {
+                // if we did not have a seamless bank before, and we do
+                // now, reset the bank mask, also reset it if we have
+                // not yet found a seamless bank and the activate time
+                // is smaller than what we have seen so far
+                if (!found_seamless_bank &&
+                    (new_seamless_bank || act_at < min_act_at)) {
+                    bank_mask = 0;
+                }
+
+                found_seamless_bank |= new_seamless_bank;
+
+                // ACT can occur 'behind the scenes'
+                hidden_bank_prep = act_at <= hidden_act_max;
+
+                // set the bit corresponding to the available bank
+                replaceBits(bank_mask, bank_id, bank_id, 1);
+                min_act_at = act_at;
+            }
+        }
+
+        return std::make_pair(bank_mask, hidden_bank_prep);
+    }
+};
+
+#endif // __MEM_DRAM_QUEUE_HH__
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/dram_queue.hh"
+
+namespace {
+
+struct TestBank
+{
+    static const uint32_t NO_ROW = -1;
+
+    uint32_t openRow = NO_ROW;
+    Tick colAllowedAt = 0;
+    Tick preAllowedAt = 0;
+    Tick actAllowedAt = 0;
+};
+
+struct TestRank
+{
+    bool refreshing = false;
+
+    bool inRefIdleState() const { return !refreshing; }
+};
+
+struct TestPacket
+{
+    uint8_t rank;
+    uint8_t bank;
+    uint32_t row;
+    uint16_t bankId;
+    TestBank &bankRef;
+    TestRank &rankRef;
+};
+
+typedef DRAMQueue<TestPacket, TestBank> Queue;
+
+const Tick tRCD = 14;
+const Tick tRP = 14;
+
+/**
+ * Reference model: the arrival-ordered deque and the scheduling code
+ * DRAMCtrl used before its queues were split per bank.
+ */
+struct DequeQueue
+{
+    std::deque<TestPacket *> queue;
+    const int ranksPerChannel;
+    const int banksPerRank;
+    std::vector<TestRank> &ranks;
+    std::vector<TestBank> &banks;
+
+    DequeQueue(int ranks_per_channel, int banks_per_rank,
+               std::vector<TestRank> &_ranks, std::vector<TestBank> &_banks)
+        : ranksPerChannel(ranks_per_channel), banksPerRank(banks_per_rank),
+          ranks(_ranks), banks(_banks)
+    {}
+
+    TestPacket *
+    chooseFCFS()
+    {
+        for (auto p : queue) {
+            if (p->rankRef.inRefIdleState())
+                return p;
+        }
+        return nullptr;
+    }
+
+    std::pair<uint64_t, bool>
+    minBankPrep(Tick min_col_at, Tick now) const
+    {
+        uint64_t bank_mask = 0;
+        Tick min_act_at = MaxTick;
+        const Tick hidden_act_max = std::max(min_col_at - tRCD, now);
+        bool found_seamless_bank = false;
+        bool hidden_bank_prep = false;
+
+        std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
+        for (const auto& p : queue) {
+            if (p->rankRef.inRefIdleState())
+                got_waiting[p->bankId] = true;
+        }
+
+        for (int i = 0; i < ranksPerChannel; i++) {
+            for (int j = 0; j < banksPerRank; j++) {
+                uint16_t bank_id = i * banksPerRank + j;
+                if (got_waiting[bank_id]) {
+                    const TestBank &bank = banks[bank_id];
+                    Tick act_at = bank.openRow == TestBank::NO_ROW ?
+                        std::max(bank.actAllowedAt, now) :
+                        std::max(bank.preAllowedAt, now) + tRP;
+                    Tick col_at = std::max(bank.colAllowedAt, act_at + tRCD);
+                    bool new_seamless_bank = col_at <= min_col_at;
+                    if (new_seamless_bank ||
+                        (!found_seamless_bank && act_at <= min_act_at)) {
+                        if (!found_seamless_bank &&
+                            (new_seamless_bank || act_at < min_act_at)) {
+                            bank_mask = 0;
+                        }
+                        found_seamless_bank |= new_seamless_bank;
+                        hidden_bank_prep = act_at <= hidden_act_max;
+                        replaceBits(bank_mask, bank_id, bank_id, 1);
+                        min_act_at = act_at;
+                    }
+                }
+            }
+        }
+        return std::make_pair(bank_mask, hidden_bank_prep);
+    }
+
+    TestPacket *
+    chooseFRFCFS(Tick min_col_at, Tick now)
+    {
+        uint64_t earliest_banks = 0;
+        bool hidden_bank_prep = false;
+        bool found_hidden_bank = false;
+        bool found_prepped_pkt = false;
+        bool found_earliest_pkt = false;
+        auto selected_pkt_it = queue.end();
+
+        for (auto i = queue.begin(); i != queue.end() ; ++i) {
+            TestPacket* dram_pkt = *i;
+            const TestBank& bank = dram_pkt->bankRef;
+            if (dram_pkt->rankRef.inRefIdleState()) {
+                if (bank.openRow == dram_pkt->row) {
+                    if (bank.colAllowedAt <= min_col_at) {
+                        selected_pkt_it = i;
+                        break;
+                    } else if (!found_hidden_bank && !found_prepped_pkt) {
+                        selected_pkt_it = i;
+                        found_prepped_pkt = true;
+                    }
+                } else if (!found_earliest_pkt) {
+                    if (earliest_banks == 0) {
+                        std::pair<uint64_t, bool> bankStatus =
+                            minBankPrep(min_col_at, now);
+                        earliest_banks = bankStatus.first;
+                        hidden_bank_prep = bankStatus.second;
+                    }
+                    if (bits(earliest_banks, dram_pkt->bankId,
+                             dram_pkt->bankId)) {
+                        found_earliest_pkt = true;
+                        found_hidden_bank = hidden_bank_prep;
+                        if (hidden_bank_prep || !found_prepped_pkt)
+                            selected_pkt_it = i;
+                    }
+                }
+            }
+        }
+        return selected_pkt_it == queue.end() ? nullptr : *selected_pkt_it;
+    }
+
+    std::pair<unsigned, unsigned>
+    sameBank(const TestPacket *pkt) const
+    {
+        unsigned hits = 0, conflicts = 0;
+        for (auto p : queue) {
+            if (p != pkt && p->bankId == pkt->bankId) {
+                if (p->row == pkt->row)
+                    ++hits;
+                else
+                    ++conflicts;
+            }
+        }
+        return std::make_pair(hits, conflicts);
+    }
+
+    void
+    erase(TestPacket *pkt)
+    {
+        queue.erase(std::find(queue.begin(), queue.end(), pkt));
+    }
+};
+
+/**
+ * A DRAM channel with random bank and rank state that is fed random
+ * packets. Both queues hold the same packets in the same order.
+ */
+struct Channel
+{
+    const int ranksPerChannel;
+    const int banksPerRank;
+    const uint32_t rows;
+    std::vector<TestRank> ranks;
+    std::vector<TestBank> banks;
+    std::vector<std::unique_ptr<TestPacket>> packets;
+    Queue queue;
+    DequeQueue ref;
+    std::mt19937 rng;
+    Tick now;
+
+    Channel(int ranks_per_channel, int banks_per_rank, uint32_t _rows)
+        : ranksPerChannel(ranks_per_channel), banksPerRank(banks_per_rank),
+          rows(_rows), ranks(ranks_per_channel),
+          banks(ranks_per_channel * banks_per_rank),
+          queue(ranks_per_channel * banks_per_rank),
+          ref(ranks_per_channel, banks_per_rank, ranks, banks),
+          rng(1), now(1000000)
+    {}
+
+    TestPacket *
+    newPacket()
+    {
+        int bank_id = rng() % banks.size();
+        packets.emplace_back(new TestPacket{
+                uint8_t(bank_id / banksPerRank), uint8_t(bank_id % banksPerRank),
+                uint32_t(rng() % rows), uint16_t(bank_id),
+                banks[bank_id], ranks[bank_id / banksPerRank]});
+        return packets.back().get();
+    }
+
+    void
+    push(bool with_ref)
+    {
+        TestPacket *pkt = newPacket();
+        queue.push_back(pkt);
+        if (with_ref)
+            ref.queue.push_back(pkt);
+    }
+
+    Tick
+    randomTick()
+    {
+        return now - 40 + rng() % 120;
+    }
+
+    /** Advance time and change the state of a few banks and ranks. */
+    void
+    step()
+    {
+        now += rng() % 8;
+        for (int i = 0; i < 4; i++) {
+            TestBank &bank = banks[rng() % banks.size()];
+            bank.openRow = rng() % 4 ? uint32_t(rng() % rows) :
+                TestBank::NO_ROW;
+            bank.colAllowedAt = randomTick();
+            bank.preAllowedAt = randomTick();
+            bank.actAllowedAt = randomTick();
+        }
+        for (auto &rank : ranks)
+            rank.refreshing = rng() % 10 == 0;
+    }
+};
+
+void
+checkPolicy(bool frfcfs)
+{
+    Channel ch(2, 16, 6);
+    for (int i = 0; i < 200000; i++) {
+        ch.step();
+        while (ch.queue.size() < 48 && ch.rng() % 3)
+            ch.push(true);
+        if (ch.queue.empty())
+            continue;
+
+        Tick min_col_at = ch.now + ch.rng() % 40;
+        TestPacket *pkt = frfcfs ?
+            ch.queue.chooseFRFCFS(min_col_at, ch.now, tRCD, tRP) :
+            ch.queue.chooseFCFS();
+        TestPacket *ref_pkt = frfcfs ? ch.ref.chooseFRFCFS(min_col_at, ch.now) :
+            ch.ref.chooseFCFS();
+        ASSERT_EQ(pkt, ref_pkt) << "decision " << i;
+
+        if (pkt) {
+            ASSERT_EQ(ch.queue.sameBank(pkt), ch.ref.sameBank(pkt));
+            ch.queue.erase(pkt);
+            ch.ref.erase(pkt);
+        }
+        ASSERT_EQ(ch.queue.size(), ch.ref.queue.size());
+    }
+}
+
+} // anonymous namespace
+
+TEST(DRAMQueueTest, FCFSMatchesDeque)
+{
+    checkPolicy(false);
+}
+
+TEST(DRAMQueueTest, FRFCFSMatchesDeque)
+{
+    checkPolicy(true);
+}
+
+TEST(DRAMQueueTest, FindAndForEach)
+{
+    Channel ch(1, 8, 4);
+    for (int i = 0; i < 32; i++)
+        ch.push(false);
+
+    size_t n = 0;
+    ch.queue.forEach([&n](const TestPacket *) { n++; });
+    ASSERT_EQ(n, 32);
+
+    TestPacket *last = ch.packets.back().get();
+    auto is_last = [last](const TestPacket *p) { return p == last; };
+    ASSERT_EQ(ch.queue.find(is_last), last);
+    ch.queue.erase(last);
+    ASSERT_EQ(ch.queue.find(is_last), nullptr);
+    ASSERT_EQ(ch.queue.size(), 31);
+}
+
+/**
+ * Host time per serviced request with FR-FCFS on a deep queue, as in
+ * an HBM channel. Disabled by default; run with
+ * --gtest_also_run_disabled_tests --gtest_output=xml to get the times
+ * as properties of the test.
+ */
+TEST(DRAMQueueTest, DISABLED_Benchmark)
+{
+    const size_t depth = 256;
+    const int requests = 200000;
+    typedef std::chrono::steady_clock Clock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    Channel ch(2, 16, 1024);
+    Channel ref_ch(2, 16, 1024);
+    for (size_t i = 0; i < depth; i++) {
+        ch.push(false);
+        ref_ch.push(true);
+    }
+
+    auto start = Clock::now();
+    for (int i = 0; i < requests; i++) {
+        ch.step();
+        TestPacket *pkt = ch.queue.chooseFRFCFS(ch.now, ch.now, tRCD, tRP);
+        if (pkt) {
+            ch.queue.sameBank(pkt);
+            ch.queue.erase(pkt);
+            ch.push(false);
+        }
+    }
+    auto queue_time = Clock::now() - start;
+
+    start = Clock::now();
+    for (int i = 0; i < requests; i++) {
+        ref_ch.step();
+        TestPacket *pkt = ref_ch.ref.chooseFRFCFS(ref_ch.now, ref_ch.now);
+        if (pkt) {
+            ref_ch.ref.sameBank(pkt);
+            ref_ch.ref.erase(pkt);
+            ref_ch.ref.queue.push_back(ref_ch.newPacket());
+        }
+    }
+    auto deque_time = Clock::now() - start;
+
+    RecordProperty("queue_ns_per_request",
+                   duration_cast<nanoseconds>(queue_time).count() /
+                   requests);
+    RecordProperty("deque_ns_per_request",
+                   duration_cast<nanoseconds>(deque_time).count() /
+                   requests);
+    ASSERT_LT(queue_time, deque_time);
+}
@@ -42,11 +42,14 @@
 #include "base/compiler.hh"
 #include "base/trace.hh"
 #include "debug/MMU.hh"
+#include "sim/eventq.hh"
 #include "sim/faults.hh"
 #include "sim/serialize.hh"
 
 using namespace std;
 
+atomic<uint64_t> EmulationPageTable::_remapCount(0);
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -56,6 +59,8 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    auto lock = parallelLock(pTableMutex);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         if (it != pTable.end()) {
@@ -64,6 +69,7 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
                      "EmulationPageTable::allocate: addr %#x already mapped",
                      vaddr);
             it->second = Entry(paddr, flags);
+            ++_remapCount;
         } else {
             pTable.emplace(vaddr, Entry(paddr, flags));
         }
@@ -83,6 +89,7 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    auto lock = parallelLock(pTableMutex);
     while (size > 0) {
         auto new_it M5_VAR_USED = pTable.find(new_vaddr);
         auto old_it = pTable.find(vaddr);
@@ -90,6 +97,7 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 
         pTable.emplace(new_vaddr, old_it->second);
         pTable.erase(old_it);
+        ++_remapCount;
         size -= pageSize;
         vaddr += pageSize;
         new_vaddr += pageSize;
@@ -99,6 +107,7 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
+    auto lock = parallelLock(pTableMutex);
     for (auto &iter : pTable)
         addr_maps->push_back(make_pair(iter.first, iter.second.paddr));
 }
@@ -110,10 +119,12 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    auto lock = parallelLock(pTableMutex);
     while (size > 0) {
         auto it = pTable.find(vaddr);
         assert(it != pTable.end());
         pTable.erase(it);
+        ++_remapCount;
         size -= pageSize;
         vaddr += pageSize;
     }
@@ -125,6 +136,7 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
+    auto lock = parallelLock(pTableMutex);
     for (int64_t offset = 0; offset < size; offset += pageSize)
         if (pTable.find(vaddr + offset) != pTable.end())
             return false;
@@ -136,6 +148,7 @@ const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
     Addr page_addr = pageAlign(vaddr);
+    auto lock = parallelLock(pTableMutex);
     PTableItr iter = pTable.find(page_addr);
     if (iter == pTable.end())
         return nullptr;
@@ -145,12 +158,15 @@ EmulationPageTable::lookup(Addr vaddr)
 bool
 EmulationPageTable::translate(Addr vaddr, Addr &paddr)
 {
-    const Entry *entry = lookup(vaddr);
-    if (!entry) {
+    // Look up the entry directly rather than through lookup() so the
+    // physical address is read while the table is locked.
+    auto lock = parallelLock(pTableMutex);
+    PTableItr iter = pTable.find(pageAlign(vaddr));
+    if (iter == pTable.end()) {
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
+    paddr = pageOffset(vaddr) + iter->second.paddr;
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
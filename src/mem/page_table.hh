@@ -37,6 +37,8 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -64,6 +66,18 @@ class EmulationPageTable : public Serializable
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * Protects pTable while threads of a process are simulated on
+     * event queues running in parallel.
+     */
+    mutable std::mutex pTableMutex;
+
+    /**
+     * Number of times an existing mapping of any page table was
+     * changed or removed.
+     */
+    static std::atomic<uint64_t> _remapCount;
+
     const Addr pageSize;
     const Addr offsetMask;
 
@@ -82,6 +96,17 @@ class EmulationPageTable : public Serializable
 
     uint64_t pid() const { return _pid; };
 
+    /**
+     * Get a counter that changes whenever an existing mapping of any
+     * page table is changed or removed, so that CPU models caching
+     * translations can tell when they have gone stale.
+     */
+    static uint64_t
+    remapCount()
+    {
+        return _remapCount.load(std::memory_order_relaxed);
+    }
+
     virtual ~EmulationPageTable() {};
 
     /* generic page table mapping flags
@@ -46,16 +46,21 @@
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/sparse_store.hh"
 
 /**
  * On Linux, MAP_NORESERVE allow us to simulate a very large memory
@@ -73,9 +78,15 @@ using namespace std;
 
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
+                               bool mmap_using_noreserve,
+                               bool sparse_checkpoint,
+                               bool sparse_compress,
+                               unsigned sparse_max_chain,
+                               unsigned checkpoint_threads) :
     _name(_name), rangeCache(addrMap.end()), size(0),
-    mmapUsingNoReserve(mmap_using_noreserve)
+    mmapUsingNoReserve(mmap_using_noreserve),
+    sparseCheckpoint(sparse_checkpoint), sparseCompress(sparse_compress),
+    sparseMaxChain(sparse_max_chain), checkpointThreads(checkpoint_threads)
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
@@ -252,6 +263,27 @@ PhysicalMemory::isMemAddr(Addr addr) const
     }
 }
 
+uint8_t *
+PhysicalMemory::hostAddr(Addr addr, Addr size) const
+{
+    for (const auto& s : backingStore) {
+        if (s.inAddrMap && s.range.contains(addr) &&
+            s.range.contains(addr + size - 1))
+            return s.pmem + (addr - s.range.start());
+    }
+    return nullptr;
+}
+
+bool
+PhysicalMemory::hasLockedAddrs() const
+{
+    for (const auto& m : memories) {
+        if (!m->getLockedAddrList().empty())
+            return true;
+    }
+    return false;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -322,6 +354,41 @@ PhysicalMemory::functionalAccess(PacketPtr pkt)
 
 void
 PhysicalMemory::serialize(CheckpointOut &cp) const
+{
+    serializeLive(cp, vector<Addr>(), 0);
+}
+
+/**
+ * Name a checkpoint directory as seen from another one, relative if
+ * they are siblings (as the checkpoints of one run usually are) so
+ * that the whole campaign can be moved.
+ */
+static string
+checkpointPath(const string &from, const string &to)
+{
+    auto canonical = [](const string &dir) {
+        char *real = realpath(dir.c_str(), nullptr);
+        string path = real ? real : dir;
+        free(real);
+        while (path.size() > 1 && path.back() == '/')
+            path.pop_back();
+        return path;
+    };
+    auto parent = [](const string &path) {
+        return path.substr(0, path.rfind('/'));
+    };
+
+    string f = canonical(from);
+    string t = canonical(to);
+    if (parent(f) == parent(t))
+        return "../" + t.substr(t.rfind('/') + 1);
+    return t;
+}
+
+void
+PhysicalMemory::serializeLive(CheckpointOut &cp,
+                              const vector<Addr> &live_pages,
+                              Addr page_bytes) const
 {
     // serialize all the locked addresses and their context ids
     vector<Addr> lal_addr;
@@ -342,12 +409,28 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
     unsigned int nbr_of_stores = backingStore.size();
     SERIALIZE_SCALAR(nbr_of_stores);
 
+    if (sparseCheckpoint) {
+        // start a new chain with a full image once the current one
+        // reaches its maximum length
+        if (sparseChain.size() >= sparseMaxChain) {
+            sparseChain.clear();
+            savedGranules.clear();
+        }
+        savedGranules.resize(backingStore.size());
+    }
+
     unsigned int store_id = 0;
     // store each backing store memory segment in a file
     for (auto& s : backingStore) {
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
-        serializeStore(cp, store_id++, s.range, s.pmem);
+        if (sparseCheckpoint)
+            serializeSparseStore(cp, store_id++, live_pages, page_bytes);
+        else
+            serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    if (sparseCheckpoint)
+        sparseChain.push_back(CheckpointIn::dir());
 }
 
 void
@@ -396,6 +479,91 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::serializeSparseStore(CheckpointOut &cp,
+                                     unsigned int store_id,
+                                     const vector<Addr> &live_pages,
+                                     Addr page_bytes) const
+{
+    using namespace SparseStore;
+
+    const BackingStoreEntry &s = backingStore[store_id];
+    string filename = name() + ".store" + to_string(store_id) + ".spmem";
+    long range_size = s.range.size();
+    string format = "sparse";
+
+    fatal_if(range_size % GranuleBytes != 0,
+             "Backing store %s is not a multiple of %d bytes\n",
+             s.range.to_string(), GranuleBytes);
+
+    // the earlier images this one is an increment on
+    vector<string> parents;
+    for (const auto &dir : sparseChain)
+        parents.push_back(checkpointPath(CheckpointIn::dir(), dir));
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
+    SERIALIZE_CONTAINER(parents);
+
+    // only pages mapped by the simulated software can hold data,
+    // stores outside the global address map are saved whole
+    vector<uint64_t> candidates;
+    if (s.inAddrMap && !live_pages.empty()) {
+        for (Addr page : live_pages) {
+            if (!s.range.contains(page))
+                continue;
+            Addr start = page - s.range.start();
+            Addr end = min<Addr>(start + page_bytes, range_size);
+            for (Addr off = start - start % GranuleBytes; off < end;
+                 off += GranuleBytes)
+                candidates.push_back(off);
+        }
+        sort(candidates.begin(), candidates.end());
+        candidates.erase(unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+    } else {
+        for (uint64_t off = 0; off < s.range.size(); off += GranuleBytes)
+            candidates.push_back(off);
+    }
+
+    // save the granules that changed since the previous image, and
+    // skip those that have been zero all along
+    auto &saved = savedGranules[store_id];
+    saved.resize(range_size / GranuleBytes);
+    vector<uint8_t> changed(candidates.size(), 0);
+    parallelFor(checkpointThreads, candidates.size(), [&](uint64_t i) {
+        const uint8_t *data = s.pmem + candidates[i];
+        unique_ptr<uint8_t[]> &copy = saved[candidates[i] / GranuleBytes];
+        if (copy ? memcmp(copy.get(), data, GranuleBytes) == 0 :
+            isZeroGranule(data)) {
+            return;
+        }
+        if (!copy)
+            copy.reset(new uint8_t[GranuleBytes]);
+        memcpy(copy.get(), data, GranuleBytes);
+        changed[i] = 1;
+    });
+
+    vector<uint64_t> offsets;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (changed[i])
+            offsets.push_back(candidates[i]);
+    }
+
+    string filepath = CheckpointIn::dir() + "/" + filename;
+    uint64_t bytes;
+    string error;
+    if (!SparseStore::write(filepath, s.pmem, range_size, offsets,
+                            sparseCompress, checkpointThreads, bytes, error))
+        fatal("%s\n", error);
+
+    DPRINTF(Checkpoint, "Serialized %d of %d live granules of %s "
+            "(%d bytes, %d parents)\n", offsets.size(), candidates.size(),
+            filename, bytes, parents.size());
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -433,6 +601,12 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     string filepath = cp.cptDir + "/" + filename;
 
+    string format;
+    if (optParamIn(cp, "format", format, false) && format == "sparse") {
+        unserializeSparseStore(cp, store_id, filename);
+        return;
+    }
+
     // mmap memoryfile
     gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
     if (compressed_mem == NULL)
@@ -480,3 +654,44 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Close failed on physical memory checkpoint file '%s'\n",
               filename);
 }
+
+void
+PhysicalMemory::unserializeSparseStore(CheckpointIn &cp,
+                                       unsigned int store_id,
+                                       const string &filename)
+{
+    uint8_t* pmem = backingStore[store_id].pmem;
+    AddrRange range = backingStore[store_id].range;
+
+    long range_size;
+    UNSERIALIZE_SCALAR(range_size);
+    if (range_size != range.size())
+        fatal("Memory range size has changed! Saw %lld, expected %lld\n",
+              range_size, range.size());
+
+    vector<string> parents;
+    UNSERIALIZE_CONTAINER(parents);
+
+    // apply the increments oldest first, the image of this
+    // checkpoint goes last
+    vector<string> dirs;
+    for (const auto &p : parents)
+        dirs.push_back(p[0] == '/' ? p : cp.cptDir + "/" + p);
+    dirs.push_back(cp.cptDir);
+
+    for (const auto &dir : dirs) {
+        string filepath = dir + "/" + filename;
+        uint64_t granules;
+        string error;
+        if (!SparseStore::read(filepath, pmem, range_size, checkpointThreads,
+                               granules, error))
+            fatal("%s\n", error);
+        DPRINTF(Checkpoint, "Unserialized %d granules from %s\n",
+                granules, filepath);
+    }
+
+    // the hashes of the restored memory are unknown, so the next
+    // sparse checkpoint starts a new chain
+    sparseChain.clear();
+    savedGranules.clear();
+}
@@ -40,6 +40,8 @@
 #ifndef __MEM_PHYSICAL_HH__
 #define __MEM_PHYSICAL_HH__
 
+#include <memory>
+
 #include "base/addr_range_map.hh"
 #include "mem/packet.hh"
 
@@ -137,6 +139,33 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // Checkpoint only the live granules of each backing store
+    const bool sparseCheckpoint;
+
+    // Compress sparse memory images
+    const bool sparseCompress;
+
+    // Longest chain of incremental sparse checkpoints
+    const unsigned sparseMaxChain;
+
+    // Host threads used for sparse memory images (0: all cores)
+    const unsigned checkpointThreads;
+
+    /**
+     * Copy of every granule of each backing store as of the previous
+     * sparse checkpoint, null where the granule was not saved. A
+     * granule is only saved again if it differs from its copy, so the
+     * copies take as much host memory as the saved granules.
+     */
+    mutable std::vector<std::vector<std::unique_ptr<uint8_t[]>>>
+        savedGranules;
+
+    /**
+     * Directories of the sparse checkpoints taken so far by this run
+     * that the next one builds on, oldest first.
+     */
+    mutable std::vector<std::string> sparseChain;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -164,7 +193,11 @@ class PhysicalMemory : public Serializable
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   bool sparse_checkpoint,
+                   bool sparse_compress,
+                   unsigned sparse_max_chain,
+                   unsigned checkpoint_threads);
 
     /**
      * Unmap all the backing store we have used.
@@ -218,6 +251,26 @@ class PhysicalMemory : public Serializable
     std::vector<BackingStoreEntry> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Get the host pointer to a block of a memory in the global
+     * address map, for CPU models that access memory directly while
+     * fast-forwarding. As with getBackingStore(), the caller is
+     * responsible for keeping the memory state (e.g. locked
+     * addresses) consistent.
+     *
+     * @param addr Physical start address of the block
+     * @param size Size of the block
+     * @return Host pointer to the block, or nullptr if it is not
+     *         backed by a single backing store
+     */
+    uint8_t *hostAddr(Addr addr, Addr size) const;
+
+    /**
+     * Check if any memory tracks load-locked addresses, in which case
+     * stores have to go through access() to clear them.
+     */
+    bool hasLockedAddrs() const;
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -247,6 +300,19 @@ class PhysicalMemory : public Serializable
      */
     void serialize(CheckpointOut &cp) const override;
 
+    /**
+     * Serialize all the memories, restricting sparse images of the
+     * stores in the global address map to the pages that the
+     * simulated software can have touched.
+     *
+     * @param live_pages Physical addresses of the live pages, or an
+     *                   empty list if every page may be live
+     * @param page_bytes Size of the live pages
+     */
+    void serializeLive(CheckpointOut &cp,
+                       const std::vector<Addr> &live_pages,
+                       Addr page_bytes) const;
+
     /**
      * Serialize a specific store.
      *
@@ -257,6 +323,19 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Serialize the granules of a specific store that changed since
+     * the previous sparse checkpoint.
+     *
+     * @param store_id Unique identifier of this backing store
+     * @param live_pages Sorted physical addresses of the live pages,
+     *                   or an empty list if every page may be live
+     * @param page_bytes Size of the live pages
+     */
+    void serializeSparseStore(CheckpointOut &cp, unsigned int store_id,
+                              const std::vector<Addr> &live_pages,
+                              Addr page_bytes) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -269,6 +348,13 @@ class PhysicalMemory : public Serializable
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Unserialize a sparse image of a specific backing store, after
+     * the images of the checkpoints it is an increment on.
+     */
+    void unserializeSparseStore(CheckpointIn &cp, unsigned int store_id,
+                                const std::string &filename);
+
 };
 
 #endif //__MEM_PHYSICAL_HH__
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/sparse_store.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "base/cprintf.hh"
+
+using namespace std;
+
+namespace SparseStore
+{
+
+namespace
+{
+
+const char fileMagic[8] = { 'G', '5', 'S', 'P', 'A', 'R', 'S', 'E' };
+const uint32_t fileVersion = 1;
+
+/** Header flag: chunks were compressed when the image was written. */
+const uint32_t FlagCompressed = 0x1;
+
+/**
+ * The header sits at the start of the file, padded to a granule so
+ * that the chunks of an uncompressed image stay granule aligned.
+ * Images are written in host byte order.
+ */
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t granuleBytes;
+    uint64_t storeSize;
+    uint64_t numChunks;
+    uint64_t indexOffset;
+};
+
+/** Index entry describing one run of adjacent granules. */
+struct ChunkEntry
+{
+    uint64_t storeOffset;
+    uint64_t fileOffset;
+    uint32_t granules;
+    /** Size in the file; equal to the raw size if stored as is. */
+    uint32_t bytes;
+
+    uint64_t rawBytes() const { return granules * GranuleBytes; }
+    bool stored() const { return bytes == rawBytes(); }
+};
+
+bool
+writeAll(int fd, const void *buf, uint64_t len, uint64_t offset,
+         const string &path, string &error)
+{
+    const uint8_t *p = static_cast<const uint8_t *>(buf);
+    while (len > 0) {
+        ssize_t n = pwrite(fd, p, len, offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            error = csprintf("Write failed on sparse memory image '%s'",
+                             path);
+            return false;
+        }
+        p += n;
+        len -= n;
+        offset += n;
+    }
+    return true;
+}
+
+bool
+readAll(int fd, void *buf, uint64_t len, uint64_t offset,
+        const string &path, string &error)
+{
+    uint8_t *p = static_cast<uint8_t *>(buf);
+    while (len > 0) {
+        ssize_t n = pread(fd, p, len, offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            error = csprintf("Read failed on sparse memory image '%s'",
+                             path);
+            return false;
+        }
+        p += n;
+        len -= n;
+        offset += n;
+    }
+    return true;
+}
+
+unsigned
+hostThreads(unsigned threads)
+{
+    if (threads == 0)
+        threads = thread::hardware_concurrency();
+    return max(threads, 1u);
+}
+
+} // anonymous namespace
+
+bool
+isZeroGranule(const uint8_t *data)
+{
+    uint64_t acc = 0;
+    for (uint64_t i = 0; i < GranuleBytes; i += sizeof(acc)) {
+        uint64_t w;
+        memcpy(&w, data + i, sizeof(w));
+        acc |= w;
+    }
+    return acc == 0;
+}
+
+void
+parallelFor(unsigned threads, uint64_t n,
+            const function<void(uint64_t)> &func)
+{
+    threads = min<uint64_t>(hostThreads(threads), n);
+    if (threads <= 1) {
+        for (uint64_t i = 0; i < n; ++i)
+            func(i);
+        return;
+    }
+
+    atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            func(i);
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+}
+
+bool
+write(const string &path, const uint8_t *pmem, uint64_t store_size,
+      const vector<uint64_t> &offsets, bool compress, unsigned threads,
+      uint64_t &bytes, string &error)
+{
+    // group adjacent granules into chunks
+    vector<ChunkEntry> index;
+    for (uint64_t off : offsets) {
+        assert(off % GranuleBytes == 0 && off < store_size);
+        if (!index.empty()) {
+            ChunkEntry &last = index.back();
+            if (last.storeOffset + last.rawBytes() == off &&
+                last.granules < MaxChunkGranules) {
+                ++last.granules;
+                continue;
+            }
+        }
+        index.push_back(ChunkEntry{off, 0, 1, 0});
+    }
+
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd < 0) {
+        error = csprintf("Can't open sparse memory image '%s'", path);
+        return false;
+    }
+
+    // compress a bounded batch of chunks at a time so that the
+    // buffers never hold more than a few chunks per thread
+    const uint64_t batch = hostThreads(threads) * 8;
+    vector<vector<uint8_t>> bufs(compress ? batch : 0);
+    uint64_t pos = GranuleBytes;
+
+    for (uint64_t base = 0; base < index.size(); base += batch) {
+        const uint64_t count = min<uint64_t>(batch, index.size() - base);
+
+        if (compress) {
+            parallelFor(threads, count, [&](uint64_t i) {
+                ChunkEntry &c = index[base + i];
+                vector<uint8_t> &buf = bufs[i];
+                uLongf len = compressBound(c.rawBytes());
+                buf.resize(len);
+                if (compress2(buf.data(), &len, pmem + c.storeOffset,
+                              c.rawBytes(), Z_BEST_SPEED) == Z_OK &&
+                    len < c.rawBytes()) {
+                    c.bytes = len;
+                } else {
+                    // incompressible, keep the raw granules
+                    c.bytes = c.rawBytes();
+                }
+            });
+        }
+
+        for (uint64_t i = 0; i < count; ++i) {
+            ChunkEntry &c = index[base + i];
+            if (!compress)
+                c.bytes = c.rawBytes();
+            c.fileOffset = pos;
+            if (!writeAll(fd, c.stored() ? pmem + c.storeOffset :
+                          bufs[i].data(), c.bytes, pos, path, error)) {
+                close(fd);
+                return false;
+            }
+            pos += c.bytes;
+        }
+    }
+
+    FileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, fileMagic, sizeof(fileMagic));
+    hdr.version = fileVersion;
+    hdr.flags = compress ? FlagCompressed : 0;
+    hdr.granuleBytes = GranuleBytes;
+    hdr.storeSize = store_size;
+    hdr.numChunks = index.size();
+    hdr.indexOffset = pos;
+
+    if (!writeAll(fd, index.data(), index.size() * sizeof(ChunkEntry), pos,
+                  path, error) ||
+        !writeAll(fd, &hdr, sizeof(hdr), 0, path, error)) {
+        close(fd);
+        return false;
+    }
+    pos += index.size() * sizeof(ChunkEntry);
+
+    if (close(fd) != 0) {
+        error = csprintf("Close failed on sparse memory image '%s'", path);
+        return false;
+    }
+
+    bytes = pos;
+    return true;
+}
+
+bool
+read(const string &path, uint8_t *pmem, uint64_t store_size,
+     unsigned threads, uint64_t &granules, string &error)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = csprintf("Can't open sparse memory image '%s'", path);
+        return false;
+    }
+
+    auto fail = [fd, &error](const string &msg) {
+        close(fd);
+        error = msg;
+        return false;
+    };
+
+    FileHeader hdr;
+    if (!readAll(fd, &hdr, sizeof(hdr), 0, path, error))
+        return fail(error);
+    if (memcmp(hdr.magic, fileMagic, sizeof(fileMagic)) != 0 ||
+        hdr.version != fileVersion)
+        return fail(csprintf("'%s' is not a sparse memory image", path));
+    if (hdr.granuleBytes != GranuleBytes)
+        return fail(csprintf("Sparse memory image '%s' uses %d byte "
+                             "granules, expected %d", path,
+                             hdr.granuleBytes, GranuleBytes));
+    if (hdr.storeSize != store_size)
+        return fail(csprintf("Memory range size has changed! Saw %lld, "
+                             "expected %lld", hdr.storeSize, store_size));
+
+    vector<ChunkEntry> index(hdr.numChunks);
+    if (!readAll(fd, index.data(), index.size() * sizeof(ChunkEntry),
+                 hdr.indexOffset, path, error))
+        return fail(error);
+
+    granules = 0;
+    for (const auto &c : index) {
+        if (c.storeOffset + c.rawBytes() > store_size)
+            return fail(csprintf("Sparse memory image '%s' is corrupt",
+                                 path));
+        granules += c.granules;
+    }
+
+    // Uncompressed images are mapped copy-on-write on top of the
+    // backing store, so only the pages the workload touches after the
+    // restore are ever read from the file. Chunks that are adjacent
+    // both in memory and in the file share a single mapping.
+    vector<bool> mapped(index.size(), false);
+    const uint64_t host_page = sysconf(_SC_PAGESIZE);
+    if (!(hdr.flags & FlagCompressed) && GranuleBytes % host_page == 0) {
+        for (uint64_t i = 0; i < index.size(); ) {
+            uint64_t j = i + 1;
+            while (j < index.size() &&
+                   index[j].storeOffset == index[j - 1].storeOffset +
+                   index[j - 1].rawBytes() &&
+                   index[j].fileOffset == index[j - 1].fileOffset +
+                   index[j - 1].bytes)
+                ++j;
+
+            const ChunkEntry &first = index[i];
+            const ChunkEntry &last = index[j - 1];
+            uint64_t len = last.storeOffset + last.rawBytes() -
+                first.storeOffset;
+            void *addr = mmap(pmem + first.storeOffset, len,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_FIXED, fd, first.fileOffset);
+            if (addr == MAP_FAILED) {
+                // Running out of mappings is not an error, the
+                // remaining chunks are simply copied. A failed fixed
+                // mapping may have left a hole behind, so put fresh
+                // anonymous memory back first.
+                addr = mmap(pmem + first.storeOffset, len,
+                            PROT_READ | PROT_WRITE,
+                            MAP_ANON | MAP_PRIVATE | MAP_FIXED, -1, 0);
+                if (addr == MAP_FAILED)
+                    return fail(csprintf("Could not remap backing store "
+                                         "after failing to map '%s'",
+                                         path));
+                break;
+            }
+            fill(mapped.begin() + i, mapped.begin() + j, true);
+            i = j;
+        }
+    }
+
+    // the workers keep the first failure they see
+    mutex error_lock;
+    bool failed = false;
+    auto chunk_failed = [&](const string &msg) {
+        lock_guard<mutex> guard(error_lock);
+        if (!failed)
+            error = msg;
+        failed = true;
+    };
+
+    parallelFor(threads, index.size(), [&](uint64_t i) {
+        if (mapped[i])
+            return;
+
+        const ChunkEntry &c = index[i];
+        uint8_t *dst = pmem + c.storeOffset;
+        string chunk_error;
+        if (c.stored()) {
+            if (!readAll(fd, dst, c.bytes, c.fileOffset, path, chunk_error))
+                chunk_failed(chunk_error);
+            return;
+        }
+
+        vector<uint8_t> buf(c.bytes);
+        if (!readAll(fd, buf.data(), c.bytes, c.fileOffset, path,
+                     chunk_error)) {
+            chunk_failed(chunk_error);
+            return;
+        }
+        uLongf len = c.rawBytes();
+        if (uncompress(dst, &len, buf.data(), c.bytes) != Z_OK ||
+            len != c.rawBytes())
+            chunk_failed(csprintf("Sparse memory image '%s' is corrupt",
+                                  path));
+    });
+
+    // the mappings keep their own reference to the file
+    close(fd);
+
+    return !failed;
+}
+
+} // namespace SparseStore
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Sparse, optionally compressed backing store images used by
+ * PhysicalMemory for incremental checkpoints.
+ *
+ * An image holds a subset of the granules of one backing store. Runs
+ * of adjacent granules are grouped into chunks that are compressed
+ * independently, so both writing and restoring can be spread over
+ * several host threads. Uncompressed images keep every chunk aligned
+ * to the granule size in the file, which lets a restore map them
+ * straight into the backing store and leave the page-in to the host.
+ */
+
+#ifndef __MEM_SPARSE_STORE_HH__
+#define __MEM_SPARSE_STORE_HH__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SparseStore
+{
+
+/** Size in bytes of the unit that is tracked and stored. */
+const uint64_t GranuleBytes = 4096;
+
+/** Largest number of adjacent granules grouped into one chunk. */
+const uint64_t MaxChunkGranules = 64;
+
+/** @return Whether the granule only contains zero bytes. */
+bool isZeroGranule(const uint8_t *data);
+
+/**
+ * Run func(i) for every i in [0, n) on up to the given number of
+ * host threads. A thread count of zero uses every host core.
+ */
+void parallelFor(unsigned threads, uint64_t n,
+                 const std::function<void(uint64_t)> &func);
+
+/**
+ * Write an image of a backing store.
+ *
+ * @param path File to create
+ * @param pmem Host pointer to the backing store
+ * @param store_size Size of the backing store in bytes
+ * @param offsets Sorted granule-aligned offsets of the granules to save
+ * @param compress Whether chunks are compressed
+ * @param threads Host threads used for compression
+ * @param bytes Set to the number of bytes written to the file
+ * @param error Set to a description of the failure, if any
+ * @return Whether the image was written
+ */
+bool write(const std::string &path, const uint8_t *pmem,
+           uint64_t store_size, const std::vector<uint64_t> &offsets,
+           bool compress, unsigned threads, uint64_t &bytes,
+           std::string &error);
+
+/**
+ * Restore an image on top of a backing store. Granules that are not
+ * part of the image are left untouched, so a chain of incremental
+ * images is restored by reading them oldest first.
+ *
+ * @param path File to read
+ * @param pmem Host pointer to the backing store
+ * @param store_size Size of the backing store in bytes
+ * @param threads Host threads used for decompression
+ * @param granules Set to the number of granules restored
+ * @param error Set to a description of the failure, if any
+ * @return Whether the image was restored; the backing store is left
+ *         partially updated if not
+ */
+bool read(const std::string &path, uint8_t *pmem, uint64_t store_size,
+          unsigned threads, uint64_t &granules, std::string &error);
+
+} // namespace SparseStore
+
+#endif // __MEM_SPARSE_STORE_HH__
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mem/sparse_store.hh"
+
+using namespace SparseStore;
+
+namespace
+{
+
+const uint64_t storeSize = 256 * GranuleBytes;
+
+/** Anonymous mapping standing in for a PhysicalMemory backing store. */
+struct Store
+{
+    uint8_t *pmem;
+
+    Store()
+        : pmem(static_cast<uint8_t *>(mmap(nullptr, storeSize,
+                                           PROT_READ | PROT_WRITE,
+                                           MAP_ANON | MAP_PRIVATE, -1, 0)))
+    {}
+
+    ~Store() { munmap(pmem, storeSize); }
+
+    uint8_t *granule(uint64_t i) { return pmem + i * GranuleBytes; }
+};
+
+std::string
+tempImage()
+{
+    char path[] = "/tmp/sparse_store_testXXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    return path;
+}
+
+void
+fillGranule(uint8_t *dst, uint64_t seed, bool compressible)
+{
+    std::mt19937_64 rng(seed);
+    for (uint64_t i = 0; i < GranuleBytes; i += 8) {
+        uint64_t w = compressible ? (i / 64) * seed : rng();
+        memcpy(dst + i, &w, sizeof(w));
+    }
+}
+
+void
+roundTrip(bool compress)
+{
+    Store src, dst;
+    std::vector<uint64_t> offsets;
+    // a long run, a few isolated granules and some untouched ones
+    for (uint64_t i = 10; i < 150; ++i) {
+        fillGranule(src.granule(i), i, i % 2);
+        offsets.push_back(i * GranuleBytes);
+    }
+    for (uint64_t i : {200, 202, 255}) {
+        fillGranule(src.granule(i), i, false);
+        offsets.push_back(i * GranuleBytes);
+    }
+
+    std::string path = tempImage();
+    uint64_t bytes, granules;
+    std::string error;
+    ASSERT_TRUE(write(path, src.pmem, storeSize, offsets, compress, 4,
+                      bytes, error)) << error;
+    EXPECT_GT(bytes, 0u);
+    ASSERT_TRUE(read(path, dst.pmem, storeSize, 4, granules, error))
+        << error;
+    EXPECT_EQ(offsets.size(), granules);
+    EXPECT_EQ(0, memcmp(src.pmem, dst.pmem, storeSize));
+    unlink(path.c_str());
+}
+
+} // anonymous namespace
+
+TEST(SparseStoreTest, CompressedRoundTrip)
+{
+    roundTrip(true);
+}
+
+TEST(SparseStoreTest, RawRoundTrip)
+{
+    roundTrip(false);
+}
+
+TEST(SparseStoreTest, IncrementalChain)
+{
+    Store src, dst;
+    std::vector<uint64_t> all, changed;
+    for (uint64_t i = 0; i < 32; ++i) {
+        fillGranule(src.granule(i), i + 1, false);
+        all.push_back(i * GranuleBytes);
+    }
+    uint64_t bytes, granules;
+    std::string error;
+    std::string parent = tempImage();
+    ASSERT_TRUE(write(parent, src.pmem, storeSize, all, false, 2, bytes,
+                      error)) << error;
+
+    for (uint64_t i = 4; i < 8; ++i) {
+        fillGranule(src.granule(i), i + 100, true);
+        changed.push_back(i * GranuleBytes);
+    }
+    std::string child = tempImage();
+    ASSERT_TRUE(write(child, src.pmem, storeSize, changed, true, 2, bytes,
+                      error)) << error;
+
+    ASSERT_TRUE(read(parent, dst.pmem, storeSize, 2, granules, error))
+        << error;
+    ASSERT_TRUE(read(child, dst.pmem, storeSize, 2, granules, error))
+        << error;
+    EXPECT_EQ(changed.size(), granules);
+    EXPECT_EQ(0, memcmp(src.pmem, dst.pmem, storeSize));
+
+    // the mapped parent image is private to this store
+    dst.pmem[0] ^= 0xff;
+    Store again;
+    ASSERT_TRUE(read(parent, again.pmem, storeSize, 1, granules, error))
+        << error;
+    EXPECT_EQ(src.pmem[0], again.pmem[0]);
+
+    unlink(parent.c_str());
+    unlink(child.c_str());
+}
+
+TEST(SparseStoreTest, BadImages)
+{
+    Store src, dst;
+    uint64_t bytes, granules;
+    std::string error;
+
+    EXPECT_FALSE(read("/nonexistent/sparse_store_test", dst.pmem, storeSize,
+                      1, granules, error));
+    EXPECT_NE(std::string::npos, error.find("Can't open"));
+
+    // not an image at all
+    std::string path = tempImage();
+    std::string text(GranuleBytes, 'x');
+    FILE *f = fopen(path.c_str(), "w");
+    fwrite(text.data(), 1, text.size(), f);
+    fclose(f);
+    EXPECT_FALSE(read(path, dst.pmem, storeSize, 1, granules, error));
+    EXPECT_NE(std::string::npos, error.find("is not a sparse memory image"));
+
+    // an image of a store with a different size
+    std::vector<uint64_t> offsets = { 0 };
+    ASSERT_TRUE(write(path, src.pmem, storeSize, offsets, true, 1, bytes,
+                      error)) << error;
+    EXPECT_FALSE(read(path, dst.pmem, storeSize / 2, 1, granules, error));
+    EXPECT_NE(std::string::npos, error.find("size has changed"));
+    unlink(path.c_str());
+}
+
+TEST(SparseStoreTest, ZeroGranule)
+{
+    std::vector<uint8_t> a(GranuleBytes, 0);
+    EXPECT_TRUE(isZeroGranule(a.data()));
+
+    a[GranuleBytes - 1] = 1;
+    EXPECT_FALSE(isZeroGranule(a.data()));
+    a[GranuleBytes - 1] = 0;
+    a[0] = 1;
+    EXPECT_FALSE(isZeroGranule(a.data()));
+}
@@ -132,7 +132,8 @@ def parse_options():
     option("--debug-end", metavar="TICK", type='int',
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
-        help="Sets the output file for debug [Default: %default]")
+        help="Sets the output file for debug, binary://FILE for a binary "
+        "trace (see util/decode_debug_trace.py) [Default: %default]")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
     option("--remote-gdb-port", type='int', default=7000,
@@ -397,7 +398,10 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_file.startswith("binary://"):
+        trace.binaryOutput(options.debug_file[len("binary://"):])
+    else:
+        trace.output(options.debug_file)
 
     for ignore in options.debug_ignore:
         check_tracing()
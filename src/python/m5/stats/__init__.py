@@ -115,11 +115,26 @@ def _textFactory(fn, desc=True):
 
     return _m5.stats.initText(fn, desc)
 
+@_url_factory
+def _binaryFactory(fn):
+    """Output stats in columnar binary format.
+
+    Binary stat files contain the stat names once, followed by one
+    record per dump with the values that changed since the previous
+    dump. Use util/binstats.py to read them.
+
+    Example: binary://stats.bin
+
+    """
+
+    return _m5.stats.initBinary(fn)
+
 factories = {
     # Default to the text factory if we're given a naked path
     "" : _textFactory,
     "file" : _textFactory,
     "text" : _textFactory,
+    "binary" : _binaryFactory,
 }
 
 def addStatVisitor(url):
@@ -27,4 +27,5 @@
 # Authors: Nathan Binkert
 
 # Export native methods to Python
-from _m5.trace import output, ignore, disable, enable
+from _m5.trace import output, binaryOutput, decodeBinary, convertPipeTrace, \
+     ignore, disable, enable
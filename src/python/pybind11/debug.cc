@@ -45,12 +45,15 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <fstream>
 #include <map>
 #include <vector>
 
 #include "base/debug.hh"
+#include "base/logging.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "cpu/pipe_trace.hh"
 #include "sim/debug.hh"
 
 namespace py = pybind11;
@@ -70,6 +73,61 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename)
+{
+    OutputStream *file_stream = simout.findOrCreate(filename, true);
+
+    Trace::setDebugLogger(new Trace::BinaryLogger(*file_stream->stream()));
+}
+
+static bool
+decodeBinary(const std::string &in_name, const std::string &out_name,
+             Tick start, Tick end, const std::string &names, bool sort)
+{
+    std::ifstream in(in_name, std::ios::binary);
+    if (!in)
+        fatal("Can't open binary trace %s\n", in_name);
+
+    std::ofstream out_file;
+    if (!out_name.empty()) {
+        out_file.open(out_name);
+        if (!out_file)
+            fatal("Can't create %s\n", out_name);
+    }
+
+    Trace::BinaryTraceFilter filter;
+    filter.start = start;
+    filter.end = end;
+    filter.names = names;
+    filter.sort = sort;
+    return Trace::decodeBinaryTrace(
+        in, out_name.empty() ? std::cout : out_file, filter);
+}
+
+static bool
+convertPipeTrace(const std::string &in_name, const std::string &out_name,
+                 const std::string &format, size_t reorder_window)
+{
+    std::ifstream in(in_name, std::ios::binary);
+    if (!in)
+        fatal("Can't open pipeline trace %s\n", in_name);
+
+    std::ofstream out_file;
+    if (!out_name.empty()) {
+        out_file.open(out_name);
+        if (!out_file)
+            fatal("Can't create %s\n", out_name);
+    }
+    std::ostream &out = out_name.empty() ? std::cout : out_file;
+
+    if (format == "konata")
+        return pipeTraceToKonata(in, out, reorder_window);
+    else if (format == "o3pipeview")
+        return pipeTraceToO3PipeView(in, out);
+    fatal("Unknown pipeline trace format %s\n", format);
+}
+
 static void
 ignore(const char *expr)
 {
@@ -112,6 +170,15 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
+        .def("decodeBinary", &decodeBinary,
+             py::arg("trace"), py::arg("output") = "",
+             py::arg("start") = 0, py::arg("end") = MaxTick,
+             py::arg("names") = "", py::arg("sort") = false)
+        .def("convertPipeTrace", &convertPipeTrace,
+             py::arg("trace"), py::arg("output") = "",
+             py::arg("format") = "konata",
+             py::arg("reorder_window") = 65536)
         .def("ignore", &ignore)
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
@@ -68,6 +68,13 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Keep the events of the main event queues in a timing wheel instead
+    # of a single sorted list. Both service events in the same order.
+    event_queue_wheel_slots = Param.Unsigned(0,
+        "slots of the event queue timing wheel (0: sorted list)")
+    event_queue_wheel_resolution = Param.Tick(512,
+        "ticks per slot of the event queue timing wheel")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
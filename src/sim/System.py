@@ -51,6 +51,13 @@ from SimpleMemory import *
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+# Policies for turning clock_gettime() calls in an SE workload into
+# region-of-interest stat dumps. 'nth' dumps at the roi_begin_count-th
+# and roi_end_count-th call, 'pairs' dumps at every call (so calls
+# 2k-1 and 2k enclose region k), and 'per_thread' works like 'nth' but
+# only counts the calls made by thread context roi_context_id.
+class RoiPolicy(Enum): vals = ['none', 'nth', 'pairs', 'per_thread']
+
 class System(MemObject):
     type = 'System'
     cxx_header = "sim/system.hh"
@@ -76,6 +83,20 @@ class System(MemObject):
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
 
+    # Sparse checkpoints only save the memory that the workload can
+    # have touched (in SE mode, the pages mapped by its page tables),
+    # and only the parts that changed since the previous checkpoint
+    # of the same run. Restoring such a checkpoint needs the earlier
+    # checkpoints of its chain.
+    sparse_checkpoint = Param.Bool(False, "Save only touched and " \
+                                   "changed memory in checkpoints")
+    sparse_checkpoint_compress = Param.Bool(True, "Compress sparse " \
+        "memory images; uncompressed ones are restored lazily with mmap")
+    sparse_checkpoint_max_chain = Param.Unsigned(8, "Number of " \
+        "checkpoints in a chain of increments (1: every one is full)")
+    checkpoint_threads = Param.Unsigned(0, "Host threads used for " \
+        "sparse memory images (0: all host cores)")
+
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
     # I/O bridge or cache
@@ -100,6 +121,19 @@ class System(MemObject):
     work_cpus_ckpt_count = Param.Counter(0,
         "create checkpoint when active cpu count value is reached")
 
+    roi_policy = Param.RoiPolicy('none',
+        "dump and reset stats at clock_gettime() region of interest markers")
+    roi_begin_count = Param.Counter(1,
+        "clock_gettime() call that opens the region of interest")
+    roi_end_count = Param.Counter(2,
+        "clock_gettime() call that closes the region of interest")
+    roi_context_id = Param.Int(0,
+        "thread context whose calls are counted by the per_thread policy")
+    exit_on_roi = Param.Bool(False,
+        "exit the simulation loop at the first region of interest boundary "
+        "(or the first clock_gettime() call without a policy), e.g. to "
+        "switch from fast-forwarding to a detailed CPU")
+
     init_param = Param.UInt64(0, "numerical value to pass into simulator")
     boot_osflags = Param.String("a", "boot flags to pass to the kernel")
     kernel = Param.String("", "file that contains the kernel code")
@@ -28,7 +28,9 @@
  * Authors: Nathan Binkert
  */
 
-volatile bool async_event = false;
+#include "sim/async.hh"
+
+std::atomic<bool> async_event(false);
 volatile bool async_statdump = false;
 volatile bool async_statreset = false;
 volatile bool async_exit = false;
@@ -32,6 +32,8 @@
 #ifndef __ASYNC_HH__
 #define __ASYNC_HH__
 
+#include <atomic>
+
 ///
 /// @file sim/async.hh
 /// This file defines flags used to handle asynchronous simulator events.
@@ -41,7 +43,7 @@
 /// To avoid races, signal handlers simply set these flags, which are
 /// then checked in the main event loop.  Defined in main.cc.
 //@{
-extern volatile bool async_event;       ///< Some asynchronous event has happened.
+extern std::atomic<bool> async_event;   ///< Some asynchronous event has happened.
 extern volatile bool async_statdump;    ///< Async request to dump stats.
 extern volatile bool async_statreset;   ///< Async request to reset stats.
 extern volatile bool async_exit;        ///< Async request to exit simulator.
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Timing wheel backend of the event queue.
+ *
+ * The wheel splits the near future into slots of a power-of-two number
+ * of ticks. Each slot keeps its events in the same sorted list of bins
+ * as the plain event queue, so inserting an event only walks the few
+ * bins of its own slot instead of every pending tick. Events beyond the
+ * wheel are kept in an ordered map of bins and move into the wheel once
+ * it has turned far enough.
+ */
+
+#ifndef __SIM_EVENT_WHEEL_HH__
+#define __SIM_EVENT_WHEEL_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+/**
+ * Events ordered by when(), then priority(), then in LIFO order within
+ * a (when, priority) bin, exactly as in a plain EventQueue. Ev must
+ * provide when(), priority(), the comparison operators of Event and the
+ * nextBin and nextInBin links.
+ */
+template <class Ev>
+class EventWheel
+{
+  private:
+    typedef std::pair<Tick, int> BinKey;
+
+    /** Sorted bin list of each slot. */
+    std::vector<Ev *> slots;
+    /** One bit per non-empty slot. */
+    std::vector<uint64_t> occupied;
+    const Tick mask;
+    const unsigned shift;
+
+    /** First slot covered by the wheel. */
+    Tick base;
+    /** First non-empty slot, valid when usedSlots is non-zero. */
+    Tick cursor;
+    size_t usedSlots;
+
+    /** Top of each bin beyond the wheel. */
+    std::map<BinKey, Ev *> far;
+
+    static BinKey key(const Ev *e) { return BinKey(e->when(), e->priority()); }
+
+    Tick slotOf(const Ev *e) const { return e->when() >> shift; }
+    bool inWheel(Tick slot) const { return slot - base <= mask; }
+
+    void
+    setOccupied(Tick slot)
+    {
+        Tick idx = slot & mask;
+        occupied[idx / 64] |= ULL(1) << (idx % 64);
+    }
+
+    void
+    clearOccupied(Tick slot)
+    {
+        Tick idx = slot & mask;
+        occupied[idx / 64] &= ~(ULL(1) << (idx % 64));
+    }
+
+    /** Same as Event::insertBefore. */
+    static Ev *
+    insertBefore(Ev *event, Ev *curr)
+    {
+        if (!curr || *event < *curr) {
+            event->nextBin = curr;
+            event->nextInBin = nullptr;
+        } else {
+            event->nextBin = curr->nextBin;
+            event->nextInBin = curr;
+        }
+        return event;
+    }
+
+    /** Same as Event::removeItem. */
+    static Ev *
+    removeItem(Ev *event, Ev *top)
+    {
+        Ev *curr = top;
+        Ev *next = top->nextInBin;
+
+        if (event == top) {
+            if (!next)
+                return top->nextBin;
+            next->nextBin = top->nextBin;
+            return next;
+        }
+
+        while (event != next) {
+            assert(next);
+            curr = next;
+            next = next->nextInBin;
+        }
+        curr->nextInBin = next->nextInBin;
+        return top;
+    }
+
+    /** Insert an event in a sorted bin list, as EventQueue::insert. */
+    static void
+    insertList(Ev *&list, Ev *event)
+    {
+        if (!list || *event <= *list) {
+            list = insertBefore(event, list);
+            return;
+        }
+
+        Ev *prev = list;
+        Ev *curr = list->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = insertBefore(event, curr);
+    }
+
+    /** Remove an event from a sorted bin list, as EventQueue::remove. */
+    static void
+    removeList(Ev *&list, Ev *event)
+    {
+        assert(list);
+        if (*list == *event) {
+            list = removeItem(event, list);
+            return;
+        }
+
+        Ev *prev = list;
+        Ev *curr = list->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        assert(curr && *curr == *event);
+        prev->nextBin = removeItem(event, curr);
+    }
+
+    /** Link a whole bin into a sorted bin list that lacks its key. */
+    static void
+    insertBin(Ev *&list, Ev *top)
+    {
+        Ev **link = &list;
+        while (*link && **link < *top)
+            link = &(*link)->nextBin;
+        assert(!*link || *top < **link);
+        top->nextBin = *link;
+        *link = top;
+    }
+
+    /** Put a whole bin in its slot or beyond the wheel. */
+    void
+    placeBin(Ev *top)
+    {
+        Tick slot = slotOf(top);
+        if (!inWheel(slot)) {
+            top->nextBin = nullptr;
+            far.emplace_hint(far.end(), key(top), top);
+            return;
+        }
+
+        Ev *&list = slots[slot & mask];
+        if (!list) {
+            setOccupied(slot);
+            if (!usedSlots++ || slot < cursor)
+                cursor = slot;
+        }
+        insertBin(list, top);
+    }
+
+    /**
+     * First non-empty slot at or after from. The slots between base and
+     * from must be empty.
+     */
+    Tick
+    findOccupied(Tick from) const
+    {
+        for (Tick off = from - base; off <= mask; ) {
+            Tick idx = (base + off) & mask;
+            uint64_t bits = occupied[idx / 64] >> (idx % 64);
+            if (bits) {
+                idx += findLsbSet(bits);
+                return base + ((idx - base) & mask);
+            }
+            off += 64 - idx % 64;
+        }
+        assert(false);
+        return from;
+    }
+
+    /** Move bins the wheel has reached out of the far map. */
+    void
+    pullFar()
+    {
+        while (!far.empty() && inWheel(far.begin()->first.first >> shift)) {
+            Ev *top = far.begin()->second;
+            far.erase(far.begin());
+            placeBin(top);
+        }
+    }
+
+    /** Restart the wheel at an earlier slot. */
+    void
+    rewind(Tick slot)
+    {
+        if (!usedSlots) {
+            // Everything beyond the wheel stays beyond it
+            base = slot;
+            return;
+        }
+
+        Ev *list = flatten();
+        load(list, slot << shift);
+    }
+
+  public:
+    /**
+     * @param num_slots Number of slots, a power of two of at least 64.
+     * @param slot_ticks Ticks per slot, a power of two.
+     */
+    EventWheel(unsigned num_slots, Tick slot_ticks)
+        : slots(num_slots, nullptr), occupied(num_slots / 64, 0),
+          mask(num_slots - 1), shift(floorLog2(slot_ticks)),
+          base(0), cursor(0), usedSlots(0)
+    {
+        assert(isPowerOf2(num_slots) && num_slots >= 64);
+        assert(isPowerOf2(slot_ticks));
+    }
+
+    bool empty() const { return !usedSlots && far.empty(); }
+
+    /** The event to service next, or nullptr. */
+    Ev *
+    head() const
+    {
+        if (usedSlots)
+            return slots[cursor & mask];
+        return far.empty() ? nullptr : far.begin()->second;
+    }
+
+    void
+    insert(Ev *event)
+    {
+        Tick slot = slotOf(event);
+        if (slot < base)
+            rewind(slot);
+
+        if (!inWheel(slot)) {
+            auto it = far.lower_bound(key(event));
+            if (it != far.end() && it->first == key(event)) {
+                it->second = insertBefore(event, it->second);
+            } else {
+                event->nextBin = nullptr;
+                event->nextInBin = nullptr;
+                far.emplace_hint(it, key(event), event);
+            }
+            return;
+        }
+
+        Ev *&list = slots[slot & mask];
+        if (!list) {
+            setOccupied(slot);
+            if (!usedSlots++ || slot < cursor)
+                cursor = slot;
+        }
+        insertList(list, event);
+    }
+
+    void
+    remove(Ev *event)
+    {
+        Tick slot = slotOf(event);
+        assert(slot >= base);
+
+        if (!inWheel(slot)) {
+            auto it = far.find(key(event));
+            assert(it != far.end());
+            Ev *top = removeItem(event, it->second);
+            if (top)
+                it->second = top;
+            else
+                far.erase(it);
+            return;
+        }
+
+        Ev *&list = slots[slot & mask];
+        removeList(list, event);
+        if (!list) {
+            clearOccupied(slot);
+            if (--usedSlots && slot == cursor)
+                cursor = findOccupied(slot + 1);
+        }
+    }
+
+    /**
+     * Remove the head event and turn the wheel to its slot, as events
+     * can no longer be scheduled before it.
+     */
+    Ev *
+    pop()
+    {
+        Ev *event = head();
+        assert(event);
+        Tick slot = slotOf(event);
+        remove(event);
+
+        if (slot > base) {
+            base = slot;
+            pullFar();
+        }
+        return event;
+    }
+
+    /**
+     * Take all events out of the wheel.
+     * @return The events as the sorted bin list of a plain EventQueue.
+     */
+    Ev *
+    flatten()
+    {
+        Ev *list = nullptr;
+        Ev **link = &list;
+        forEachBin([&link](Ev *top) {
+            *link = top;
+            link = &top->nextBin;
+        });
+        *link = nullptr;
+
+        std::fill(slots.begin(), slots.end(), nullptr);
+        std::fill(occupied.begin(), occupied.end(), 0);
+        usedSlots = 0;
+        far.clear();
+        return list;
+    }
+
+    /**
+     * Replace the events of the wheel by a sorted bin list.
+     * @param list Bin list of a plain EventQueue.
+     * @param now Earliest tick events may be scheduled at from now on.
+     */
+    void
+    load(Ev *list, Tick now)
+    {
+        flatten();
+        base = now >> shift;
+        if (list)
+            base = std::min(base, slotOf(list));
+
+        while (list) {
+            Ev *next = list->nextBin;
+            placeBin(list);
+            list = next;
+        }
+    }
+
+    /** Call f on the top event of each bin in queue order. */
+    template <class F>
+    void
+    forEachBin(F f) const
+    {
+        for (Tick slot = cursor; usedSlots && inWheel(slot); ++slot) {
+            for (Ev *top = slots[slot & mask]; top; ) {
+                // f may relink the bin
+                Ev *next = top->nextBin;
+                f(top);
+                top = next;
+            }
+        }
+        for (auto &bin : far)
+            f(bin.second);
+    }
+};
+
+#endif // __SIM_EVENT_WHEEL_HH__
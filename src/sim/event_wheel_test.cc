@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2026 RIKEN
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "sim/event_wheel.hh"
+
+namespace {
+
+/** The parts of Event the wheel uses. */
+struct TestEvent
+{
+    Tick _when = 0;
+    int8_t _priority = 0;
+    bool scheduled = false;
+    TestEvent *nextBin = nullptr;
+    TestEvent *nextInBin = nullptr;
+
+    Tick when() const { return _when; }
+    int8_t priority() const { return _priority; }
+};
+
+bool
+operator<(const TestEvent &l, const TestEvent &r)
+{
+    return l.when() < r.when() ||
+        (l.when() == r.when() && l.priority() < r.priority());
+}
+
+bool
+operator<=(const TestEvent &l, const TestEvent &r)
+{
+    return l.when() < r.when() ||
+        (l.when() == r.when() && l.priority() <= r.priority());
+}
+
+bool
+operator==(const TestEvent &l, const TestEvent &r)
+{
+    return l.when() == r.when() && l.priority() == r.priority();
+}
+
+typedef EventWheel<TestEvent> Wheel;
+
+/**
+ * Reference model: the sorted bin list of EventQueue. Events are
+ * linked through their own fields, so it keeps a copy of each event.
+ */
+struct ListQueue
+{
+    struct Node
+    {
+        TestEvent *event;
+        Node *nextBin;
+        Node *nextInBin;
+    };
+
+    std::vector<Node> nodes;
+    Node *head = nullptr;
+
+    explicit ListQueue(size_t num_events) : nodes(num_events) {}
+
+    static bool
+    less(const Node *l, const Node *r)
+    {
+        return *l->event < *r->event;
+    }
+
+    static Node *
+    insertBefore(Node *node, Node *curr)
+    {
+        if (!curr || less(node, curr)) {
+            node->nextBin = curr;
+            node->nextInBin = nullptr;
+        } else {
+            node->nextBin = curr->nextBin;
+            node->nextInBin = curr;
+        }
+        return node;
+    }
+
+    static Node *
+    removeItem(Node *node, Node *top)
+    {
+        Node *curr = top;
+        Node *next = top->nextInBin;
+        if (node == top) {
+            if (!next)
+                return top->nextBin;
+            next->nextBin = top->nextBin;
+            return next;
+        }
+        while (node != next) {
+            curr = next;
+            next = next->nextInBin;
+        }
+        curr->nextInBin = next->nextInBin;
+        return top;
+    }
+
+    void
+    insert(TestEvent *event, size_t id)
+    {
+        Node *node = &nodes[id];
+        node->event = event;
+        if (!head || *event <= *head->event) {
+            head = insertBefore(node, head);
+            return;
+        }
+        Node *prev = head;
+        Node *curr = head->nextBin;
+        while (curr && less(curr, node)) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = insertBefore(node, curr);
+    }
+
+    void
+    remove(size_t id)
+    {
+        Node *node = &nodes[id];
+        if (*head->event == *node->event) {
+            head = removeItem(node, head);
+            return;
+        }
+        Node *prev = head;
+        Node *curr = head->nextBin;
+        while (curr && less(curr, node)) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+        prev->nextBin = removeItem(node, curr);
+    }
+
+    TestEvent *
+    pop()
+    {
+        Node *node = head;
+        if (node->nextInBin) {
+            node->nextInBin->nextBin = node->nextBin;
+            head = node->nextInBin;
+        } else {
+            head = node->nextBin;
+        }
+        return node->event;
+    }
+};
+
+/**
+ * Events scheduled at random times and priorities, near and far in the
+ * future, on both queues.
+ */
+struct Simulation
+{
+    std::vector<TestEvent> events;
+    Wheel wheel;
+    ListQueue ref;
+    std::mt19937 rng;
+    Tick now;
+
+    Simulation(size_t num_events, unsigned num_slots, Tick slot_ticks)
+        : events(num_events), wheel(num_slots, slot_ticks),
+          ref(num_events), rng(1), now(0)
+    {}
+
+    Tick
+    randomDelay()
+    {
+        switch (rng() % 8) {
+          case 0:
+            return 0;
+          case 1:
+            return rng() % 4 * 500;
+          case 2:
+            return rng() % 1000000;
+          case 3:
+            return rng() % 100 ? rng() % 20000000 : MaxTick - now;
+          default:
+            return rng() % 5000;
+        }
+    }
+
+    void
+    schedule(size_t id)
+    {
+        TestEvent &e = events[id];
+        e._when = now + randomDelay();
+        e._priority = int8_t(rng() % 4) - 2;
+        e.scheduled = true;
+        wheel.insert(&e);
+        ref.insert(&e, id);
+    }
+
+    void
+    deschedule(size_t id)
+    {
+        events[id].scheduled = false;
+        wheel.remove(&events[id]);
+        ref.remove(id);
+    }
+
+    TestEvent *
+    serviceOne()
+    {
+        TestEvent *e = wheel.pop();
+        TestEvent *ref_e = ref.pop();
+        EXPECT_EQ(e, ref_e);
+        e->scheduled = false;
+        now = e->when();
+        return e;
+    }
+
+    size_t
+    pending() const
+    {
+        size_t n = 0;
+        for (auto &e : events)
+            n += e.scheduled;
+        return n;
+    }
+};
+
+void
+checkOrder(unsigned num_slots, Tick slot_ticks)
+{
+    Simulation sim(512, num_slots, slot_ticks);
+    for (int i = 0; i < 300000; i++) {
+        size_t id = sim.rng() % sim.events.size();
+        if (!sim.events[id].scheduled) {
+            sim.schedule(id);
+        } else if (sim.rng() % 4 == 0) {
+            sim.deschedule(id);
+        } else {
+            // Service a few events; reschedule them as a clocked object
+            // would, at the same tick and priority for some
+            for (int n = sim.rng() % 4; n && !sim.wheel.empty(); n--) {
+                TestEvent *e = sim.serviceOne();
+                ASSERT_FALSE(::testing::Test::HasFailure()) << "step " << i;
+                if (sim.rng() % 2)
+                    sim.schedule(e - &sim.events[0]);
+            }
+        }
+        ASSERT_EQ(sim.wheel.head() != nullptr, sim.ref.head != nullptr);
+        if (sim.ref.head) {
+            ASSERT_EQ(sim.wheel.head(), sim.ref.head->event);
+        }
+    }
+
+    while (!sim.wheel.empty())
+        sim.serviceOne();
+    ASSERT_EQ(sim.ref.head, nullptr);
+}
+
+} // anonymous namespace
+
+TEST(EventWheelTest, MatchesSortedList)
+{
+    checkOrder(1024, 512);
+}
+
+TEST(EventWheelTest, MatchesSortedListSmallWheel)
+{
+    // Most events go beyond the wheel and wrap around it
+    checkOrder(64, 1);
+}
+
+TEST(EventWheelTest, FlattenAndLoad)
+{
+    Simulation sim(256, 256, 64);
+    for (size_t id = 0; id < sim.events.size(); id++)
+        sim.schedule(id);
+
+    // The flattened wheel is the sorted bin list of the reference
+    TestEvent *list = sim.wheel.flatten();
+    ASSERT_TRUE(sim.wheel.empty());
+    ListQueue::Node *ref_bin = sim.ref.head;
+    for (TestEvent *bin = list; bin; bin = bin->nextBin) {
+        ListQueue::Node *ref_e = ref_bin;
+        for (TestEvent *e = bin; e; e = e->nextInBin) {
+            ASSERT_EQ(e, ref_e->event);
+            ref_e = ref_e->nextInBin;
+        }
+        ASSERT_EQ(ref_e, nullptr);
+        ref_bin = ref_bin->nextBin;
+    }
+    ASSERT_EQ(ref_bin, nullptr);
+
+    // Load it back as if time went backwards, then schedule earlier
+    sim.wheel.load(list, 0);
+    sim.now = 0;
+    for (int i = 0; i < 64; i++)
+        sim.deschedule(i), sim.schedule(i);
+    while (!sim.wheel.empty())
+        sim.serviceOne();
+    ASSERT_FALSE(::testing::Test::HasFailure());
+}
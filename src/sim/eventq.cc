@@ -60,6 +60,9 @@ vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+static unsigned mainWheelSlots = 0;
+static Tick mainWheelSlotTicks = 1;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -67,11 +70,34 @@ getEventQueue(uint32_t index)
         numMainEventQueues++;
         mainEventQueue.push_back(
             new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.back()->setWheel(mainWheelSlots, mainWheelSlotTicks);
     }
 
     return mainEventQueue[index];
 }
 
+void
+setMainEventQueueWheel(unsigned num_slots, Tick slot_ticks)
+{
+    mainWheelSlots = num_slots;
+    mainWheelSlotTicks = slot_ticks;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->setWheel(num_slots, slot_ticks);
+}
+
+bool
+runOnEventQueue(EventQueue *eventq, const std::function<void()> &f)
+{
+    if (!inParallelMode || eventq == curEventQueue()) {
+        f();
+        return false;
+    }
+
+    eventq->schedule(new EventFunctionWrapper(f, "runOnEventQueue", true),
+                     curTick() + simQuantum);
+    return true;
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -117,6 +143,12 @@ Event::insertBefore(Event *event, Event *curr)
 void
 EventQueue::insert(Event *event)
 {
+    if (wheel) {
+        wheel->insert(event);
+        head = wheel->head();
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -176,6 +208,12 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (wheel) {
+        wheel->remove(event);
+        head = wheel->head();
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -208,7 +246,10 @@ EventQueue::serviceOne()
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (wheel) {
+        wheel->pop();
+        head = wheel->head();
+    } else if (next) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -300,16 +341,13 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        forEachBin([](Event *nextBin) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
-        }
+        });
     }
 
     cprintf("============================================================\n");
@@ -322,26 +360,29 @@ EventQueue::debugVerify() const
 
     Tick time = 0;
     short priority = 0;
+    bool ok = true;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    forEachBin([&](Event *nextBin) {
         Event *nextInBin = nextBin;
-        while (nextInBin) {
+        while (ok && nextInBin) {
             if (nextInBin->when() < time) {
                 cprintf("time goes backwards!");
                 nextInBin->dump();
-                return false;
+                ok = false;
+                return;
             } else if (nextInBin->when() == time &&
                        nextInBin->priority() < priority) {
                 cprintf("priority inverted!");
                 nextInBin->dump();
-                return false;
+                ok = false;
+                return;
             }
 
             if (map[reinterpret_cast<long>(nextInBin)]) {
                 cprintf("Node already seen");
                 nextInBin->dump();
-                return false;
+                ok = false;
+                return;
             }
             map[reinterpret_cast<long>(nextInBin)] = true;
 
@@ -350,21 +391,36 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
+    });
 
-        nextBin = nextBin->nextBin;
-    }
-
-    return true;
+    return ok;
 }
 
 Event*
 EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
+    if (wheel) {
+        // Hand out and take in events as a plain sorted bin list
+        t = wheel->flatten();
+        wheel->load(s, getCurTick());
+        s = wheel->head();
+    }
     head = s;
     return t;
 }
 
+void
+EventQueue::setWheel(unsigned num_slots, Tick slot_ticks)
+{
+    Event *list = replaceHead(nullptr);
+    if (num_slots)
+        wheel.reset(new EventWheel<Event>(num_slots, slot_ticks));
+    else
+        wheel.reset();
+    replaceHead(list);
+}
+
 void
 dumpMainQueue()
 {
@@ -414,28 +470,40 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), asyncHead(nullptr)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    Event *top = asyncHead.load(std::memory_order_relaxed);
+    do {
+        event->nextInBin = top;
+    } while (!asyncHead.compare_exchange_weak(top, event,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    // Take all pending events at once; the stack returns them newest
+    // first, so reverse it to insert them in the order they arrived.
+    Event *event = asyncHead.exchange(nullptr, std::memory_order_acquire);
+    Event *pending = nullptr;
+    while (event) {
+        Event *next = event->nextInBin;
+        event->nextInBin = pending;
+        pending = event;
+        event = next;
     }
 
-    async_queue_mutex.unlock();
+    while (pending) {
+        Event *next = pending->nextInBin;
+        insert(pending);
+        pending = next;
+    }
 }
@@ -39,6 +39,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -50,6 +51,7 @@
 #include "base/flags.hh"
 #include "base/types.hh"
 #include "debug/Event.hh"
+#include "sim/event_wheel.hh"
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
@@ -76,6 +78,10 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Use a timing wheel for all main event queues, including those
+//! created later. See EventQueue::setWheel().
+void setMainEventQueueWheel(unsigned num_slots, Tick slot_ticks);
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -85,6 +91,24 @@ EventQueue *getEventQueue(uint32_t index);
 inline EventQueue *curEventQueue() { return _curEventQueue; }
 inline void curEventQueue(EventQueue *q) { _curEventQueue = q; }
 
+/**
+ * Lock a mutex that protects state shared between event queues. The
+ * mutex is only taken while the queues are simulated in parallel so
+ * that single-threaded simulations do not pay for it.
+ *
+ * @param m Mutex protecting the shared state.
+ * @return A lock that owns m in parallel mode.
+ */
+template <class Mutex>
+std::unique_lock<Mutex>
+parallelLock(Mutex &m)
+{
+    std::unique_lock<Mutex> lock(m, std::defer_lock);
+    if (inParallelMode)
+        lock.lock();
+    return lock;
+}
+
 /**
  * Common base class for Event and GlobalEvent, so they can share flag
  * and priority definitions and accessor functions.  This class should
@@ -186,6 +210,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    template <class> friend class EventWheel;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -479,7 +504,7 @@ operator!=(const Event &l, const Event &r)
  * schedule() method with the 'global' parameter set to true. Unlike
  * the previous queue migration strategy, this strategy is fully
  * deterministic. This causes the event to be inserted in a separate
- * queue of asynchronous events (async_queue), which is merged main
+ * queue of asynchronous events (asyncHead), which is merged main
  * event queue at the end of each simulation quantum (by calling the
  * handleAsyncInsertions() method). Note that this implies that such
  * events must happen at least one simulation quantum into the future,
@@ -493,11 +518,19 @@ class EventQueue
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    std::mutex async_queue_mutex;
+    /**
+     * Timing wheel holding the events when enabled by setWheel(). The
+     * head pointer then caches the first event of the wheel.
+     */
+    std::unique_ptr<EventWheel<Event>> wheel;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    /**
+     * Events added by other threads to this event queue. This is a
+     * lock-free stack linked through Event::nextInBin: events waiting
+     * here are not in the main queue yet, so the link is free and
+     * adding an event does not allocate.
+     */
+    std::atomic<Event *> asyncHead;
 
     /**
      * Lock protecting event handling.
@@ -526,11 +559,25 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
-    //! Function for adding events to the async queue. The added events
-    //! are added to main event queue later. Threads, other than the
+    //! Function for pushing events on the lock-free asyncHead stack,
+    //! linked through Event::nextInBin. The added events are moved to
+    //! the main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
     void asyncInsert(Event *event);
 
+    /** Call f on the top event of each bin, in queue order. */
+    template <class F>
+    void
+    forEachBin(F f) const
+    {
+        if (wheel) {
+            wheel->forEachBin(f);
+            return;
+        }
+        for (Event *bin = head; bin; bin = bin->nextBin)
+            f(bin);
+    }
+
     EventQueue(const EventQueue &);
 
   public:
@@ -619,6 +666,16 @@ class EventQueue
     //! the owning thread.
     void reschedule(Event *event, Tick when, bool always = false);
 
+    /**
+     * Switch between the sorted bin list and the timing wheel backends.
+     * Pending events are kept and serviced in the same order either way.
+     *
+     * @param num_slots Number of slots of the wheel, a power of two of
+     * at least 64, or zero for the sorted bin list.
+     * @param slot_ticks Ticks per slot, a power of two.
+     */
+    void setWheel(unsigned num_slots, Tick slot_ticks);
+
     Tick nextTick() const { return head->when(); }
     void setCurTick(Tick newVal) { _curTick = newVal; }
     Tick getCurTick() const { return _curTick; }
@@ -654,7 +711,8 @@ class EventQueue
 
     bool debugVerify() const;
 
-    //! Function for moving events from the async_queue to the main queue.
+    //! Function for moving the events pushed on the asyncHead stack by
+    //! asyncInsert() to the main queue, in the order they were added.
     void handleAsyncInsertions();
 
     /**
@@ -837,4 +895,16 @@ class EventFunctionWrapper : public Event
     const char *description() const { return "EventFunctionWrapped"; }
 };
 
+/**
+ * Run a function in the context of an event queue. Calls coming from
+ * another event queue while simulating in parallel are deferred by
+ * one simulation quantum and executed as an event on the target
+ * queue; all other calls run the function right away.
+ *
+ * @param eventq Event queue owning the state touched by the function.
+ * @param f Function to run.
+ * @return true if the call was deferred.
+ */
+bool runOnEventQueue(EventQueue *eventq, const std::function<void()> &f);
+
 #endif // __SIM_EVENTQ_HH__
@@ -52,6 +52,7 @@
 #include <array>
 #include <csignal>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -65,6 +66,7 @@
 #include "mem/se_translating_port_proxy.hh"
 #include "params/Process.hh"
 #include "sim/emul_driver.hh"
+#include "sim/eventq.hh"
 #include "sim/fd_array.hh"
 #include "sim/fd_entry.hh"
 #include "sim/syscall_desc.hh"
@@ -325,9 +327,18 @@ Process::replicatePage(Addr vaddr, Addr new_paddr, ThreadContext *old_tc,
     delete[] buf_p;
 }
 
+/**
+ * Serialises syscall emulation and stack growth when event queues are
+ * simulated in parallel. Both touch state shared by all simulated
+ * threads, e.g., the physical page allocator and the futex map.
+ */
+static std::recursive_mutex emulationMutex;
+
 bool
 Process::fixupStackFault(Addr vaddr)
 {
+    auto lock = parallelLock(emulationMutex);
+
     Addr stack_min = memState->getStackMin();
     Addr stack_base = memState->getStackBase();
     Addr max_stack_size = memState->getMaxStackSize();
@@ -406,6 +417,8 @@ Process::map(Addr vaddr, Addr paddr, int size, bool cacheable)
 void
 Process::syscall(int64_t callnum, ThreadContext *tc, Fault *fault)
 {
+    auto lock = parallelLock(emulationMutex);
+
     numSyscalls++;
 
     SyscallDesc *desc = getDesc(callnum);
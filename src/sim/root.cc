@@ -31,6 +31,7 @@
  *          Gabe Black
  */
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "config/the_isa.hh"
@@ -116,6 +117,16 @@ Root::Root(RootParams *p)
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+
+    if (p->event_queue_wheel_slots) {
+        fatal_if(!isPowerOf2(p->event_queue_wheel_slots) ||
+                 p->event_queue_wheel_slots < 64,
+                 "event_queue_wheel_slots must be a power of two >= 64\n");
+        fatal_if(!isPowerOf2(p->event_queue_wheel_resolution),
+                 "event_queue_wheel_resolution must be a power of two\n");
+    }
+    setMainEventQueueWheel(p->event_queue_wheel_slots,
+                           p->event_queue_wheel_resolution);
 }
 
 void
@@ -45,9 +45,6 @@
 #include "sim/sim_exit.hh"
 #include "sim/stat_control.hh"
 
-//! Mutex for handling async events.
-std::mutex asyncEventMutex;
-
 //! Global barrier for synchronizing threads entering/exiting the
 //! simulation loop.
 Barrier *threadBarrier;
@@ -159,16 +156,7 @@ simulate(Tick num_cycles)
 static bool
 testAndClearAsyncEvent()
 {
-    bool was_set = false;
-    asyncEventMutex.lock();
-
-    if (async_event) {
-        was_set = true;
-        async_event = false;
-    }
-
-    asyncEventMutex.unlock();
-    return was_set;
+    return async_event.exchange(false);
 }
 
 /**
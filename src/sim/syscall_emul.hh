@@ -1782,6 +1782,10 @@ clock_gettimeFunc(SyscallDesc *desc, int num, Process *p, ThreadContext *tc)
     DPRINTF(FreeResource, "get_clocktime\n");
     DPRINTF(GetTimer, "get_clocktime\n");
 
+    // Let the system turn this call into a region-of-interest boundary
+    // so kernel-only stats don't need a second, tick-scripted run.
+    tc->getSystemPtr()->roiMarker(tc);
+
     return 0;
 }
 
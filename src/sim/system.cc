@@ -48,6 +48,7 @@
 #include "sim/system.hh"
 
 #include <algorithm>
+#include <set>
 
 #include "arch/remote_gdb.hh"
 #include "arch/utility.hh"
@@ -70,6 +71,9 @@
 #include "sim/byteswap.hh"
 #include "sim/debug.hh"
 #include "sim/full_system.hh"
+#include "sim/process.hh"
+#include "sim/sim_exit.hh"
+#include "sim/stat_control.hh"
 
 /**
  * To avoid linking errors with LTO, only include the header if we
@@ -102,12 +106,20 @@ System::System(Params *p)
 #else
       kvmVM(nullptr),
 #endif
-      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve),
+      physmem(name() + ".physmem", p->memories, p->mmap_using_noreserve,
+              p->sparse_checkpoint, p->sparse_checkpoint_compress,
+              p->sparse_checkpoint_max_chain, p->checkpoint_threads),
       memoryMode(p->mem_mode),
       _cacheLineSize(p->cache_line_size),
       workItemsBegin(0),
       workItemsEnd(0),
       numWorkIds(p->num_work_ids),
+      roiPolicy(p->roi_policy),
+      roiBeginCount(p->roi_begin_count),
+      roiEndCount(p->roi_end_count),
+      roiContextId(p->roi_context_id),
+      roiMarkers(0),
+      exitOnRoi(p->exit_on_roi),
       thermalModel(p->thermal_model),
       _params(p),
       totalNumInsts(0),
@@ -418,10 +430,37 @@ System::serialize(CheckpointOut &cp) const
     if (FullSystem)
         kernelSymtab->serialize("kernel_symtab", cp);
     SERIALIZE_SCALAR(pagePtr);
+    SERIALIZE_SCALAR(roiMarkers);
     serializeSymtab(cp);
 
     // also serialize the memories in the system
-    physmem.serializeSection(cp, "physmem");
+    ScopedCheckpointSection sec(cp, "physmem");
+    // only sparse images are restricted to the touched pages
+    if (params()->sparse_checkpoint)
+        physmem.serializeLive(cp, touchedPhysPages(), PageBytes);
+    else
+        physmem.serialize(cp);
+}
+
+vector<Addr>
+System::touchedPhysPages() const
+{
+    vector<Addr> pages;
+    if (FullSystem)
+        return pages;
+
+    set<Process *> processes;
+    for (auto tc : threadContexts) {
+        Process *p = tc->getProcessPtr();
+        if (!p || !processes.insert(p).second)
+            continue;
+
+        vector<pair<Addr, Addr>> mappings;
+        p->pTable->getMappings(&mappings);
+        for (const auto &m : mappings)
+            pages.push_back(m.second);
+    }
+    return pages;
 }
 
 
@@ -431,6 +470,7 @@ System::unserialize(CheckpointIn &cp)
     if (FullSystem)
         kernelSymtab->unserialize("kernel_symtab", cp);
     UNSERIALIZE_SCALAR(pagePtr);
+    UNSERIALIZE_OPT_SCALAR(roiMarkers);
     unserializeSymtab(cp);
 
     // also unserialize the memories in the system
@@ -470,6 +510,49 @@ System::workItemEnd(uint32_t tid, uint32_t workid)
     lastWorkItemStarted.erase(p);
 }
 
+bool
+System::roiMarker(ThreadContext *tc)
+{
+    bool boundary = false;
+
+    switch (roiPolicy) {
+      case Enums::none:
+        // without a policy, the first call opens the region of interest
+        if (exitOnRoi) {
+            exitOnRoi = false;
+            exitSimLoop("roi marker");
+        }
+        return false;
+      case Enums::pairs:
+        ++roiMarkers;
+        boundary = true;
+        break;
+      case Enums::per_thread:
+        if (tc->contextId() != roiContextId)
+            return false;
+        M5_FALLTHROUGH;
+      case Enums::nth:
+        ++roiMarkers;
+        boundary = roiMarkers == roiBeginCount || roiMarkers == roiEndCount;
+        break;
+      default:
+        panic("Unknown ROI policy %d\n", roiPolicy);
+    }
+
+    if (boundary) {
+        DPRINTF(WorkItems, "ROI marker %d from context %d, dumping stats\n",
+                roiMarkers, tc->contextId());
+        Stats::schedStatEvent(true, true, curTick(), 0);
+
+        if (exitOnRoi) {
+            exitOnRoi = false;
+            exitSimLoop("roi marker");
+        }
+    }
+
+    return boundary;
+}
+
 void
 System::printSystems()
 {
@@ -57,6 +57,7 @@
 #include "base/statistics.hh"
 #include "config/the_isa.hh"
 #include "enums/MemoryMode.hh"
+#include "enums/RoiPolicy.hh"
 #include "mem/mem_object.hh"
 #include "mem/physical.hh"
 #include "mem/port.hh"
@@ -315,6 +316,17 @@ class System : public MemObject
     uint32_t numWorkIds;
     std::vector<bool> activeCpus;
 
+    const Enums::RoiPolicy roiPolicy;
+    const Counter roiBeginCount;
+    const Counter roiEndCount;
+    const ContextID roiContextId;
+
+    /** Number of clock_gettime() calls counted by the ROI policy. */
+    Counter roiMarkers;
+
+    /** Exit the simulation loop at the next ROI boundary. */
+    bool exitOnRoi;
+
     /** This array is a per-system list of all devices capable of issuing a
      * memory system request and an associated string for each master id.
      * It's used to uniquely id any master in the system by name for things
@@ -393,6 +405,16 @@ class System : public MemObject
 
     void workItemEnd(uint32_t tid, uint32_t workid);
 
+    /**
+     * Called by the clock_gettime() syscall emulation. Depending on the
+     * configured RoiPolicy this dumps and resets the statistics so that
+     * a single run produces region-of-interest stats.
+     *
+     * @param tc Thread context that made the call.
+     * @return true if the call was a region boundary.
+     */
+    bool roiMarker(ThreadContext *tc);
+
     /**
      * Fix up an address used to match PCs for hooking simulator
      * events on to target function executions.  See comment in
@@ -532,6 +554,13 @@ class System : public MemObject
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
+    /**
+     * Physical pages that the simulated software can have touched,
+     * i.e. those mapped by the page tables of the SE-mode processes.
+     * Empty in full system mode, where any page may be in use.
+     */
+    std::vector<Addr> touchedPhysPages() const;
+
     void drainResume() override;
 
   public:
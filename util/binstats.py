@@ -0,0 +1,152 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""Reader for columnar binary statistics (binary://stats.bin).
+
+The file holds the stat names once, followed by one record per stats
+dump with the values that changed since the previous dump (see
+src/base/stats/binary.hh). This module rebuilds one time series per
+stat and can be used as a library:
+
+    stats = BinaryStats("m5out/stats.bin")
+    stats.ticks                          # tick of every dump
+    stats.series("system.cpu.ipc")       # value at every dump
+    stats.dump(-1)                       # {name: value} of the last dump
+
+or from the command line:
+
+    binstats.py m5out/stats.bin                # last dump, as in stats.txt
+    binstats.py m5out/stats.bin -d 3           # fourth dump
+    binstats.py m5out/stats.bin -s 'dcache.*miss' # CSV time series
+"""
+
+from __future__ import print_function
+
+import argparse
+import re
+import struct
+import sys
+from array import array
+
+MAGIC = b"gem5stat"
+VERSION = 1
+
+class BinaryStats(object):
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+
+        if data[:len(MAGIC)] != MAGIC:
+            raise ValueError("%s is not a binary stats file" % path)
+        pos = len(MAGIC)
+        version, = struct.unpack_from("<I", data, pos)
+        if version != VERSION:
+            raise ValueError("Unsupported binary stats version %d" % version)
+        pos += 4
+
+        if data[pos:pos + 1] != b"S":
+            raise ValueError("Missing schema in %s" % path)
+        count, = struct.unpack_from("<I", data, pos + 1)
+        pos += 5
+        self.names = []
+        for i in range(count):
+            length, = struct.unpack_from("<I", data, pos)
+            pos += 4
+            self.names.append(data[pos:pos + length].decode())
+            pos += length
+        self.index = dict((name, i) for i, name in enumerate(self.names))
+
+        self.ticks = []
+        self.columns = [ array("d") for name in self.names ]
+        row = [ float("nan") ] * count
+        mask_bytes = (count + 7) // 8
+        while pos < len(data):
+            if data[pos:pos + 1] != b"D":
+                raise ValueError("Corrupt dump record at offset %d" % pos)
+            tick, = struct.unpack_from("<Q", data, pos + 1)
+            pos += 9
+            mask = bytearray(data[pos:pos + mask_bytes])
+            pos += mask_bytes
+
+            changed = [ i for i in range(count)
+                        if mask[i >> 3] & (1 << (i & 7)) ]
+            values = struct.unpack_from("<%dd" % len(changed), data, pos)
+            pos += 8 * len(changed)
+            for i, value in zip(changed, values):
+                row[i] = value
+
+            self.ticks.append(tick)
+            for column, value in zip(self.columns, row):
+                column.append(value)
+
+    def series(self, name):
+        """Values of a stat at every dump"""
+        return self.columns[self.index[name]]
+
+    def dump(self, n):
+        """All values of the n-th dump as a dict"""
+        return dict((name, column[n])
+                    for name, column in zip(self.names, self.columns))
+
+    def match(self, pattern):
+        """Names of the stats matching a regular expression"""
+        r = re.compile(pattern)
+        return [ name for name in self.names if r.search(name) ]
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print statistics from a binary stats file")
+    parser.add_argument("stats", help="binary stats file")
+    parser.add_argument("-d", "--dump", type=int, default=-1,
+                        help="dump to print (default: the last one)")
+    parser.add_argument("-s", "--series", action="append", default=[],
+                        metavar="REGEX",
+                        help="print the time series of the matching stats "
+                        "as CSV")
+    args = parser.parse_args()
+
+    stats = BinaryStats(args.stats)
+    if not stats.ticks:
+        return
+
+    if args.series:
+        names = []
+        for pattern in args.series:
+            names += [ n for n in stats.match(pattern) if n not in names ]
+        print(",".join(["tick"] + names))
+        columns = [ stats.series(name) for name in names ]
+        for i, tick in enumerate(stats.ticks):
+            print(",".join([str(tick)] +
+                           [ repr(column[i]) for column in columns ]))
+    else:
+        for name in stats.names:
+            print("%-40s %s" % (name, repr(stats.series(name)[args.dump])))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,64 @@
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""Convert a binary pipeline trace (--pipe-trace) for viewing.
+
+The converter is part of gem5, so this script runs in gem5 rather than
+a plain Python interpreter:
+
+    build/ARM/gem5.opt -q util/convert_pipe_trace.py \\
+        m5out/pipetrace.system.cpu.bin -o trace.kanata
+
+The default Konata log opens directly in Konata. --format o3pipeview
+writes the text of the O3PipeView debug flag instead, for
+util/o3-pipeview.py.
+"""
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+from m5 import trace
+from m5.util import fatal
+
+parser = argparse.ArgumentParser(
+    description="Convert a binary pipeline trace")
+parser.add_argument("trace", help="binary pipeline trace file")
+parser.add_argument("-o", "--output", default="",
+                    help="file to write (default: standard output)")
+parser.add_argument("--format", choices=["konata", "o3pipeview"],
+                    default="konata", help="output format")
+parser.add_argument("--reorder-window", type=int, default=65536,
+                    help="instructions buffered to sort the Konata log by "
+                    "fetch time")
+args = parser.parse_args()
+
+if not trace.convertPipeTrace(args.trace, args.output, args.format,
+                              args.reorder_window):
+    fatal("%s is not a complete pipeline trace" % args.trace)
+sys.exit(0)
@@ -0,0 +1,67 @@
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Render a binary debug trace (--debug-file=binary://FILE) as text.
+
+The trace is decoded with the same formatting code as the text trace,
+so this script runs in gem5 rather than a plain Python interpreter:
+
+    build/ARM/gem5.opt -q util/decode_debug_trace.py m5out/trace.bin \\
+        -o trace.txt --start 1000000 --end 2000000 \\
+        --names 'system.cpu.dcache:system.l2'
+
+--names takes object names with the syntax of --debug-ignore. Records
+of different host threads (--cmg-parallel) appear in the order they
+were written; --sort merges them by tick.
+"""
+
+from __future__ import print_function
+
+import argparse
+import sys
+
+from m5 import trace
+from m5.util import fatal
+
+parser = argparse.ArgumentParser(
+    description="Render a binary debug trace as text")
+parser.add_argument("trace", help="binary trace file")
+parser.add_argument("-o", "--output", default="",
+                    help="text file to write (default: standard output)")
+parser.add_argument("--start", type=int, default=0,
+                    help="first tick to render")
+parser.add_argument("--end", type=int, default=2**64 - 1,
+                    help="last tick to render")
+parser.add_argument("--names", default="",
+                    help="only render these objects (colon separated)")
+parser.add_argument("--sort", action="store_true",
+                    help="merge the records of all threads by tick")
+args = parser.parse_args()
+
+if not trace.decodeBinary(args.trace, args.output, args.start, args.end,
+                          args.names, args.sort):
+    fatal("%s is not a complete binary debug trace" % args.trace)
+sys.exit(0)
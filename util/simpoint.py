@@ -0,0 +1,455 @@
+#!/usr/bin/env python2
+
+# Copyright (c) 2026 RIKEN
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""SimPoint analysis and replay without the external SimPoint tool.
+
+The "cluster" command reads the basic block vectors written by
+--simpoint-profile and picks one representative interval per phase. It
+uses k-means on randomly projected vectors and chooses k by the
+Bayesian information criterion, as SimPoint 3.2 does. It writes the
+"simpoints" and "weights" files that --take-simpoint-checkpoints reads.
+
+The "merge" command combines the stats.txt of the restored SimPoints
+into one stats file. Every stat is the weighted mean of its value in
+the last dump of each run, that is the estimate for one interval.
+
+The "run" command does all of it for one workload:
+
+    simpoint.py run -d sp -j 32 --interval 10000000 --warmup 1000000 \\
+        --detailed="--cpu-type=O3_ARM_PostK_3 --caches --l2cache" \\
+        -- configs/example/se.py -c a.out -o "..."
+
+  1. sp/profile:  profile the basic blocks with the atomic CPU,
+  2. sp/simpoints, sp/weights: cluster the intervals,
+  3. sp/cpt:      take every checkpoint in one fast-forward pass,
+  4. sp/run.NN:   restore the checkpoints with the detailed options,
+                  at most -j simulator processes at a time,
+  5. sp/stats.txt: the weighted statistics.
+"""
+
+from __future__ import division, print_function
+
+import argparse
+import gzip
+import math
+import os
+import random
+import re
+import shlex
+import subprocess
+import sys
+import time
+
+def read_bbv(path):
+    """Read a basic block vector file, one {bb: count} dict per interval"""
+    opener = gzip.open if path.endswith(".gz") else open
+    vectors = []
+    with opener(path, "rt") as f:
+        for line in f:
+            if not line.startswith("T"):
+                continue
+            vector = {}
+            for field in line[1:].split():
+                _, bb, count = field.split(":")
+                vector[int(bb)] = int(count)
+            vectors.append(vector)
+    return vectors
+
+def project(vectors, dim, seed):
+    """Normalize every vector and project it to dim dimensions"""
+    rng = random.Random(seed)
+    basis = {}
+    points = []
+    for vector in vectors:
+        total = sum(vector.values()) or 1
+        point = [0.0] * dim
+        for bb in sorted(vector):
+            row = basis.get(bb)
+            if row is None:
+                row = [ rng.uniform(-1.0, 1.0) for _ in range(dim) ]
+                basis[bb] = row
+            w = vector[bb] / total
+            for d in range(dim):
+                point[d] += w * row[d]
+        points.append(point)
+    return points
+
+def distance2(a, b):
+    return sum((x - y) * (x - y) for x, y in zip(a, b))
+
+def nearest(point, centroids):
+    best, best_d = 0, None
+    for c, centroid in enumerate(centroids):
+        d = distance2(point, centroid)
+        if best_d is None or d < best_d:
+            best, best_d = c, d
+    return best, best_d
+
+def kmeans(points, k, rng, iterations):
+    """k-means with k-means++ seeding, returns (centroids, distortion)"""
+    centroids = [ list(rng.choice(points)) ]
+    dists = [ distance2(p, centroids[0]) for p in points ]
+    while len(centroids) < k:
+        total = sum(dists)
+        if total == 0:
+            break
+        r = rng.uniform(0, total)
+        for i, d in enumerate(dists):
+            r -= d
+            if r <= 0:
+                break
+        centroids.append(list(points[i]))
+        dists = [ min(d, distance2(p, centroids[-1]))
+                  for p, d in zip(points, dists) ]
+
+    dim = len(points[0])
+    labels = None
+    for _ in range(iterations):
+        new_labels = [ nearest(p, centroids)[0] for p in points ]
+        if new_labels == labels:
+            break
+        labels = new_labels
+        sums = [ [0.0] * dim for _ in centroids ]
+        counts = [0] * len(centroids)
+        for p, c in zip(points, labels):
+            counts[c] += 1
+            s = sums[c]
+            for d in range(dim):
+                s[d] += p[d]
+        for c, n in enumerate(counts):
+            if n:
+                centroids[c] = [ x / n for x in sums[c] ]
+
+    distortion = sum(nearest(p, centroids)[1] for p in points)
+    return centroids, distortion
+
+def bic(points, centroids):
+    """BIC of a spherical Gaussian mixture (Pelleg and Moore, X-means)"""
+    r, dim, k = len(points), len(points[0]), len(centroids)
+    sizes = [0] * k
+    sse = 0.0
+    for p in points:
+        c, d = nearest(p, centroids)
+        sizes[c] += 1
+        sse += d
+    if r <= k:
+        return float("-inf")
+    variance = max(sse / (dim * (r - k)), 1e-300)
+    loglike = 0.0
+    for n in sizes:
+        if n == 0:
+            continue
+        loglike += (n * math.log(n) - n * math.log(r)
+                    - n * dim / 2 * math.log(2 * math.pi * variance)
+                    - (n - k) / 2)
+    params = (k - 1) + dim * k + 1
+    return loglike - params / 2 * math.log(r)
+
+def cluster(points, max_k, seeds, iterations, sample, threshold, seed):
+    """Pick k and cluster, returns the centroids
+
+    The smallest k whose BIC reaches threshold of the way from the BIC
+    of k=1 to that of max_k is found by binary search, like the
+    "-k search" mode of SimPoint.
+    """
+    rng = random.Random(seed)
+    train = points
+    if len(points) > sample:
+        train = rng.sample(points, sample)
+    max_k = max(1, min(max_k, len(train)))
+
+    results = {}
+    def fit(k):
+        if k not in results:
+            best = None
+            for _ in range(seeds):
+                centroids, distortion = kmeans(train, k, rng, iterations)
+                if best is None or distortion < best[1]:
+                    best = (centroids, distortion)
+            results[k] = (best[0], bic(train, best[0]))
+            print("k=%d BIC=%g" % (k, results[k][1]))
+        return results[k]
+
+    low, high = 1, max_k
+    target = fit(low)[1] + threshold * (fit(high)[1] - fit(low)[1])
+    if fit(low)[1] >= target:
+        high = low
+    while high - low > 1:
+        mid = (low + high) // 2
+        if fit(mid)[1] >= target:
+            high = mid
+        else:
+            low = mid
+    return fit(high)[0]
+
+def pick_simpoints(points, centroids):
+    """Returns (interval, cluster, weight) of each non-empty cluster"""
+    best = {}
+    sizes = {}
+    for i, p in enumerate(points):
+        c, d = nearest(p, centroids)
+        sizes[c] = sizes.get(c, 0) + 1
+        if c not in best or d < best[c][1]:
+            best[c] = (i, d)
+    return [ (best[c][0], c, sizes[c] / len(points))
+             for c in sorted(best) ]
+
+def write_simpoints(simpoints, simpoint_file, weight_file):
+    with open(simpoint_file, "w") as sf, open(weight_file, "w") as wf:
+        for interval, c, weight in simpoints:
+            sf.write("%d %d\n" % (interval, c))
+            wf.write("%.6f %d\n" % (weight, c))
+
+# Same pattern and order as the checkpoint lookup in
+# configs/common/Simulation.py, so index n is "-r n+1".
+CPT_RE = re.compile(r'cpt\.simpoint_(\d+)_inst_(\d+)'
+                    r'_weight_([\d\.e\-]+)_interval_(\d+)_warmup_(\d+)')
+
+def find_checkpoints(cptdir):
+    """Returns (directory, weight) of every SimPoint checkpoint"""
+    cpts = sorted(d for d in os.listdir(cptdir) if CPT_RE.match(d))
+    return [ (d, float(CPT_RE.match(d).group(3))) for d in cpts ]
+
+def read_last_dump(path):
+    """Stats of the last dump in a stats.txt, as [(name, value, desc)]"""
+    dump = []
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- Begin"):
+                dump = []
+                continue
+            if line.startswith("----------") or not line.strip():
+                continue
+            desc = ""
+            if "#" in line:
+                line, desc = line.split("#", 1)
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            try:
+                value = float(fields[1])
+            except ValueError:
+                continue
+            dump.append((fields[0], value, desc.strip()))
+    return dump
+
+def merge_stats(runs, out):
+    """Write the weighted mean of every stat of runs [(stats, weight)]"""
+    names = []
+    sums = {}
+    weights = {}
+    descs = {}
+    for path, weight in runs:
+        for name, value, desc in read_last_dump(path):
+            if name not in sums:
+                names.append(name)
+                sums[name] = 0.0
+                weights[name] = 0.0
+                descs[name] = desc
+            if math.isnan(value) or math.isinf(value):
+                continue
+            sums[name] += weight * value
+            weights[name] += weight
+
+    with open(out, "w") as f:
+        f.write("---------- Begin Simulation Statistics ----------\n")
+        for name in names:
+            if weights[name]:
+                value = "%.6f" % (sums[name] / weights[name])
+            else:
+                value = "nan"
+            f.write("%-60s %20s # %s\n" % (name, value, descs[name]))
+        f.write("---------- End Simulation Statistics   ----------\n")
+
+def run_jobs(jobs, max_jobs):
+    """Run [(command, log file)] with at most max_jobs at a time"""
+    pending = list(jobs)
+    running = []
+    failed = []
+    while pending or running:
+        while pending and len(running) < max_jobs:
+            cmd, log = pending.pop(0)
+            print(" ".join(cmd))
+            running.append((cmd, subprocess.Popen(cmd, stdout=open(log, "w"),
+                                                  stderr=subprocess.STDOUT)))
+        still = []
+        for cmd, proc in running:
+            if proc.poll() is None:
+                still.append((cmd, proc))
+            elif proc.returncode != 0:
+                failed.append(cmd)
+        running = still
+        if running:
+            time.sleep(1)
+    return failed
+
+def run_step(cmd, log):
+    if run_jobs([(cmd, log)], 1):
+        sys.exit("%s failed, see %s" % (cmd[0], log))
+
+def do_cluster(args, simpoint_file, weight_file):
+    vectors = read_bbv(args.bbv)
+    if not vectors:
+        sys.exit("no intervals in %s" % args.bbv)
+    points = project(vectors, args.dim, args.seed)
+    centroids = cluster(points, args.max_k, args.init_seeds,
+                        args.iterations, args.sample_size, args.bic_threshold,
+                        args.seed)
+    simpoints = pick_simpoints(points, centroids)
+    write_simpoints(simpoints, simpoint_file, weight_file)
+    print("%d intervals, %d simpoints" % (len(points), len(simpoints)))
+
+def do_run(args):
+    if not args.config:
+        sys.exit("missing the configuration script and its options")
+    outdir = os.path.abspath(args.outdir)
+    if not os.path.isdir(outdir):
+        os.makedirs(outdir)
+    gem5 = [ args.gem5 ] + shlex.split(args.gem5_options)
+    workload = args.config
+    atomic = [ "--cpu-type=AtomicSimpleCPU" ]
+
+    profile_dir = os.path.join(outdir, "profile")
+    args.bbv = os.path.join(profile_dir, "simpoint.bb.gz")
+    if not os.path.exists(args.bbv):
+        run_step(gem5 + [ "-d", profile_dir ] + workload + atomic +
+                 [ "--fastmem", "--simpoint-profile",
+                   "--simpoint-interval=%d" % args.interval ],
+                 os.path.join(outdir, "profile.log"))
+
+    simpoint_file = os.path.join(outdir, "simpoints")
+    weight_file = os.path.join(outdir, "weights")
+    do_cluster(args, simpoint_file, weight_file)
+
+    cptdir = os.path.join(outdir, "cpt")
+    run_step(gem5 + [ "-d", cptdir ] + workload + atomic +
+             [ "--take-simpoint-checkpoints=%s,%s,%d,%d" %
+               (simpoint_file, weight_file, args.interval, args.warmup) ],
+             os.path.join(outdir, "cpt.log"))
+
+    cpts = find_checkpoints(cptdir)
+    jobs = []
+    runs = []
+    for n, (cpt, weight) in enumerate(cpts):
+        run_dir = os.path.join(outdir, "run.%02d" % n)
+        jobs.append((gem5 + [ "-d", run_dir ] + workload +
+                     shlex.split(args.detailed) +
+                     [ "--restore-simpoint-checkpoint", "-r", str(n + 1),
+                       "--checkpoint-dir", cptdir ],
+                     os.path.join(outdir, "run.%02d.log" % n)))
+        runs.append((os.path.join(run_dir, "stats.txt"), weight))
+    failed = run_jobs(jobs, args.jobs)
+    if failed:
+        sys.exit("%d of %d restores failed" % (len(failed), len(jobs)))
+
+    merge_stats(runs, os.path.join(outdir, "stats.txt"))
+    print("Weighted stats of %d simpoints in %s" %
+          (len(runs), os.path.join(outdir, "stats.txt")))
+
+def add_cluster_options(parser):
+    parser.add_argument("--max-k", type=int, default=30,
+                        help="largest number of clusters (default: 30)")
+    parser.add_argument("--dim", type=int, default=15,
+                        help="dimensions of the random projection "
+                        "(default: 15)")
+    parser.add_argument("--init-seeds", type=int, default=5,
+                        help="k-means runs per k, the best is kept "
+                        "(default: 5)")
+    parser.add_argument("--iterations", type=int, default=100,
+                        help="k-means iteration limit (default: 100)")
+    parser.add_argument("--sample-size", type=int, default=2000,
+                        help="intervals used to fit the clusters, all are "
+                        "assigned afterwards (default: 2000)")
+    parser.add_argument("--bic-threshold", type=float, default=0.9,
+                        help="fraction of the BIC range the chosen k must "
+                        "reach (default: 0.9)")
+    parser.add_argument("--seed", type=int, default=493575226,
+                        help="random seed")
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Cluster SimPoint BBVs, replay checkpoints in parallel "
+        "and merge their statistics")
+    sub = parser.add_subparsers(dest="command")
+
+    p = sub.add_parser("cluster", help="pick simpoints from a BBV file")
+    p.add_argument("bbv", help="simpoint.bb.gz from --simpoint-profile")
+    p.add_argument("-o", "--outdir", default=".",
+                   help="where to write simpoints and weights")
+    add_cluster_options(p)
+
+    p = sub.add_parser("merge", help="weight the stats of restored runs")
+    p.add_argument("cptdir", help="checkpoint directory of the runs")
+    p.add_argument("stats", nargs="+",
+                   help="stats.txt of each run, in checkpoint order")
+    p.add_argument("-o", "--output", default="stats.txt",
+                   help="merged stats file (default: stats.txt)")
+
+    p = sub.add_parser("run", help="profile, cluster, checkpoint, restore "
+                       "and merge")
+    p.add_argument("-d", "--outdir", default="simpoint",
+                   help="output directory (default: simpoint)")
+    p.add_argument("-j", "--jobs", type=int, default=1,
+                   help="simulator processes run in parallel (default: 1)")
+    p.add_argument("--gem5", default="build/ARM/gem5.opt",
+                   help="simulator binary (default: build/ARM/gem5.opt)")
+    p.add_argument("--gem5-options", default="",
+                   help="options for the simulator binary itself")
+    p.add_argument("--interval", type=int, default=10000000,
+                   help="instructions per interval (default: 10000000)")
+    p.add_argument("--warmup", type=int, default=1000000,
+                   help="warm-up instructions before each simpoint "
+                   "(default: 1000000)")
+    p.add_argument("--detailed", default="",
+                   help="options of the restored runs, such as the CPU "
+                   "type and the caches")
+    p.add_argument("config", nargs=argparse.REMAINDER,
+                   help="configuration script and the workload options "
+                   "shared by all steps, after --")
+    add_cluster_options(p)
+
+    args = parser.parse_args()
+    if args.command == "cluster":
+        do_cluster(args, os.path.join(args.outdir, "simpoints"),
+                   os.path.join(args.outdir, "weights"))
+    elif args.command == "merge":
+        weights = [ w for _, w in find_checkpoints(args.cptdir) ]
+        if len(weights) != len(args.stats):
+            sys.exit("%d checkpoints but %d stats files" %
+                     (len(weights), len(args.stats)))
+        merge_stats(list(zip(args.stats, weights)), args.output)
+    elif args.command == "run":
+        if args.config and args.config[0] == "--":
+            args.config = args.config[1:]
+        do_run(args)
+    else:
+        parser.print_help()
+
+if __name__ == "__main__":
+    main()